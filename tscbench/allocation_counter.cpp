@@ -0,0 +1,86 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "allocation_counter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::size_t> allocations{0};
+
+void* allocate(std::size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (auto memory = std::malloc(size ? size : 1))
+		return memory;
+
+	throw std::bad_alloc();
+}
+
+void* allocate(std::size_t size, std::align_val_t alignment) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+
+	// aligned_alloc needs the size to be a multiple of the alignment
+	auto align = static_cast<std::size_t>(alignment);
+	auto rounded = (size + align - 1) / align * align;
+	if (auto memory = std::aligned_alloc(align, rounded ? rounded : align))
+		return memory;
+
+	throw std::bad_alloc();
+}
+
+}  // namespace
+
+std::size_t tscc::bench::allocation_count() noexcept {
+	return allocations.load(std::memory_order_relaxed);
+}
+
+// the nothrow forms of new and the sized forms of delete forward to these
+
+void* operator new(std::size_t size) {
+	return allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+	return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	return allocate(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+	return allocate(size, alignment);
+}
+
+void operator delete(void* memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+	std::free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept {
+	std::free(memory);
+}
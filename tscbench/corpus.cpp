@@ -0,0 +1,186 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "corpus.hpp"
+#include <stdexcept>
+
+using namespace tscc::bench;
+
+namespace {
+
+// splitmix64, so the corpora don't depend on how a standard library
+// implements its distributions
+class generator {
+public:
+	explicit generator(std::uint64_t seed) : state_(seed) {}
+
+	std::uint64_t next() noexcept {
+		auto z = (state_ += 0x9e3779b97f4a7c15);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+		return z ^ (z >> 31);
+	}
+
+	// a number in [0, bound)
+	std::size_t below(std::size_t bound) noexcept { return next() % bound; }
+
+	std::string name(std::string_view prefix) {
+		return std::string(prefix) + std::to_string(below(1000));
+	}
+
+private:
+	std::uint64_t state_;
+};
+
+constexpr std::string_view type_names[] = {
+	"string", "number", "boolean", "unknown", "never", "Promise<T>",
+	"Map<K, V>", "Record<string, number>", "readonly string[]", "this",
+};
+
+void imports(std::string& out, generator& gen) {
+	switch (gen.below(4)) {
+		case 0:
+			out += "import { " + gen.name("alpha") + ", " + gen.name("beta") +
+				   " as " + gen.name("gamma") + " } from \"./module" +
+				   std::to_string(gen.below(500)) + "\";\n";
+			break;
+		case 1:
+			out += "import * as " + gen.name("ns") + " from \"package" +
+				   std::to_string(gen.below(50)) + "/sub\";\n";
+			break;
+		case 2:
+			out += "import " + gen.name("def") + " from \"./default" +
+				   std::to_string(gen.below(500)) + "\";\n";
+			break;
+		default:
+			out += "import type { " + gen.name("Shape") + ", " +
+				   gen.name("Props") + " } from \"./types\";\n";
+			break;
+	}
+}
+
+void type_expression(std::string& out, generator& gen, int depth) {
+	if (depth == 0 || gen.below(3) == 0) {
+		if (gen.below(2))
+			out += type_names[gen.below(std::size(type_names))];
+		else
+			out += gen.name("T");
+		return;
+	}
+
+	auto members = 2 + gen.below(4);
+	auto separator = gen.below(2) ? " | " : " & ";
+	out += '(';
+	for (std::size_t i = 0; i < members; ++i) {
+		if (i)
+			out += separator;
+		type_expression(out, gen, depth - 1);
+	}
+	out += ')';
+	if (gen.below(4) == 0)
+		out += "[]";
+}
+
+void types(std::string& out, generator& gen) {
+	out += "type " + gen.name("Alias") + " = ";
+	type_expression(out, gen, 6);
+	out += ";\n";
+}
+
+void template_literals(std::string& out, generator& gen) {
+	out += "let " + gen.name("text") + " = `";
+	auto lines = 20 + gen.below(40);
+	for (std::size_t i = 0; i < lines; ++i) {
+		out += "line " + std::to_string(i) + " of the template with ${" +
+			   gen.name("value") + "} and ${" + gen.name("other") +
+			   " + 1} in it\n";
+	}
+	out += "`;\n";
+}
+
+void jsx(std::string& out, generator& gen) {
+	out += "let " + gen.name("view") + " = <div className=\"" +
+		   gen.name("class") + "\"><span title=\"" + gen.name("title") +
+		   "\">Some text with {" + gen.name("value") +
+		   "} inside</span><br /><" + "Component" +
+		   " prop={" + gen.name("prop") + "}>child</Component></div>;\n";
+}
+
+void comments(std::string& out, generator& gen) {
+	out += "/**\n";
+	auto lines = 10 + gen.below(30);
+	for (std::size_t i = 0; i < lines; ++i) {
+		out += " * Describes " + gen.name("thing") +
+			   " in a fair amount of detail so the comment is long.\n";
+	}
+	out += " * @param " + gen.name("arg") + " the argument\n */\n";
+	out += "// a trailing line comment about " + gen.name("thing") + "\n";
+	out += "type " + gen.name("Documented") + " = string;\n";
+}
+
+struct corpus_kind {
+	std::string_view name;
+	std::string_view file_name;
+	bool parseable;
+	void (*chunk)(std::string&, generator&);
+};
+
+constexpr corpus_kind kinds[] = {
+	{"imports", "imports.ts", true, imports},
+	{"types", "types.ts", true, types},
+	{"template_literals", "template_literals.ts", false, template_literals},
+	{"jsx", "jsx.tsx", false, jsx},
+	{"comments", "comments.ts", true, comments},
+};
+
+}  // namespace
+
+const std::vector<std::string_view>& tscc::bench::corpus_names() {
+	static const std::vector<std::string_view> names = [] {
+		std::vector<std::string_view> result;
+		for (const auto& kind : kinds)
+			result.push_back(kind.name);
+		return result;
+	}();
+
+	return names;
+}
+
+corpus tscc::bench::make_corpus(std::string_view name,
+								std::size_t size,
+								std::uint64_t seed) {
+	for (const auto& kind : kinds) {
+		if (kind.name != name)
+			continue;
+
+		// mix the name in (FNV-1a) so each corpus gets its own sequence
+		std::uint64_t hash = 0xcbf29ce484222325;
+		for (auto ch : name)
+			hash = (hash ^ static_cast<unsigned char>(ch)) * 0x100000001b3;
+		generator gen(seed ^ hash);
+		corpus result{std::string(kind.name), std::string(kind.file_name), {},
+					  kind.parseable};
+		result.text.reserve(size + 4096);
+		while (result.text.size() < size)
+			kind.chunk(result.text, gen);
+
+		return result;
+	}
+
+	throw std::invalid_argument("unknown corpus: " + std::string(name));
+}
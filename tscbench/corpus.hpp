@@ -0,0 +1,57 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tscc::bench {
+
+/**
+ * \brief A synthetic input for the benchmarks
+ */
+struct corpus {
+	std::string name;
+
+	// the file name, which decides the language variant of the source
+	std::string file_name;
+	std::string text;
+
+	// whether the parser supports everything in the text, otherwise only the
+	// lexer is measured
+	bool parseable;
+};
+
+/**
+ * \brief The names of every corpus make_corpus() can generate
+ */
+const std::vector<std::string_view>& corpus_names();
+
+/**
+ * \brief Generate a corpus of about the given size
+ *
+ * The output depends only on the name, size and seed, on every platform and
+ * standard library, so results can be compared across machines and runs.
+ * Throws std::invalid_argument for an unknown name.
+ */
+corpus make_corpus(std::string_view name, std::size_t size, std::uint64_t seed);
+
+}  // namespace tscc::bench
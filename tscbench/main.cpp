@@ -0,0 +1,272 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sys/resource.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <tsclex/lexer.hpp>
+#include <tsclex/source.hpp>
+#include <tscparse/parser.hpp>
+#include <vector>
+#include "allocation_counter.hpp"
+#include "corpus.hpp"
+
+using namespace tscc;
+using namespace tscc::bench;
+
+namespace {
+
+class corpus_source : public lex::source {
+public:
+	explicit corpus_source(std::string name) : name_(std::move(name)) {}
+
+	std::string_view name() const override { return name_; }
+
+private:
+	std::string name_;
+};
+
+struct measurement {
+	double seconds = 0;
+	std::size_t allocations = 0;
+};
+
+struct result {
+	std::string name;
+	std::size_t bytes = 0;
+	std::size_t tokens = 0;
+	std::optional<measurement> lexer;
+	std::optional<measurement> parser;
+	std::string error;
+	long peak_rss_kb = 0;
+};
+
+struct settings {
+	std::size_t size = 4 * 1024 * 1024;
+	std::size_t repetitions = 5;
+	std::uint64_t seed = 1;
+	std::string output;
+	std::vector<std::string> corpora;
+};
+
+long peak_rss_kb() {
+	rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+// run the work the given number of times and keep the fastest run, with the
+// allocations counted on the first
+template <typename Work>
+measurement measure(std::size_t repetitions, Work&& work) {
+	measurement best;
+	for (std::size_t i = 0; i < repetitions; ++i) {
+		auto allocations = allocation_count();
+		auto start = std::chrono::steady_clock::now();
+		work();
+		auto seconds = std::chrono::duration<double>(
+						   std::chrono::steady_clock::now() - start)
+						   .count();
+
+		if (i == 0) {
+			best.allocations = allocation_count() - allocations;
+			best.seconds = seconds;
+		} else {
+			best.seconds = std::min(best.seconds, seconds);
+		}
+	}
+
+	return best;
+}
+
+result run(const corpus& input, const settings& options) {
+	result out{input.name, input.text.size()};
+	auto source = std::make_shared<corpus_source>(input.file_name);
+	std::span<const char> buffer(input.text.data(), input.text.size());
+
+	try {
+		out.lexer = measure(options.repetitions, [&] {
+			lex::lexer lexer(buffer, source);
+			lex::token current;
+			std::size_t tokens = 0;
+			while (lexer.next(current))
+				++tokens;
+			out.tokens = tokens;
+		});
+
+		if (input.parseable) {
+			out.parser = measure(options.repetitions, [&] {
+				lex::lexer lexer(buffer, source);
+				parse::parser parser(lexer);
+				auto root = parser.parse();
+			});
+		}
+	} catch (const std::exception& e) {
+		out.error = e.what();
+	}
+
+	out.peak_rss_kb = peak_rss_kb();
+	return out;
+}
+
+std::string json_string(std::string_view text) {
+	std::string out = "\"";
+	for (auto ch : text) {
+		switch (ch) {
+			case '"':
+				out += "\\\"";
+				break;
+			case '\\':
+				out += "\\\\";
+				break;
+			default:
+				if (static_cast<unsigned char>(ch) < 0x20) {
+					char escaped[8];
+					std::snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+					out += escaped;
+				} else {
+					out += ch;
+				}
+		}
+	}
+
+	return out + '"';
+}
+
+void write_measurement(std::ostream& out,
+					   const measurement& m,
+					   const result& r) {
+	auto per_second = [&m](double count) {
+		return m.seconds > 0 ? count / m.seconds : 0.0;
+	};
+
+	out << "{\"seconds\": " << m.seconds
+		<< ", \"megabytes_per_second\": " << per_second(r.bytes / 1e6)
+		<< ", \"tokens_per_second\": " << per_second(r.tokens)
+		<< ", \"allocations\": " << m.allocations
+		<< ", \"allocations_per_token\": "
+		<< (r.tokens ? static_cast<double>(m.allocations) / r.tokens : 0.0)
+		<< "}";
+}
+
+void write_json(std::ostream& out,
+				const settings& options,
+				const std::vector<result>& results) {
+	out << "{\n  \"size\": " << options.size
+		<< ",\n  \"repetitions\": " << options.repetitions
+		<< ",\n  \"seed\": " << options.seed << ",\n  \"corpora\": [";
+
+	for (std::size_t i = 0; i < results.size(); ++i) {
+		const auto& r = results[i];
+		out << (i ? "," : "") << "\n    {\"name\": " << json_string(r.name)
+			<< ", \"bytes\": " << r.bytes << ", \"tokens\": " << r.tokens;
+
+		out << ", \"lexer\": ";
+		if (r.lexer)
+			write_measurement(out, *r.lexer, r);
+		else
+			out << "null";
+
+		out << ", \"parser\": ";
+		if (r.parser)
+			write_measurement(out, *r.parser, r);
+		else
+			out << "null";
+
+		if (!r.error.empty())
+			out << ", \"error\": " << json_string(r.error);
+
+		out << ", \"peak_rss_kb\": " << r.peak_rss_kb << "}";
+	}
+
+	out << "\n  ],\n  \"peak_rss_kb\": " << peak_rss_kb() << "\n}\n";
+}
+
+void usage(std::ostream& out) {
+	out << "usage: tscc_bench [--size BYTES] [--repetitions N] [--seed N]\n"
+		   "                  [--output FILE] [CORPUS...]\n\ncorpora:";
+	for (auto name : corpus_names())
+		out << ' ' << name;
+	out << '\n';
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+	settings options;
+
+	try {
+		for (int i = 1; i < argc; ++i) {
+			std::string_view arg = argv[i];
+			auto value = [&]() -> std::string {
+				if (i + 1 >= argc)
+					throw std::invalid_argument(std::string(arg) +
+												" needs a value");
+				return argv[++i];
+			};
+
+			if (arg == "--size")
+				options.size = std::stoull(value());
+			else if (arg == "--repetitions")
+				options.repetitions = std::max(1ull, std::stoull(value()));
+			else if (arg == "--seed")
+				options.seed = std::stoull(value());
+			else if (arg == "--output")
+				options.output = value();
+			else if (arg == "--help" || arg == "-h") {
+				usage(std::cout);
+				return 0;
+			} else
+				options.corpora.emplace_back(arg);
+		}
+
+		if (options.corpora.empty()) {
+			for (auto name : corpus_names())
+				options.corpora.emplace_back(name);
+		}
+
+		std::vector<result> results;
+		for (const auto& name : options.corpora) {
+			auto input = make_corpus(name, options.size, options.seed);
+			results.push_back(run(input, options));
+		}
+
+		if (options.output.empty()) {
+			write_json(std::cout, options, results);
+		} else {
+			std::ofstream out(options.output);
+			write_json(out, options, results);
+		}
+	} catch (const std::exception& e) {
+		std::cerr << "tscc_bench: " << e.what() << '\n';
+		usage(std::cerr);
+		return 1;
+	}
+
+	return 0;
+}
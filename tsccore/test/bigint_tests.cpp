@@ -0,0 +1,103 @@
+#include <catch2/catch_test_macros.hpp>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "tsccore/bigint.hpp"
+
+#ifndef __FILE_NAME__
+#  define __FILE_NAME__ __FILE__
+#endif
+
+using tscc::big_int;
+
+TEST_CASE("Big Integers")
+{
+	SECTION("small values are stored inline")
+	{
+		big_int value = 42;
+		CHECK(value.is_inline());
+		CHECK(value.to_int64() == 42);
+		CHECK(big_int{}.is_zero());
+		CHECK(big_int{-7}.is_negative());
+		CHECK(big_int{std::numeric_limits<std::uint64_t>::max()}.is_inline());
+	}
+
+	SECTION("digits are parsed and printed in any base")
+	{
+		auto value = big_int::parse("123456789012345678901234567890");
+		CHECK_FALSE(value.is_inline());
+		CHECK(value.to_string() == "123456789012345678901234567890");
+		CHECK(value.limbs().size() == 2);
+
+		auto hex = big_int::parse("ffffffffffffffffffff", 16);
+		CHECK(hex.to_string(16) == "ffffffffffffffffffff");
+		CHECK(hex.to_string(2) == std::string(80, '1'));
+		CHECK(big_int::parse("777", 8).to_string() == "511");
+		CHECK((-big_int::parse("101", 2)).to_string() == "-5");
+		CHECK(big_int{}.to_string() == "0");
+	}
+
+	SECTION("bad digits are rejected")
+	{
+		CHECK_THROWS_AS(big_int::parse(""), std::invalid_argument);
+		CHECK_THROWS_AS(big_int::parse("12a"), std::invalid_argument);
+		CHECK_THROWS_AS(big_int::parse("2", 2), std::invalid_argument);
+		CHECK_THROWS_AS(big_int::parse("1", 37), std::invalid_argument);
+		CHECK_THROWS_AS(big_int::parse("-1"), std::invalid_argument);
+	}
+
+	SECTION("arithmetic carries across limbs")
+	{
+		big_int max = std::numeric_limits<std::uint64_t>::max();
+		auto sum = max + big_int{1};
+		CHECK(sum.to_string() == "18446744073709551616");
+		CHECK((sum - big_int{1}) == max);
+		CHECK((max * max).to_string() ==
+			  "340282366920938463426481119284349108225");
+		CHECK(big_int::pow(2, 100).to_string() ==
+			  "1267650600228229401496703205376");
+		CHECK((big_int{5} - big_int{8}).to_string() == "-3");
+	}
+
+	SECTION("division truncates towards zero")
+	{
+		CHECK((big_int{-7} / big_int{2}).to_int64() == -3);
+		CHECK((big_int{-7} % big_int{2}).to_int64() == -1);
+		CHECK((big_int{7} % big_int{-2}).to_int64() == 1);
+
+		auto large = big_int::pow(10, 40) + big_int{123};
+		auto divisor = big_int::pow(10, 20);
+		CHECK((large / divisor).to_string() == "100000000000000000000");
+		CHECK((large % divisor).to_string() == "123");
+		CHECK_THROWS_AS(large / big_int{}, std::domain_error);
+	}
+
+	SECTION("bitwise operators act on two's complement")
+	{
+		CHECK((big_int{-1} & big_int{0xff}).to_int64() == 0xff);
+		CHECK((big_int{-16} | big_int{3}).to_int64() == -13);
+		CHECK((big_int{6} ^ big_int{-1}).to_int64() == -7);
+		CHECK((~big_int{5}).to_int64() == -6);
+		CHECK((big_int{1} << 70).to_string() == "1180591620717411303424");
+		CHECK(((big_int{1} << 70) >> 69).to_int64() == 2);
+		CHECK((big_int{-5} >> 1).to_int64() == -3);
+	}
+
+	SECTION("values compare by sign and magnitude")
+	{
+		CHECK(big_int{-3} < big_int{2});
+		CHECK(big_int{-3} < big_int{-2});
+		CHECK(big_int::pow(2, 64) > big_int{1});
+		CHECK(big_int{0} == -big_int{0});
+	}
+
+	SECTION("int64 conversion checks the range")
+	{
+		big_int min = std::numeric_limits<std::int64_t>::min();
+		CHECK(min.to_int64() == std::numeric_limits<std::int64_t>::min());
+		CHECK_FALSE((min - big_int{1}).to_int64().has_value());
+		CHECK_FALSE(
+			big_int{std::numeric_limits<std::uint64_t>::max()}.to_int64());
+		CHECK(big_int::pow(2, 80).to_long_double() == 0x1p80L);
+	}
+}
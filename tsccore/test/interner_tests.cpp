@@ -0,0 +1,95 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+#include "tsccore/interner.hpp"
+
+#ifndef __FILE_NAME__
+#  define __FILE_NAME__ __FILE__
+#endif
+
+TEST_CASE("String Interning")
+{
+	tscc::interner table;
+
+	SECTION("equal strings get the same atom")
+	{
+		auto first = table.intern(std::string_view{"Promise"});
+		auto second = table.intern(std::string{"Promise"});
+		CHECK(first == second);
+		CHECK(table.size() == 1);
+		CHECK(table.view(first) == "Promise");
+	}
+
+	SECTION("different strings get different atoms")
+	{
+		auto react = table.intern(std::string_view{"React"});
+		auto component = table.intern(std::string_view{"Component"});
+		CHECK(react != component);
+		CHECK(table.view(react) == "React");
+		CHECK(table.view(component) == "Component");
+	}
+
+	SECTION("the empty string is the default atom")
+	{
+		CHECK(table.intern(std::string_view{}) == tscc::atom{});
+		CHECK(table.view(tscc::atom{}).empty());
+		CHECK(table.size() == 0);
+	}
+
+	SECTION("UTF-32 text is stored as UTF-8")
+	{
+		auto wide = table.intern(std::u32string_view{U"café汉"});
+		CHECK(wide == table.intern(std::string_view{"café汉"}));
+		CHECK(table.view(wide) == "café汉");
+	}
+
+	SECTION("find doesn't add strings")
+	{
+		CHECK_FALSE(table.find("missing").has_value());
+		CHECK(table.size() == 0);
+
+		auto added = table.intern(std::string_view{"present"});
+		CHECK(table.find("present") == added);
+	}
+
+	SECTION("views stay valid as the table grows")
+	{
+		auto first = table.intern(std::string_view{"first"});
+		auto view = table.view(first);
+
+		std::string large(100000, 'x');
+		auto big = table.intern(std::string_view{large});
+		for (int i = 0; i < 20000; ++i)
+			table.intern(std::string_view{"name" + std::to_string(i)});
+
+		CHECK(view.data() == table.view(first).data());
+		CHECK(table.view(big) == large);
+		CHECK(table.size() == 20002);
+	}
+
+	SECTION("threads agree on atoms")
+	{
+		constexpr int thread_count = 4;
+		constexpr int names = 2000;
+
+		std::vector<std::vector<tscc::atom>> results(thread_count);
+		std::vector<std::thread> threads;
+		for (int t = 0; t < thread_count; ++t) {
+			threads.emplace_back([&table, &results, t] {
+				for (int i = 0; i < names; ++i) {
+					results[t].push_back(table.intern(
+						std::string_view{"shared" + std::to_string(i)}));
+				}
+			});
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+
+		CHECK(table.size() == names);
+		for (int t = 1; t < thread_count; ++t)
+			CHECK(results[t] == results[0]);
+		CHECK(table.view(results[0][42]) == "shared42");
+	}
+}
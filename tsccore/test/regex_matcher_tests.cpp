@@ -0,0 +1,325 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include "../tsccore/regex/backtracking_hazards.hpp"
+#include "../tsccore/regex/literals.hpp"
+#include "../tsccore/regex/matcher.hpp"
+#include "../tsccore/regex/scan_regex.hpp"
+
+using namespace tsccore::regex;
+
+namespace {
+
+std::optional<std::u32string> captured(const std::optional<match_result>& match,
+									   std::u32string_view input,
+									   std::size_t number) {
+	if (!match || !match->groups[number])
+		return std::nullopt;
+
+	auto [begin, end] = *match->groups[number];
+	return std::u32string(input.substr(begin, end - begin));
+}
+
+}  // namespace
+
+TEST_CASE("Regular Expression Matching", "[regex]") {
+	SECTION("Literals and alternation") {
+		auto regex = matcher::compile(U"cat|dog");
+		CHECK(regex.test(U"hotdog"));
+		CHECK_FALSE(regex.test(U"cow"));
+
+		auto match = regex.exec(U"a dog and a cat");
+		REQUIRE(match);
+		CHECK(match->position() == 2);
+		CHECK(match->end() == 5);
+	}
+
+	SECTION("Earlier alternatives win over longer ones") {
+		std::u32string input = U"abc";
+		auto match = matcher::compile(U"(a|ab)(c|bcd)?").exec(input);
+		CHECK(captured(match, input, 0) == U"a");
+		CHECK(captured(match, input, 1) == U"a");
+		CHECK_FALSE(captured(match, input, 2));
+	}
+
+	SECTION("Greedy and lazy quantifiers") {
+		std::u32string input = U"<a><b>";
+		CHECK(captured(matcher::compile(U"<.*>").exec(input), input, 0) ==
+			  U"<a><b>");
+		CHECK(captured(matcher::compile(U"<.*?>").exec(input), input, 0) ==
+			  U"<a>");
+		CHECK(captured(matcher::compile(U"a{2,3}").exec(U"aaaa"), U"aaaa", 0) ==
+			  U"aaa");
+		CHECK(captured(matcher::compile(U"a{2,3}?").exec(U"aaaa"), U"aaaa", 0) ==
+			  U"aa");
+		CHECK_FALSE(matcher::compile(U"^a{2,}$").test(U"a"));
+		CHECK(matcher::compile(U"^a{2,}$").test(U"aaaaa"));
+	}
+
+	SECTION("Captures start over with each repetition") {
+		std::u32string input = U"ab";
+		auto match = matcher::compile(U"(?:(a)|b)+").exec(input);
+		CHECK(captured(match, input, 0) == U"ab");
+		CHECK_FALSE(captured(match, input, 1));
+	}
+
+	SECTION("Empty iterations end a loop") {
+		CHECK(matcher::compile(U"(a*)*b").test(U"aab"));
+		CHECK(matcher::compile(U"(a*)+$").exec(U"aaa"));
+		CHECK(matcher::compile(U"(?:)*x").test(U"x"));
+	}
+
+	SECTION("Classes") {
+		auto hex = matcher::compile(U"^[0-9a-fA-F_]+$");
+		CHECK(hex.test(U"dead_BEEF"));
+		CHECK_FALSE(hex.test(U"xyz"));
+
+		CHECK(matcher::compile(U"[^abc]").test(U"abcd"));
+		CHECK_FALSE(matcher::compile(U"[^abc]").test(U"cab"));
+		CHECK(matcher::compile(U"^\\d+\\s\\w+$").test(U"42 items"));
+		CHECK_FALSE(matcher::compile(U"\\S").test(U" \t 　"));
+		CHECK_FALSE(matcher::compile(U"a.c").test(U"a\nc"));
+		CHECK(matcher::compile(U"a.c", match_flags::dot_all).test(U"a\nc"));
+	}
+
+	SECTION("Ignoring case") {
+		auto regex = matcher::compile(U"^straße [a-z]+$", match_flags::ignore_case);
+		CHECK(regex.test(U"STRAßE Name"));
+		CHECK(matcher::compile(U"привет", match_flags::ignore_case)
+				  .test(U"ПРИВЕТ"));
+		CHECK_FALSE(matcher::compile(U"[^a]", match_flags::ignore_case)
+						.test(U"A"));
+	}
+
+	SECTION("Anchors and boundaries") {
+		CHECK_FALSE(matcher::compile(U"^b").test(U"a\nb"));
+		CHECK(matcher::compile(U"^b$", match_flags::multiline).test(U"a\nb\nc"));
+
+		std::u32string input = U"cat concat cats";
+		auto match = matcher::compile(U"\\bcat\\b").exec(input, 1);
+		CHECK_FALSE(match);
+		CHECK(matcher::compile(U"\\Bcat").exec(input)->position() == 7);
+	}
+
+	SECTION("Sticky patterns only match where they start") {
+		auto regex = matcher::compile(U"b", match_flags::sticky);
+		CHECK_FALSE(regex.test(U"ab"));
+		CHECK(regex.test(U"ab", 1));
+		CHECK_FALSE(regex.exec(U"ab"));
+		CHECK(regex.exec(U"ab", 1)->position() == 1);
+	}
+
+	SECTION("Named groups") {
+		std::u32string input = U"2024-05";
+		auto regex = matcher::compile(U"(?<year>\\d{4})-(?<month>\\d\\d)");
+		auto match = regex.exec(input);
+		REQUIRE(regex.group_number(U"month") == 2);
+		CHECK(captured(match, input, 1) == U"2024");
+		CHECK(captured(match, input, 2) == U"05");
+		CHECK_FALSE(regex.group_number(U"day"));
+	}
+
+	SECTION("Lookahead") {
+		std::u32string input = U"price: 100 dollars";
+		auto match = matcher::compile(U"\\d+(?= dollars)").exec(input);
+		CHECK(captured(match, input, 0) == U"100");
+		CHECK_FALSE(matcher::compile(U"^(?!abc)").test(U"abcd"));
+
+		input = U"abc";
+		match = matcher::compile(U"(?=(ab))a").exec(input);
+		CHECK(captured(match, input, 1) == U"ab");
+		CHECK_FALSE(matcher::compile(U"a").get_program().needs_backtracking());
+	}
+
+	SECTION("Backreferences and lookbehind backtrack") {
+		std::u32string input = U"say 'hi' or \"bye\"";
+		auto quoted = matcher::compile(U"(['\"])([a-z]+)\\1");
+		CHECK(quoted.get_program().needs_backtracking());
+		auto match = quoted.exec(input);
+		CHECK(captured(match, input, 2) == U"hi");
+		match = quoted.exec(input, 5);
+		CHECK(captured(match, input, 2) == U"bye");
+
+		CHECK(matcher::compile(U"(a)\\1", match_flags::ignore_case)
+				  .test(U"aA"));
+
+		input = U"USD100 EUR200";
+		match = matcher::compile(U"(?<=EUR)\\d+").exec(input);
+		CHECK(captured(match, input, 0) == U"200");
+		CHECK(matcher::compile(U"(?<!EUR)\\b\\d+").exec(U"EUR1 2")->position() ==
+			  5);
+	}
+
+	SECTION("Linear time on patterns that trip up backtracking") {
+		std::u32string input(5000, U'a');
+		auto nested = matcher::compile(U"(a|aa)*b");
+		CHECK(nested.get_program().is_dfa_compatible());
+		CHECK_FALSE(nested.test(input));
+		CHECK_FALSE(nested.exec(input));
+
+		input += U'b';
+		CHECK(nested.test(input));
+		CHECK(nested.exec(input)->end() == input.size());
+
+		// the b is there for the prefilter to find, so the engine rules it out
+		auto anchored = matcher::compile(U"^(a|aa)*b$");
+		CHECK_FALSE(anchored.test(input + U"a"));
+		CHECK_FALSE(anchored.exec(input + U"a"));
+	}
+
+	SECTION("Searches can start past the beginning") {
+		auto regex = matcher::compile(U"^a|b");
+		CHECK_FALSE(regex.test(U"aa", 1));
+		CHECK(regex.test(U"ab", 1));
+		CHECK_FALSE(regex.test(U"ab", 3));
+		CHECK(regex.test(U"", 0) == false);
+		CHECK(matcher::compile(U"^$").test(U""));
+	}
+
+	SECTION("Required literals skip ahead") {
+		std::u32string input = U"GET /index.html then /api/v2/users";
+		auto route = matcher::compile(U"^\\/api\\/v\\d+\\/",
+									  match_flags::multiline);
+		CHECK_FALSE(route.test(input));
+		CHECK(route.test(U"x\n/api/v10/"));
+
+		auto api = matcher::compile(U"\\/api\\/v(\\d+)");
+		auto match = api.exec(input);
+		REQUIRE(match);
+		CHECK(match->position() == 21);
+		CHECK(captured(match, input, 1) == U"2");
+
+		auto sticky = matcher::compile(U"foo", match_flags::sticky);
+		CHECK_FALSE(sticky.test(U"xfoo"));
+		CHECK(sticky.test(U"xfoo", 1));
+
+		CHECK(matcher::compile(U"(?<=a)bc").exec(U"bc abc")->position() == 4);
+		CHECK_FALSE(matcher::compile(U"\\d+ms").test(U"took 15 s"));
+		CHECK(matcher::compile(U"\\d+ms").exec(U"took 15ms")->position() == 5);
+	}
+}
+
+TEST_CASE("Required Literals", "[regex]") {
+	auto literals = [](std::u32string_view pattern,
+					   match_flags flags = match_flags::none) {
+		regular_expression expression;
+		scan(pattern, expression);
+		return find_required_literals(expression, flags);
+	};
+
+	SECTION("Anchored literals become the prefix") {
+		auto found = literals(U"^\\/api\\/v\\d+\\/");
+		CHECK(found.prefix == U"/api/v");
+		CHECK(found.suffix == U"/");
+		CHECK(found.factors == std::vector<std::u32string>{U"/api/v"});
+
+		CHECK(literals(U"ERROR: .*").prefix == U"ERROR: ");
+		CHECK(literals(U"x{3}y?").prefix == U"xxx");
+	}
+
+	SECTION("Short alternations are listed in full") {
+		auto found = literals(U"(?:abc|abd)x");
+		CHECK(found.prefix == U"ab");
+		CHECK(found.suffix == U"x");
+		CHECK(found.factors == std::vector<std::u32string>{U"abcx", U"abdx"});
+
+		CHECK(literals(U"[ab]c").factors ==
+			  std::vector<std::u32string>{U"ac", U"bc"});
+	}
+
+	SECTION("Alternatives contribute a factor each") {
+		auto found = literals(U"\\d+(?:error|warning)\\d");
+		CHECK(found.prefix.empty());
+		CHECK(found.factors ==
+			  std::vector<std::u32string>{U"error", U"warning"});
+
+		CHECK(literals(U"\\w+foo\\d*|bar").factors ==
+			  std::vector<std::u32string>{U"bar", U"foo"});
+		CHECK(literals(U"a\\d+bcd").factors ==
+			  std::vector<std::u32string>{U"bcd"});
+	}
+
+	SECTION("Patterns without literals have none") {
+		CHECK(literals(U"a*").empty());
+		CHECK(literals(U"\\w+|x").empty());
+		CHECK(literals(U"[^a]b?").empty());
+	}
+
+	SECTION("Cased letters aren't literal with the i flag") {
+		auto found = literals(U"ab12", match_flags::ignore_case);
+		CHECK(found.prefix.empty());
+		CHECK(found.suffix == U"12");
+	}
+}
+
+TEST_CASE("Backtracking Hazards", "[regex]") {
+	auto hazards = [](std::u32string_view pattern,
+					  match_flags flags = match_flags::none) {
+		regular_expression expression;
+		scan(pattern, expression);
+		return find_backtracking_hazards(expression, flags);
+	};
+
+	using type = backtracking_hazard::type;
+
+	SECTION("Nested repetitions are exponential") {
+		auto found = hazards(U"^(a+)+$");
+		REQUIRE(found.size() == 1);
+		CHECK(found[0].hazard_type == type::nested_quantifier);
+		CHECK(found[0].exponential);
+		CHECK(found[0].source == U"(a+)+");
+
+		CHECK(hazards(U"(?:a*b?)*c").size() == 1);
+		CHECK(hazards(U"((a+)+)+x").size() == 1);
+	}
+
+	SECTION("Overlapping alternatives in a loop are exponential") {
+		auto found = hazards(U"(\\w|\\d)*x");
+		REQUIRE(found.size() == 1);
+		CHECK(found[0].hazard_type == type::overlapping_alternatives);
+		CHECK(found[0].source == U"(\\w|\\d)*");
+
+		CHECK(hazards(U"(?:A|a)+!", match_flags::ignore_case).size() == 1);
+		CHECK(hazards(U"(?:A|a)+!").empty());
+	}
+
+	SECTION("Adjacent repetitions are polynomial") {
+		auto found = hazards(U".*.*=.*");
+		REQUIRE(found.size() == 1);
+		CHECK(found[0].hazard_type == type::adjacent_quantifiers);
+		CHECK_FALSE(found[0].exponential);
+		CHECK(found[0].degree == 2);
+		CHECK(found[0].source == U".*.*");
+
+		CHECK(hazards(U"\\d+-?\\d*\\d+$")[0].degree == 3);
+
+		// nothing after them can fail
+		CHECK(hazards(U"\\d+\\d+").empty());
+	}
+
+	SECTION("Patterns that can only match one way are left alone") {
+		CHECK(hazards(U"(ab+)+").empty());
+		CHECK(hazards(U"(a+b)+c").empty());
+		CHECK(hazards(U"(a|ab)*c").empty());
+		CHECK(hazards(U"^\\/api\\/v\\d+\\/").empty());
+		CHECK(hazards(U"^[a-z]+@[a-z]+\\.com$").empty());
+		CHECK(hazards(U"\\d+\\.\\d+x").empty());
+	}
+}
@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+#include "tsccore/spsc_ring.hpp"
+
+TEST_CASE("Single Producer Ring")
+{
+	SECTION("capacity is rounded up to a power of two")
+	{
+		CHECK(tscc::spsc_ring<int>(5).capacity() == 8);
+		CHECK(tscc::spsc_ring<int>(0).capacity() == 2);
+	}
+
+	SECTION("slots come out in the order they went in")
+	{
+		tscc::spsc_ring<int> ring(4);
+		for (int i = 0; i < 4; ++i) {
+			*ring.acquire() = i;
+			ring.publish();
+		}
+
+		for (int i = 0; i < 4; ++i) {
+			CHECK(ring.front() == i);
+			ring.release();
+		}
+	}
+
+	SECTION("a closed ring hands out no more slots")
+	{
+		tscc::spsc_ring<int> ring(2);
+		ring.close();
+		CHECK(ring.acquire() == nullptr);
+	}
+
+	SECTION("a producer waiting on a full ring stops when it's closed")
+	{
+		tscc::spsc_ring<int> ring(2);
+		std::thread producer([&ring] {
+			while (auto slot = ring.acquire()) {
+				*slot = 1;
+				ring.publish();
+			}
+		});
+
+		CHECK(ring.front() == 1);
+		ring.close();
+		producer.join();
+	}
+
+	SECTION("slots are passed between threads and reused")
+	{
+		constexpr int count = 100000;
+		tscc::spsc_ring<std::string> ring(16);
+
+		std::thread producer([&ring] {
+			for (int i = 0; i < count; ++i) {
+				auto slot = ring.acquire();
+				slot->assign(std::to_string(i));
+				ring.publish();
+			}
+		});
+
+		std::vector<int> seen;
+		std::string value;
+		for (int i = 0; i < count; ++i) {
+			// swap so the consumer's old string goes back to the producer
+			std::swap(value, ring.front());
+			ring.release();
+			if (value != std::to_string(i))
+				seen.push_back(i);
+		}
+		producer.join();
+
+		CHECK(seen.empty());
+	}
+}
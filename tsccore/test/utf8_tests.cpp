@@ -91,3 +91,84 @@ TEST_CASE("UTF-8 Size Requirements", "encoding sizes")
 		REQUIRE(size == (2 + 3 + 4));
 	}
 }
+
+TEST_CASE("UTF-8 Validation", "validation")
+{
+	SECTION("ASCII prefix stops at the first high byte")
+	{
+		REQUIRE(tscc::ascii_prefix_length("") == 0);
+		REQUIRE(tscc::ascii_prefix_length("plain ascii") == 11);
+		REQUIRE(tscc::ascii_prefix_length("ab¢cd") == 2);
+	}
+
+	SECTION("ASCII prefix is exact across vector block boundaries")
+	{
+		for (std::size_t length = 0; length < 100; ++length) {
+			std::string s(length, 'x');
+			s += "汉";
+			s += std::string(40, 'y');
+			REQUIRE(tscc::ascii_prefix_length(s) == length);
+		}
+	}
+
+	SECTION("well formed input is accepted in full")
+	{
+		std::string s;
+		for (int i = 0; i < 50; ++i)
+			s += "const ¢ = '汉\xf0\x9f\x98\x80';\n";
+
+		REQUIRE(tscc::utf8_valid_prefix_length(s) == s.size());
+	}
+
+	SECTION("truncated sequence at the end is excluded")
+	{
+		REQUIRE(tscc::utf8_valid_prefix_length("abc\xe6\xb1") == 3);
+		REQUIRE(tscc::utf8_valid_prefix_length("abc\xf0\x9f\x98") == 3);
+	}
+
+	SECTION("malformed sequences stop validation")
+	{
+		// stray continuation byte
+		REQUIRE(tscc::utf8_valid_prefix_length("ab\x80z") == 2);
+		// overlong forms
+		REQUIRE(tscc::utf8_valid_prefix_length("ab\xc0\xafz") == 2);
+		REQUIRE(tscc::utf8_valid_prefix_length("ab\xe0\x80\xafz") == 2);
+		REQUIRE(tscc::utf8_valid_prefix_length("ab\xf0\x80\x80\xafz") == 2);
+		// encoded surrogate
+		REQUIRE(tscc::utf8_valid_prefix_length("ab\xed\xa0\x80z") == 2);
+		// beyond U+10FFFF
+		REQUIRE(tscc::utf8_valid_prefix_length("ab\xf4\x90\x80\x80z") == 2);
+		// legacy 5 and 6 byte sequences
+		REQUIRE(tscc::utf8_valid_prefix_length("ab\xf8\x88\x80\x80\x80z") == 2);
+		REQUIRE(tscc::utf8_valid_prefix_length(
+					"ab\xfc\x84\x80\x80\x80\x80z") == 2);
+	}
+
+	SECTION("ASCII run stops at either stop byte") {
+		REQUIRE(tscc::ascii_run_length("abc*/def\n", '\n', '*') == 3);
+		REQUIRE(tscc::ascii_run_length("abc\ndef*", '\n', '*') == 3);
+		REQUIRE(tscc::ascii_run_length("ab¢*\n", '\n', '*') == 2);
+
+		std::string long_line(100, 'x');
+		REQUIRE(tscc::ascii_run_length(long_line + "*" + long_line, '\n',
+									   '*') == 100);
+		REQUIRE(tscc::ascii_run_length(long_line, '\n', '*') == 100);
+	}
+
+	SECTION("errors are found past the first vector blocks") {
+		std::string s;
+		for (int i = 0; i < 20; ++i)
+			s += "ab汉cd¢ef\xf0\x9f\x98\x80gh";
+
+		REQUIRE(tscc::utf8_valid_prefix_length(s) == s.size());
+		for (std::size_t at : {31ul, 32ul, 33ul, 64ul, 100ul, s.size() - 1}) {
+			auto broken = s;
+			broken.insert(at, "\xed\xa0\x80");
+			auto valid = tscc::utf8_valid_prefix_length(broken);
+			REQUIRE(valid <= at);
+			REQUIRE(tscc::utf8_valid_prefix_length(broken.substr(0, valid)) ==
+					valid);
+		}
+	}
+}
+
@@ -0,0 +1,774 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bigint.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace tscc;
+
+namespace {
+
+using limb = big_int::limb;
+using wide_limb = unsigned __int128;
+
+constexpr unsigned limb_bits = 64;
+
+int compare_magnitude(std::span<const limb> left,
+					  std::span<const limb> right) noexcept {
+	if (left.size() != right.size())
+		return left.size() < right.size() ? -1 : 1;
+
+	for (auto i = left.size(); i-- > 0;) {
+		if (left[i] != right[i])
+			return left[i] < right[i] ? -1 : 1;
+	}
+
+	return 0;
+}
+
+unsigned digit_value(char ch) noexcept {
+	if (ch >= '0' && ch <= '9')
+		return ch - '0';
+	if (ch >= 'a' && ch <= 'z')
+		return ch - 'a' + 10;
+	if (ch >= 'A' && ch <= 'Z')
+		return ch - 'A' + 10;
+	return 36;
+}
+
+void check_base(unsigned base) {
+	if (base < 2 || base > 36)
+		throw std::invalid_argument("the base must be from 2 to 36");
+}
+
+// the largest power of the base that fits in a limb, and how many digits
+// it has
+std::pair<limb, unsigned> limb_power(unsigned base) noexcept {
+	limb power = base;
+	unsigned digits = 1;
+	while (power <= std::numeric_limits<limb>::max() / base) {
+		power *= base;
+		++digits;
+	}
+
+	return {power, digits};
+}
+
+// Knuth's algorithm D, for divisors of at least two limbs that are no larger
+// than the dividend
+void divide_long(std::span<const limb> dividend,
+				 std::span<const limb> divisor,
+				 std::vector<limb>& quotient,
+				 std::vector<limb>& remainder) {
+	auto n = divisor.size();
+	auto m = dividend.size() - n;
+
+	// shift both so the top bit of the divisor is set, which keeps the
+	// estimate of each quotient limb within two of the real one
+	auto shift = static_cast<unsigned>(std::countl_zero(divisor[n - 1]));
+	auto carry_in = [shift](limb high, limb low) {
+		return shift ? (high << shift) | (low >> (limb_bits - shift))
+					 : high;
+	};
+
+	std::vector<limb> v(n);
+	for (auto i = n - 1; i > 0; --i)
+		v[i] = carry_in(divisor[i], divisor[i - 1]);
+	v[0] = divisor[0] << shift;
+
+	std::vector<limb> u(m + n + 1);
+	u[m + n] = shift ? dividend[m + n - 1] >> (limb_bits - shift) : 0;
+	for (auto i = m + n - 1; i > 0; --i)
+		u[i] = carry_in(dividend[i], dividend[i - 1]);
+	u[0] = dividend[0] << shift;
+
+	quotient.assign(m + 1, 0);
+	for (auto j = m + 1; j-- > 0;) {
+		auto top = (wide_limb{u[j + n]} << limb_bits) | u[j + n - 1];
+		auto estimate = top / v[n - 1];
+		auto rest = top % v[n - 1];
+		while (estimate >> limb_bits ||
+			   estimate * v[n - 2] > ((rest << limb_bits) | u[j + n - 2])) {
+			--estimate;
+			rest += v[n - 1];
+			if (rest >> limb_bits)
+				break;
+		}
+
+		// subtract estimate * v from the current window of u
+		limb carry = 0;
+		limb borrow = 0;
+		for (std::size_t i = 0; i < n; ++i) {
+			auto product = estimate * v[i] + carry;
+			carry = static_cast<limb>(product >> limb_bits);
+			auto difference =
+				wide_limb{u[i + j]} - static_cast<limb>(product) - borrow;
+			u[i + j] = static_cast<limb>(difference);
+			borrow = (difference >> limb_bits) != 0;
+		}
+		auto difference = wide_limb{u[j + n]} - carry - borrow;
+		u[j + n] = static_cast<limb>(difference);
+
+		// the estimate was one too large, so add v back
+		if (difference >> limb_bits) {
+			--estimate;
+			limb add_carry = 0;
+			for (std::size_t i = 0; i < n; ++i) {
+				auto sum = wide_limb{u[i + j]} + v[i] + add_carry;
+				u[i + j] = static_cast<limb>(sum);
+				add_carry = static_cast<limb>(sum >> limb_bits);
+			}
+			u[j + n] += add_carry;
+		}
+
+		quotient[j] = static_cast<limb>(estimate);
+	}
+
+	remainder.resize(n);
+	for (std::size_t i = 0; i < n; ++i) {
+		remainder[i] = shift ? (u[i] >> shift) |
+								   (u[i + 1] << (limb_bits - shift))
+							 : u[i];
+	}
+}
+
+// the limbs of the value in two's complement, sign extended to the size
+std::vector<limb> twos_complement(const big_int& value, std::size_t size) {
+	auto limbs = value.limbs();
+	std::vector<limb> result(size, 0);
+	std::copy(limbs.begin(), limbs.end(), result.begin());
+
+	// -m is ~(m - 1)
+	if (value.is_negative()) {
+		for (auto& word : result) {
+			if (word-- != 0)
+				break;
+		}
+		for (auto& word : result)
+			word = ~word;
+	}
+
+	return result;
+}
+
+big_int from_twos_complement(std::vector<limb> limbs) {
+	auto negative = !limbs.empty() && (limbs.back() >> (limb_bits - 1));
+	if (negative) {
+		for (auto& word : limbs)
+			word = ~word;
+		for (auto& word : limbs) {
+			if (++word != 0)
+				break;
+		}
+	}
+
+	return big_int::from_limbs(limbs, negative);
+}
+
+template <typename Operation>
+void bitwise(big_int& left, const big_int& right, Operation operation) {
+	auto size = std::max(left.limbs().size(), right.limbs().size()) + 1;
+	auto result = twos_complement(left, size);
+	auto other = twos_complement(right, size);
+	for (std::size_t i = 0; i < size; ++i)
+		result[i] = operation(result[i], other[i]);
+
+	left = from_twos_complement(std::move(result));
+}
+
+}  // namespace
+
+big_int::big_int(const big_int& other) : small_(0) {
+	grow(other.size_);
+	std::copy_n(other.data(), other.size_, data());
+	negative_ = other.negative_;
+}
+
+big_int::big_int(big_int&& other) noexcept
+	: small_(0),
+	  size_(other.size_),
+	  capacity_(other.capacity_),
+	  negative_(other.negative_) {
+	if (capacity_)
+		heap_ = other.heap_;
+	else
+		small_ = other.small_;
+
+	other.small_ = 0;
+	other.size_ = 0;
+	other.capacity_ = 0;
+	other.negative_ = false;
+}
+
+big_int::~big_int() {
+	if (capacity_)
+		delete[] heap_;
+}
+
+big_int& big_int::operator=(const big_int& other) {
+	if (this == &other)
+		return *this;
+
+	// the limbs already allocated are reused when they're large enough
+	size_ = 0;
+	grow(other.size_);
+	std::copy_n(other.data(), other.size_, data());
+	negative_ = other.negative_;
+	return *this;
+}
+
+big_int& big_int::operator=(big_int&& other) noexcept {
+	if (this == &other)
+		return *this;
+
+	if (capacity_)
+		delete[] heap_;
+
+	size_ = other.size_;
+	capacity_ = other.capacity_;
+	negative_ = other.negative_;
+	if (capacity_)
+		heap_ = other.heap_;
+	else
+		small_ = other.small_;
+
+	other.small_ = 0;
+	other.size_ = 0;
+	other.capacity_ = 0;
+	other.negative_ = false;
+	return *this;
+}
+
+big_int big_int::parse(std::string_view digits, unsigned base) {
+	check_base(base);
+	if (digits.empty())
+		throw std::invalid_argument("a number needs at least one digit");
+
+	auto digit = [base](char ch) -> limb {
+		auto value = digit_value(ch);
+		if (value >= base)
+			throw std::invalid_argument("not a digit of the base");
+		return value;
+	};
+
+	// leading zeros would only make room for limbs that are trimmed again
+	auto nonzero = digits.find_first_not_of('0');
+	if (nonzero == std::string_view::npos)
+		return {};
+	digits.remove_prefix(nonzero);
+
+	big_int result;
+
+	// digits of a power of two base are copied straight into the limbs
+	if (std::has_single_bit(base)) {
+		auto bits = static_cast<unsigned>(std::countr_zero(base));
+		result.grow((digits.size() * bits + limb_bits - 1) / limb_bits);
+
+		auto limbs = result.data();
+		std::size_t at = 0;
+		for (auto ch = digits.rbegin(); ch != digits.rend(); ++ch, at += bits) {
+			auto value = digit(*ch);
+			auto offset = at % limb_bits;
+			limbs[at / limb_bits] |= value << offset;
+			if (offset + bits > limb_bits)
+				limbs[at / limb_bits + 1] |= value >> (limb_bits - offset);
+		}
+
+		result.trim();
+		return result;
+	}
+
+	// otherwise as many digits as fit in a limb are read at a time, with a
+	// shorter chunk first so the rest are all full
+	auto [power, count] = limb_power(base);
+	auto chunk = digits.size() % count;
+	if (!chunk)
+		chunk = count;
+
+	while (!digits.empty()) {
+		limb value = 0;
+		limb scale = 1;
+		for (auto ch : digits.substr(0, chunk)) {
+			value = value * base + digit(ch);
+			scale *= base;
+		}
+
+		result.multiply_add(chunk == count ? power : scale, value);
+		digits.remove_prefix(chunk);
+		chunk = count;
+	}
+
+	return result;
+}
+
+big_int big_int::from_limbs(std::span<const limb> limbs, bool negative) {
+	big_int result;
+	result.grow(limbs.size());
+	std::copy(limbs.begin(), limbs.end(), result.data());
+	result.negative_ = negative;
+	result.trim();
+	return result;
+}
+
+std::string big_int::to_string(unsigned base) const {
+	check_base(base);
+	if (is_zero())
+		return "0";
+
+	std::string result;
+	auto limbs = data();
+
+	if (std::has_single_bit(base)) {
+		auto bits = static_cast<unsigned>(std::countr_zero(base));
+		auto total = (size_ - 1) * std::size_t{limb_bits} +
+					 std::bit_width(limbs[size_ - 1]);
+		auto count = (total + bits - 1) / bits;
+		result.reserve(count + 1);
+		if (negative_)
+			result.push_back('-');
+
+		for (auto digit = count; digit-- > 0;) {
+			auto at = digit * bits;
+			auto offset = at % limb_bits;
+			auto value = limbs[at / limb_bits] >> offset;
+			if (offset + bits > limb_bits && at / limb_bits + 1 < size_)
+				value |= limbs[at / limb_bits + 1] << (limb_bits - offset);
+			result.push_back("0123456789abcdefghijklmnopqrstuvwxyz"
+							 [value & (base - 1)]);
+		}
+
+		return result;
+	}
+
+	// peel off as many digits as fit in a limb at a time, least significant
+	// first
+	auto [power, count] = limb_power(base);
+	auto rest = *this;
+	rest.negative_ = false;
+	while (!rest.is_zero()) {
+		auto chunk = rest.divide_magnitude(power);
+		for (unsigned i = 0; i < count && (chunk || !rest.is_zero()); ++i) {
+			result.push_back("0123456789abcdefghijklmnopqrstuvwxyz"
+							 [chunk % base]);
+			chunk /= base;
+		}
+	}
+
+	if (negative_)
+		result.push_back('-');
+	std::reverse(result.begin(), result.end());
+	return result;
+}
+
+std::optional<std::int64_t> big_int::to_int64() const noexcept {
+	if (size_ == 0)
+		return 0;
+	if (size_ > 1)
+		return std::nullopt;
+
+	auto magnitude = data()[0];
+	constexpr auto max =
+		static_cast<limb>(std::numeric_limits<std::int64_t>::max());
+	if (magnitude > max + negative_)
+		return std::nullopt;
+
+	return static_cast<std::int64_t>(negative_ ? limb{0} - magnitude
+											   : magnitude);
+}
+
+long double big_int::to_long_double() const noexcept {
+	long double result = 0;
+	for (auto i = size_; i-- > 0;)
+		result = std::ldexp(result, limb_bits) +
+				 static_cast<long double>(data()[i]);
+
+	return negative_ ? -result : result;
+}
+
+big_int big_int::pow(const big_int& base, std::uint64_t exponent) {
+	big_int result = 1;
+	big_int square = base;
+	while (exponent) {
+		if (exponent & 1)
+			result *= square;
+		exponent >>= 1;
+		if (exponent)
+			square *= square;
+	}
+
+	return result;
+}
+
+big_int big_int::operator-() const& {
+	return -big_int(*this);
+}
+
+big_int big_int::operator-() && {
+	if (size_)
+		negative_ = !negative_;
+	return std::move(*this);
+}
+
+big_int big_int::operator~() const {
+	// ~x is -x - 1 in two's complement
+	auto result = -*this;
+	result -= 1;
+	return result;
+}
+
+big_int& big_int::operator+=(const big_int& other) {
+	if (this == &other)
+		return *this <<= 1;
+
+	if (negative_ == other.negative_) {
+		add_magnitude(other.limbs());
+	} else if (compare_magnitude(limbs(), other.limbs()) >= 0) {
+		subtract_magnitude(other.limbs());
+	} else {
+		big_int result = other;
+		result.subtract_magnitude(limbs());
+		*this = std::move(result);
+	}
+
+	return *this;
+}
+
+big_int& big_int::operator-=(const big_int& other) {
+	if (this == &other)
+		return *this = 0;
+
+	if (negative_ != other.negative_) {
+		add_magnitude(other.limbs());
+	} else if (compare_magnitude(limbs(), other.limbs()) >= 0) {
+		subtract_magnitude(other.limbs());
+	} else {
+		big_int result = other;
+		result.negative_ = !other.negative_;
+		result.subtract_magnitude(limbs());
+		*this = std::move(result);
+	}
+
+	return *this;
+}
+
+big_int tscc::operator*(const big_int& left, const big_int& right) {
+	if (left.is_zero() || right.is_zero())
+		return {};
+
+	auto negative = left.negative_ != right.negative_;
+
+	limb product;
+	if (left.is_inline() && right.is_inline() &&
+		!__builtin_mul_overflow(left.small_, right.small_, &product)) {
+		big_int result = product;
+		result.negative_ = negative;
+		return result;
+	}
+
+	auto a = left.limbs();
+	auto b = right.limbs();
+
+	big_int result;
+	result.grow(a.size() + b.size());
+	auto out = result.data();
+	for (std::size_t i = 0; i < a.size(); ++i) {
+		limb carry = 0;
+		for (std::size_t j = 0; j < b.size(); ++j) {
+			auto sum = wide_limb{a[i]} * b[j] + out[i + j] + carry;
+			out[i + j] = static_cast<limb>(sum);
+			carry = static_cast<limb>(sum >> limb_bits);
+		}
+		out[i + b.size()] = carry;
+	}
+
+	result.negative_ = negative;
+	result.trim();
+	return result;
+}
+
+big_int& big_int::operator*=(const big_int& other) {
+	return *this = *this * other;
+}
+
+big_int& big_int::operator/=(const big_int& other) {
+	if (other.is_zero())
+		throw std::domain_error("division by zero");
+
+	auto negative = negative_ != other.negative_;
+	if (other.size_ == 1) {
+		divide_magnitude(other.data()[0]);
+	} else if (compare_magnitude(limbs(), other.limbs()) < 0) {
+		return *this = 0;
+	} else {
+		std::vector<limb> quotient;
+		std::vector<limb> remainder;
+		divide_long(limbs(), other.limbs(), quotient, remainder);
+		*this = from_limbs(quotient, false);
+	}
+
+	negative_ = negative;
+	trim();
+	return *this;
+}
+
+big_int& big_int::operator%=(const big_int& other) {
+	if (other.is_zero())
+		throw std::domain_error("division by zero");
+
+	// the remainder takes the sign of the dividend
+	auto negative = negative_;
+	if (other.size_ == 1) {
+		*this = divide_magnitude(other.data()[0]);
+	} else if (compare_magnitude(limbs(), other.limbs()) < 0) {
+		return *this;
+	} else {
+		std::vector<limb> quotient;
+		std::vector<limb> remainder;
+		divide_long(limbs(), other.limbs(), quotient, remainder);
+		*this = from_limbs(remainder, false);
+	}
+
+	negative_ = negative;
+	trim();
+	return *this;
+}
+
+big_int& big_int::operator&=(const big_int& other) {
+	if (!negative_ && !other.negative_ && is_inline() && other.is_inline()) {
+		small_ &= other.small_;
+		size_ = small_ != 0;
+		return *this;
+	}
+
+	bitwise(*this, other, [](limb a, limb b) { return a & b; });
+	return *this;
+}
+
+big_int& big_int::operator|=(const big_int& other) {
+	if (!negative_ && !other.negative_ && is_inline() && other.is_inline()) {
+		small_ |= other.small_;
+		size_ = small_ != 0;
+		return *this;
+	}
+
+	bitwise(*this, other, [](limb a, limb b) { return a | b; });
+	return *this;
+}
+
+big_int& big_int::operator^=(const big_int& other) {
+	if (!negative_ && !other.negative_ && is_inline() && other.is_inline()) {
+		small_ ^= other.small_;
+		size_ = small_ != 0;
+		return *this;
+	}
+
+	bitwise(*this, other, [](limb a, limb b) { return a ^ b; });
+	return *this;
+}
+
+big_int& big_int::operator<<=(std::size_t bits) {
+	if (is_zero() || bits == 0)
+		return *this;
+
+	auto words = bits / limb_bits;
+	auto offset = static_cast<unsigned>(bits % limb_bits);
+	if (is_inline() && words == 0 && (small_ >> (limb_bits - offset)) == 0) {
+		small_ <<= offset;
+		return *this;
+	}
+
+	auto size = size_;
+	grow(size + words + 1);
+
+	// move the limbs up from the top down so none is overwritten before
+	// it's read
+	auto limbs = data();
+	for (auto i = size; i-- > 0;) {
+		auto value = limbs[i];
+		limbs[i] = 0;
+		limbs[i + words] = value << offset;
+		if (offset)
+			limbs[i + words + 1] |= value >> (limb_bits - offset);
+	}
+
+	trim();
+	return *this;
+}
+
+big_int& big_int::operator>>=(std::size_t bits) {
+	if (is_zero() || bits == 0)
+		return *this;
+
+	// negative values round towards negative infinity, so they move one
+	// further from zero when any 1 bits are shifted out
+	auto negative = negative_;
+	auto words = bits / limb_bits;
+	auto offset = static_cast<unsigned>(bits % limb_bits);
+	if (words >= size_)
+		return *this = negative ? -1 : 0;
+
+	auto limbs = data();
+	auto lost = offset && (limbs[words] & ((limb{1} << offset) - 1)) != 0;
+	for (std::size_t i = 0; i < words && !lost; ++i)
+		lost = limbs[i] != 0;
+
+	for (std::size_t i = 0; i + words < size_; ++i) {
+		limbs[i] = limbs[i + words] >> offset;
+		if (offset && i + words + 1 < size_)
+			limbs[i] |= limbs[i + words + 1] << (limb_bits - offset);
+	}
+	size_ -= static_cast<std::uint32_t>(words);
+	trim();
+
+	if (negative && lost) {
+		limb one = 1;
+		add_magnitude({&one, 1});
+		negative_ = true;
+	}
+
+	return *this;
+}
+
+bool tscc::operator==(const big_int& left, const big_int& right) noexcept {
+	return left.negative_ == right.negative_ &&
+		   compare_magnitude(left.limbs(), right.limbs()) == 0;
+}
+
+std::strong_ordering tscc::operator<=>(const big_int& left,
+									   const big_int& right) noexcept {
+	if (left.negative_ != right.negative_)
+		return left.negative_ ? std::strong_ordering::less
+							  : std::strong_ordering::greater;
+
+	auto order = compare_magnitude(left.limbs(), right.limbs());
+	if (left.negative_)
+		order = -order;
+	return order <=> 0;
+}
+
+void big_int::grow(std::size_t limbs) {
+	if (limbs <= size_)
+		return;
+	if (limbs > std::numeric_limits<std::uint32_t>::max())
+		throw std::length_error("integer is too large");
+
+	std::size_t capacity = capacity_ ? capacity_ : 1;
+	if (limbs > capacity) {
+		auto grown_capacity = std::max(limbs, capacity * 2);
+		auto grown = new limb[grown_capacity];
+		std::copy_n(data(), size_, grown);
+		if (capacity_)
+			delete[] heap_;
+
+		heap_ = grown;
+		capacity_ = static_cast<std::uint32_t>(grown_capacity);
+	}
+
+	std::fill(data() + size_, data() + limbs, 0);
+	size_ = static_cast<std::uint32_t>(limbs);
+}
+
+void big_int::trim() noexcept {
+	auto limbs = data();
+	while (size_ && limbs[size_ - 1] == 0)
+		--size_;
+
+	if (!size_)
+		negative_ = false;
+}
+
+void big_int::multiply_add_slow(limb factor, limb addend) {
+	if (negative_) {
+		*this = *this * factor + addend;
+		return;
+	}
+
+	auto size = size_;
+	auto limbs = data();
+	auto carry = addend;
+	for (std::size_t i = 0; i < size; ++i) {
+		auto sum = wide_limb{limbs[i]} * factor + carry;
+		limbs[i] = static_cast<limb>(sum);
+		carry = static_cast<limb>(sum >> limb_bits);
+	}
+
+	if (carry) {
+		grow(size + 1);
+		data()[size] = carry;
+	}
+
+	trim();
+}
+
+void big_int::add_magnitude(std::span<const limb> other) {
+	limb sum;
+	if (is_inline() && other.size() <= 1 &&
+		!__builtin_add_overflow(small_, other.empty() ? 0 : other[0], &sum)) {
+		small_ = sum;
+		size_ = 1;
+		trim();
+		return;
+	}
+
+	auto size = std::max<std::size_t>(size_, other.size());
+	grow(size + 1);
+
+	auto limbs = data();
+	limb carry = 0;
+	for (std::size_t i = 0; i <= size; ++i) {
+		auto total = wide_limb{limbs[i]} + carry;
+		if (i < other.size())
+			total += other[i];
+		limbs[i] = static_cast<limb>(total);
+		carry = static_cast<limb>(total >> limb_bits);
+	}
+
+	trim();
+}
+
+void big_int::subtract_magnitude(std::span<const limb> other) {
+	auto limbs = data();
+	limb borrow = 0;
+	for (std::size_t i = 0; i < size_; ++i) {
+		auto difference = wide_limb{limbs[i]} - borrow;
+		if (i < other.size())
+			difference -= other[i];
+		limbs[i] = static_cast<limb>(difference);
+		borrow = (difference >> limb_bits) != 0;
+	}
+
+	trim();
+}
+
+big_int::limb big_int::divide_magnitude(limb divisor) noexcept {
+	auto limbs = data();
+	wide_limb remainder = 0;
+	for (auto i = size_; i-- > 0;) {
+		auto current = (remainder << limb_bits) | limbs[i];
+		limbs[i] = static_cast<limb>(current / divisor);
+		remainder = current % divisor;
+	}
+
+	trim();
+	return static_cast<limb>(remainder);
+}
@@ -18,9 +18,205 @@
 
 #pragma once
 
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
 namespace tscc {
 
-// TODO - consider using a class to support even larger values
-using tscc_big_int = long long;
+/**
+ * \brief An arbitrary-precision integer with the semantics of a JS BigInt
+ *
+ * The magnitude is stored as 64-bit limbs, least significant first, next to
+ * a sign. Values that fit in a single limb are kept inline, so the small
+ * literals that make up almost every program never allocate. Larger values
+ * move the limbs to the heap.
+ *
+ * Division and remainder truncate towards zero and the bitwise operators
+ * act on the infinite two's complement form of the value, the same as in
+ * JS, so the results can be used to fold constants.
+ */
+class big_int {
+public:
+	using limb = std::uint64_t;
+
+	constexpr big_int() noexcept : small_(0) {}
+
+	template <std::integral T>
+	constexpr big_int(T value) noexcept : small_(0) {
+		if constexpr (std::signed_integral<T>) {
+			negative_ = value < 0;
+			// negating through unsigned handles the most negative value
+			small_ = negative_ ? limb{0} - static_cast<limb>(value)
+							   : static_cast<limb>(value);
+		} else {
+			small_ = static_cast<limb>(value);
+		}
+		size_ = small_ != 0;
+	}
+
+	big_int(const big_int& other);
+	big_int(big_int&& other) noexcept;
+	~big_int();
+
+	big_int& operator=(const big_int& other);
+	big_int& operator=(big_int&& other) noexcept;
+
+	/**
+	 * \brief Read the digits of a number in base 2 to 36
+	 *
+	 * There is no sign, prefix or separator, just digits in either case.
+	 * Throws std::invalid_argument when a character isn't a digit of the
+	 * base.
+	 */
+	static big_int parse(std::string_view digits, unsigned base = 10);
+
+	/**
+	 * \brief Make a value from the limbs of its magnitude
+	 */
+	static big_int from_limbs(std::span<const limb> limbs, bool negative);
+
+	/**
+	 * \brief Write the value in base 2 to 36, with lower case digits and a
+	 * leading '-' when it's negative
+	 */
+	std::string to_string(unsigned base = 10) const;
+
+	/**
+	 * \brief Set the value to value * factor + addend
+	 *
+	 * This is the step of reading a number a digit at a time, and it doesn't
+	 * leave the inline limb while the result fits in it.
+	 */
+	void multiply_add(limb factor, limb addend) {
+		limb result;
+		if (capacity_ == 0 && !negative_ &&
+			!__builtin_mul_overflow(small_, factor, &result) &&
+			!__builtin_add_overflow(result, addend, &result)) {
+			small_ = result;
+			size_ = result != 0;
+			return;
+		}
+
+		multiply_add_slow(factor, addend);
+	}
+
+	/**
+	 * \brief Get the limbs of the magnitude, which is empty for 0
+	 */
+	std::span<const limb> limbs() const noexcept { return {data(), size_}; }
+
+	bool is_zero() const noexcept { return size_ == 0; }
+	bool is_negative() const noexcept { return negative_; }
+
+	/**
+	 * \brief Whether the value is kept in the inline limb
+	 */
+	bool is_inline() const noexcept { return capacity_ == 0; }
+
+	/**
+	 * \brief Get the value if it fits in 64 bits
+	 */
+	std::optional<std::int64_t> to_int64() const noexcept;
+
+	/**
+	 * \brief Get the nearest floating point value
+	 */
+	long double to_long_double() const noexcept;
+
+	static big_int pow(const big_int& base, std::uint64_t exponent);
+
+	big_int operator-() const&;
+	big_int operator-() &&;
+	big_int operator~() const;
+
+	big_int& operator+=(const big_int& other);
+	big_int& operator-=(const big_int& other);
+	big_int& operator*=(const big_int& other);
+	big_int& operator/=(const big_int& other);
+	big_int& operator%=(const big_int& other);
+	big_int& operator&=(const big_int& other);
+	big_int& operator|=(const big_int& other);
+	big_int& operator^=(const big_int& other);
+	big_int& operator<<=(std::size_t bits);
+	big_int& operator>>=(std::size_t bits);
+
+	friend big_int operator+(big_int left, const big_int& right) {
+		return left += right;
+	}
+	friend big_int operator-(big_int left, const big_int& right) {
+		return left -= right;
+	}
+	friend big_int operator*(const big_int& left, const big_int& right);
+	friend big_int operator/(big_int left, const big_int& right) {
+		return left /= right;
+	}
+	friend big_int operator%(big_int left, const big_int& right) {
+		return left %= right;
+	}
+	friend big_int operator&(big_int left, const big_int& right) {
+		return left &= right;
+	}
+	friend big_int operator|(big_int left, const big_int& right) {
+		return left |= right;
+	}
+	friend big_int operator^(big_int left, const big_int& right) {
+		return left ^= right;
+	}
+	friend big_int operator<<(big_int left, std::size_t bits) {
+		return left <<= bits;
+	}
+	friend big_int operator>>(big_int left, std::size_t bits) {
+		return left >>= bits;
+	}
+
+	friend bool operator==(const big_int& left,
+						   const big_int& right) noexcept;
+	friend std::strong_ordering operator<=>(const big_int& left,
+											const big_int& right) noexcept;
+
+private:
+	limb* data() noexcept { return capacity_ ? heap_ : &small_; }
+	const limb* data() const noexcept { return capacity_ ? heap_ : &small_; }
+
+	// make room for the given number of limbs, keeping the current ones and
+	// zeroing the rest
+	void grow(std::size_t limbs);
+
+	// drop the leading zero limbs, and the sign of zero
+	void trim() noexcept;
+
+	void multiply_add_slow(limb factor, limb addend);
+
+	// the magnitude of the value, added to or subtracted from
+	void add_magnitude(std::span<const limb> other);
+	void subtract_magnitude(std::span<const limb> other);
+
+	// divide by a single limb and return the remainder
+	limb divide_magnitude(limb divisor) noexcept;
+
+	union {
+		limb small_;
+		limb* heap_;
+	};
+
+	std::uint32_t size_ = 0;
+	// 0 while the value is in small_
+	std::uint32_t capacity_ = 0;
+	bool negative_ = false;
+};
+
+big_int operator*(const big_int& left, const big_int& right);
+bool operator==(const big_int& left, const big_int& right) noexcept;
+std::strong_ordering operator<=>(const big_int& left,
+								 const big_int& right) noexcept;
+
+// the name the lexer and tokens use for integer literals
+using tscc_big_int = big_int;
 
-}  // namespace tscc
\ No newline at end of file
+}  // namespace tscc
@@ -0,0 +1,134 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "interner.hpp"
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include "utf8.hpp"
+
+using namespace tscc;
+
+interner& interner::global() {
+	static interner instance;
+	return instance;
+}
+
+atom interner::intern(std::string_view text) {
+	if (text.empty())
+		return {};
+
+	auto hash = std::hash<std::string_view>{}(text);
+	auto shard_index = (hash ^ (hash >> 32)) & (shard_count - 1);
+	auto& table = shards_[shard_index];
+
+	auto make_atom = [shard_index](std::uint32_t index) {
+		// index + 1 so that no string gets the empty atom
+		return atom{static_cast<std::uint32_t>(((index + 1) << shard_bits) |
+											   shard_index)};
+	};
+
+	{
+		std::shared_lock lock(table.mutex);
+		auto found = table.ids.find(text);
+		if (found != table.ids.end())
+			return make_atom(found->second);
+	}
+
+	std::unique_lock lock(table.mutex);
+	auto found = table.ids.find(text);
+	if (found != table.ids.end())
+		return make_atom(found->second);
+
+	if (table.strings.size() >= (std::uint32_t{1} << (32 - shard_bits)) - 1)
+		throw std::length_error("too many strings in the interner");
+
+	auto index = static_cast<std::uint32_t>(table.strings.size());
+	auto stored = table.store(text);
+	table.strings.push_back(stored);
+	table.ids.emplace(stored, index);
+
+	return make_atom(index);
+}
+
+atom interner::intern(std::u32string_view text) {
+	return intern(std::string_view{utf8_encode(text)});
+}
+
+std::optional<atom> interner::find(std::string_view text) const {
+	if (text.empty())
+		return atom{};
+
+	auto hash = std::hash<std::string_view>{}(text);
+	auto shard_index = (hash ^ (hash >> 32)) & (shard_count - 1);
+	const auto& table = shards_[shard_index];
+
+	std::shared_lock lock(table.mutex);
+	auto found = table.ids.find(text);
+	if (found == table.ids.end())
+		return std::nullopt;
+
+	return atom{static_cast<std::uint32_t>(((found->second + 1) << shard_bits) |
+										   shard_index)};
+}
+
+std::string_view interner::view(atom value) const {
+	if (value.empty())
+		return {};
+
+	const auto& table = shards_[value.id_ & (shard_count - 1)];
+	auto index = (value.id_ >> shard_bits) - 1;
+
+	std::shared_lock lock(table.mutex);
+	if (index >= table.strings.size())
+		throw std::out_of_range("atom is not from this interner");
+
+	return table.strings[index];
+}
+
+std::size_t interner::size() const {
+	std::size_t result = 0;
+	for (const auto& table : shards_) {
+		std::shared_lock lock(table.mutex);
+		result += table.strings.size();
+	}
+
+	return result;
+}
+
+std::string_view interner::shard::store(std::string_view text) {
+	// large strings get a block of their own so they don't waste the tail of
+	// the current block
+	if (text.size() > block_size / 4) {
+		auto& block = blocks.emplace_back(new char[text.size()]);
+		std::memcpy(block.get(), text.data(), text.size());
+		return {block.get(), text.size()};
+	}
+
+	if (text.size() > remaining) {
+		free = blocks.emplace_back(new char[block_size]).get();
+		remaining = block_size;
+	}
+
+	auto stored = free;
+	std::memcpy(stored, text.data(), text.size());
+	free += text.size();
+	remaining -= text.size();
+
+	return {stored, text.size()};
+}
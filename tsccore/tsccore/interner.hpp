@@ -0,0 +1,140 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tscc {
+
+/**
+ * \brief A 32-bit handle to a string held by an interner
+ *
+ * Two atoms from the same interner are equal exactly when their strings are
+ * equal, so names can be compared without looking at their text. The default
+ * atom is the empty string.
+ */
+class atom {
+public:
+	constexpr atom() noexcept : id_(0) {}
+
+	/**
+	 * \brief Get the raw value of the atom
+	 */
+	constexpr std::uint32_t id() const noexcept { return id_; }
+
+	/**
+	 * \brief Whether the atom is the empty string
+	 */
+	constexpr bool empty() const noexcept { return id_ == 0; }
+
+	constexpr bool operator==(const atom&) const noexcept = default;
+	constexpr auto operator<=>(const atom&) const noexcept = default;
+
+private:
+	constexpr explicit atom(std::uint32_t id) noexcept : id_(id) {}
+
+	std::uint32_t id_;
+
+	friend class interner;
+};
+
+/**
+ * \brief A thread-safe table of unique strings
+ *
+ * Every distinct string is stored once, as UTF-8, in blocks that are never
+ * moved or freed while the interner lives. That keeps the views handed out
+ * by view() valid for the lifetime of the interner. The table is split into
+ * shards by hash so threads interning different strings rarely wait on each
+ * other.
+ */
+class interner {
+	static constexpr std::size_t shard_bits = 4;
+	static constexpr std::size_t shard_count = std::size_t{1} << shard_bits;
+	static constexpr std::size_t block_size = 64 * 1024;
+
+public:
+	interner() = default;
+
+	// the strings are referenced by view, so the table can't move
+	interner(const interner&) = delete;
+	interner& operator=(const interner&) = delete;
+
+	/**
+	 * \brief Get the interner shared by the lexer and parser
+	 */
+	static interner& global();
+
+	/**
+	 * \brief Get the atom for a UTF-8 string, adding it if it's new
+	 */
+	atom intern(std::string_view text);
+
+	/**
+	 * \brief Get the atom for a UTF-32 string, adding it if it's new
+	 */
+	atom intern(std::u32string_view text);
+
+	/**
+	 * \brief Get the atom for a string only if it was already interned
+	 */
+	std::optional<atom> find(std::string_view text) const;
+
+	/**
+	 * \brief Get the text for an atom from this interner
+	 */
+	std::string_view view(atom value) const;
+
+	/**
+	 * \brief Get the number of distinct non-empty strings in the table
+	 */
+	std::size_t size() const;
+
+private:
+	struct shard {
+		mutable std::shared_mutex mutex;
+		std::unordered_map<std::string_view, std::uint32_t> ids;
+		std::vector<std::string_view> strings;
+
+		std::vector<std::unique_ptr<char[]>> blocks;
+		char* free = nullptr;
+		std::size_t remaining = 0;
+
+		std::string_view store(std::string_view text);
+	};
+
+	std::array<shard, shard_count> shards_;
+};
+
+}  // namespace tscc
+
+template <>
+struct std::hash<tscc::atom> {
+	std::size_t operator()(const tscc::atom& value) const noexcept {
+		return std::hash<std::uint32_t>{}(value.id());
+	}
+};
@@ -29,6 +29,8 @@ atom::atom(character_class character_class)
 
 atom::atom(group group) : value_(std::move(group)) {}
 
+atom::atom(backreference backreference) : value_(backreference) {}
+
 bool atom::is_character() const {
 	return std::holds_alternative<char32_t>(value_);
 }
@@ -45,6 +47,10 @@ bool atom::is_group() const {
 	return std::holds_alternative<group>(value_);
 }
 
+bool atom::is_backreference() const {
+	return std::holds_alternative<backreference>(value_);
+}
+
 char32_t atom::get_character() const {
 	return std::get<char32_t>(value_);
 }
@@ -61,6 +67,10 @@ const group& atom::get_group() const {
 	return std::get<group>(value_);
 }
 
+atom::backreference atom::get_backreference() const {
+	return std::get<backreference>(value_);
+}
+
 std::size_t atom::string_size() const noexcept {
 	if (is_character()) {
 		char32_t ch = get_character();
@@ -77,6 +87,8 @@ std::size_t atom::string_size() const noexcept {
 		return 2;
 	} else if (is_character_class()) {
 		return get_character_class().string_size();
+	} else if (is_backreference()) {
+		return 1 + std::to_string(get_backreference().number).size();
 	} else {
 		return get_group().string_size();
 	}
@@ -132,6 +144,10 @@ void atom::to_string(std::u32string& to) const {
 		}
 	} else if (is_character_class()) {
 		get_character_class().to_string(to);
+	} else if (is_backreference()) {
+		to += U'\\';
+		for (auto digit : std::to_string(get_backreference().number))
+			to += static_cast<char32_t>(digit);
 	} else {
 		get_group().to_string(to);
 	}
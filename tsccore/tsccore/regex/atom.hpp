@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <variant>
 #include "character_class.hpp"
@@ -37,20 +38,32 @@ public:
 		non_whitespace	// \S
 	};
 
+	/**
+	 * \brief A reference to what a capturing group matched, like \1
+	 */
+	struct backreference {
+		std::size_t number;
+
+		bool operator==(const backreference& other) const noexcept = default;
+	};
+
 	atom(char32_t character);
 	atom(builtin_class builtin_class);
 	atom(character_class character_class);
 	atom(group group);
+	atom(backreference backreference);
 
 	bool is_character() const;
 	bool is_builtin_class() const;
 	bool is_character_class() const;
 	bool is_group() const;
+	bool is_backreference() const;
 
 	char32_t get_character() const;
 	builtin_class get_builtin_class() const;
 	const character_class& get_character_class() const;
 	const group& get_group() const;
+	backreference get_backreference() const;
 
 	std::size_t string_size() const noexcept;
 	void to_string(std::u32string& to) const;
@@ -59,7 +72,8 @@ public:
 	bool operator!=(const atom& other) const noexcept;
 
 private:
-	std::variant<char32_t, builtin_class, character_class, group> value_;
+	std::variant<char32_t, builtin_class, character_class, group, backreference>
+		value_;
 };
 
 }  // namespace tsccore::regex
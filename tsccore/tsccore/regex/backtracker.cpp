@@ -0,0 +1,208 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backtracker.hpp"
+#include <limits>
+
+using namespace tsccore::regex;
+
+namespace {
+
+constexpr std::size_t unset = std::numeric_limits<std::size_t>::max();
+constexpr std::uint32_t no_slot = std::numeric_limits<std::uint32_t>::max();
+
+// either a thread to try, or a slot to put back when backing up past it
+struct frame {
+	std::uint32_t pc;
+	std::uint32_t slot;
+	std::size_t value;
+};
+
+}  // namespace
+
+backtracker::backtracker(const program& program) noexcept
+	: program_(program) {}
+
+bool backtracker::search(std::u32string_view input,
+						 std::size_t from,
+						 bool anchored,
+						 std::vector<std::size_t>& slots) {
+	for (auto start = from; start <= input.size(); ++start) {
+		slots.assign(program_.slot_count(), unset);
+		if (run(program::start, start, input, slots, unset))
+			return true;
+		if (anchored)
+			break;
+	}
+
+	return false;
+}
+
+bool backtracker::run(std::uint32_t pc,
+					  std::size_t position,
+					  std::u32string_view input,
+					  std::vector<std::size_t>& slots,
+					  std::size_t end) const {
+	using opcode = program::opcode;
+
+	auto instructions = program_.instructions();
+	bool ignore_case = has_flag(program_.flags(), match_flags::ignore_case);
+
+	std::vector<frame> stack;
+	stack.push_back({pc, no_slot, position});
+
+	auto set_slot = [&](std::uint32_t slot, std::size_t value) {
+		stack.push_back({0, slot, slots[slot]});
+		slots[slot] = value;
+	};
+
+	while (!stack.empty()) {
+		auto top = stack.back();
+		stack.pop_back();
+
+		if (top.slot != no_slot) {
+			slots[top.slot] = top.value;
+			continue;
+		}
+
+		pc = top.pc;
+		position = top.value;
+
+		// follow this thread until it fails
+		while (true) {
+			auto& inst = instructions[pc];
+			switch (inst.op) {
+				case opcode::character:
+				case opcode::any_of:
+					if (position < input.size() &&
+						program_.accepts(inst, input[position])) {
+						++pc;
+						++position;
+						continue;
+					}
+					break;
+				case opcode::split:
+					stack.push_back({inst.y, no_slot, position});
+					pc = inst.x;
+					continue;
+				case opcode::jump:
+					pc = inst.x;
+					continue;
+				case opcode::save:
+				case opcode::mark:
+					set_slot(inst.x, position);
+					++pc;
+					continue;
+				case opcode::reset:
+					for (auto group = inst.x; group <= inst.y; ++group) {
+						set_slot(group * 2, unset);
+						set_slot(group * 2 + 1, unset);
+					}
+					++pc;
+					continue;
+				case opcode::check_progress:
+					if (slots[inst.x] == position)
+						break;
+					++pc;
+					continue;
+				case opcode::line_start:
+				case opcode::line_end:
+				case opcode::word_boundary:
+				case opcode::non_word_boundary:
+					if (!program_.holds(inst, input, position))
+						break;
+					++pc;
+					continue;
+				case opcode::backreference: {
+					// a group that didn't take part matches nothing
+					std::size_t begin = unset;
+					std::size_t finish = unset;
+					if (inst.x < program_.group_count()) {
+						begin = slots[inst.x * 2];
+						finish = slots[inst.x * 2 + 1];
+					}
+					if (begin == unset || finish == unset) {
+						++pc;
+						continue;
+					}
+
+					auto length = finish - begin;
+					if (length > input.size() - position)
+						break;
+
+					bool same = true;
+					for (std::size_t i = 0; i < length && same; ++i) {
+						auto left = input[begin + i];
+						auto right = input[position + i];
+						same = left == right ||
+							   (ignore_case && fold_case(left) == fold_case(right));
+					}
+					if (!same)
+						break;
+
+					position += length;
+					++pc;
+					continue;
+				}
+				case opcode::lookaround: {
+					auto& lookaround = program_.get_lookaround(inst.x);
+					bool positive =
+						lookaround.type == group::type::positive_lookahead ||
+						lookaround.type == group::type::positive_lookbehind;
+
+					auto found = slots;
+					bool matched = false;
+					if (lookaround.type == group::type::positive_lookahead ||
+						lookaround.type == group::type::negative_lookahead) {
+						matched =
+							run(lookaround.start, position, input, found, unset);
+					} else {
+						for (std::size_t start = 0;
+							 start <= position && !matched; ++start) {
+							found = slots;
+							matched = run(lookaround.start, start, input, found,
+										  position);
+						}
+					}
+
+					if (matched != positive)
+						break;
+
+					// groups captured inside a positive lookaround are kept
+					if (positive) {
+						for (std::uint32_t slot = 0;
+							 slot < program_.group_count() * 2; ++slot) {
+							if (found[slot] != slots[slot])
+								set_slot(slot, found[slot]);
+						}
+					}
+					++pc;
+					continue;
+				}
+				case opcode::match:
+					if (end != unset && position != end)
+						break;
+					return true;
+			}
+
+			break;
+		}
+	}
+
+	return false;
+}
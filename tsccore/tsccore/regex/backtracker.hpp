@@ -0,0 +1,65 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "program.hpp"
+
+namespace tsccore::regex {
+
+/**
+ * \brief Runs a program by trying one thread at a time and backing up to the
+ * last split when it fails
+ *
+ * This is the only engine that supports backreferences and lookbehind, and
+ * like every backtracking engine it can take exponential time on patterns
+ * like (a+)+b. Lookbehind is checked by trying each start before the current
+ * position, from the furthest one in, for a match that ends exactly at it.
+ */
+class backtracker {
+public:
+	explicit backtracker(const program& program) noexcept;
+
+	/**
+	 * \brief Find the leftmost match that starts at or after from
+	 * \param anchored Only try a match that starts at from
+	 * \param slots Filled with the capture slots of the match
+	 */
+	bool search(std::u32string_view input,
+				std::size_t from,
+				bool anchored,
+				std::vector<std::size_t>& slots);
+
+private:
+	/**
+	 * \brief Run from pc at position, and if end is set only accept a match
+	 * that ends there
+	 */
+	bool run(std::uint32_t pc,
+			 std::size_t position,
+			 std::u32string_view input,
+			 std::vector<std::size_t>& slots,
+			 std::size_t end) const;
+
+	const program& program_;
+};
+
+}  // namespace tsccore::regex
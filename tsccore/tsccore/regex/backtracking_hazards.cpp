@@ -0,0 +1,386 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backtracking_hazards.hpp"
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include "alternative.hpp"
+#include "atom.hpp"
+#include "character_class.hpp"
+#include "disjunction.hpp"
+
+namespace tsccore::regex {
+
+namespace {
+
+constexpr std::size_t unbounded = std::numeric_limits<std::size_t>::max();
+constexpr char32_t max_code_point = 0x10ffff;
+
+using ranges = std::vector<std::pair<char32_t, char32_t>>;
+
+void normalize(ranges& set) {
+	std::sort(set.begin(), set.end());
+
+	std::size_t kept = 0;
+	for (auto& range : set) {
+		if (kept && range.first <= set[kept - 1].second + 1)
+			set[kept - 1].second = std::max(set[kept - 1].second, range.second);
+		else
+			set[kept++] = range;
+	}
+	set.resize(kept);
+}
+
+ranges complement(const ranges& set) {
+	ranges result;
+	char32_t next = 0;
+	for (auto [first, last] : set) {
+		if (first > next)
+			result.emplace_back(next, first - 1);
+		next = last + 1;
+	}
+	if (next <= max_code_point)
+		result.emplace_back(next, max_code_point);
+	return result;
+}
+
+void unite(ranges& into, const ranges& other) {
+	into.insert(into.end(), other.begin(), other.end());
+	normalize(into);
+}
+
+bool overlaps(const ranges& lhs, const ranges& rhs) {
+	auto left = lhs.begin();
+	auto right = rhs.begin();
+	while (left != lhs.end() && right != rhs.end()) {
+		if (left->second < right->first)
+			++left;
+		else if (right->second < left->first)
+			++right;
+		else
+			return true;
+	}
+	return false;
+}
+
+/**
+ * \brief What is known about the text that part of a pattern matches
+ */
+struct summary {
+	// the characters that can start and end a match, and every character
+	// that can be in one
+	ranges first;
+	ranges last;
+	ranges all;
+
+	bool nullable = true;
+
+	// the characters an unbounded repetition at the start or the end could
+	// take from whatever is next to it
+	ranges loop_head;
+	ranges loop_tail;
+
+	// some text can be matched by more than one of a set of alternatives
+	bool ambiguous = false;
+
+	// a hazard was reported inside, so repetitions around it don't report
+	// the same one again
+	bool reported = false;
+};
+
+summary concatenate(const summary& lhs, const summary& rhs) {
+	summary result;
+	result.first = lhs.first;
+	if (lhs.nullable)
+		unite(result.first, rhs.first);
+
+	result.last = rhs.last;
+	if (rhs.nullable)
+		unite(result.last, lhs.last);
+
+	result.all = lhs.all;
+	unite(result.all, rhs.all);
+	result.nullable = lhs.nullable && rhs.nullable;
+
+	result.loop_head = lhs.loop_head;
+	if (lhs.nullable)
+		unite(result.loop_head, rhs.loop_head);
+
+	result.loop_tail = rhs.loop_tail;
+	if (rhs.nullable)
+		unite(result.loop_tail, lhs.loop_tail);
+
+	result.ambiguous = lhs.ambiguous || rhs.ambiguous;
+	result.reported = lhs.reported || rhs.reported;
+	return result;
+}
+
+summary consuming(ranges set) {
+	normalize(set);
+
+	summary result;
+	result.first = set;
+	result.last = set;
+	result.all = std::move(set);
+	result.nullable = false;
+	return result;
+}
+
+class analyzer {
+public:
+	analyzer(match_flags flags, std::vector<backtracking_hazard>& into)
+		: flags_(flags), into_(into) {}
+
+	summary analyze(const disjunction& value, bool top) {
+		std::vector<summary> alternatives;
+		for (auto& alternative : value.get_alternatives())
+			alternatives.push_back(analyze(alternative, top));
+
+		if (alternatives.empty())
+			return {};
+
+		summary result = alternatives.front();
+		for (std::size_t i = 1; i < alternatives.size(); ++i) {
+			auto& next = alternatives[i];
+			unite(result.first, next.first);
+			unite(result.last, next.last);
+			unite(result.all, next.all);
+			unite(result.loop_head, next.loop_head);
+			unite(result.loop_tail, next.loop_tail);
+			result.nullable = result.nullable || next.nullable;
+			result.ambiguous = result.ambiguous || next.ambiguous;
+			result.reported = result.reported || next.reported;
+
+			// text that two alternatives can both start and end with is
+			// taken as text that both can match
+			for (std::size_t j = 0; j < i; ++j) {
+				if (overlaps(alternatives[j].first, next.first) &&
+					overlaps(alternatives[j].last, next.last)) {
+					result.ambiguous = true;
+				}
+			}
+		}
+
+		return result;
+	}
+
+private:
+	summary analyze(const alternative& value, bool top) {
+		auto& terms = value.get_terms();
+
+		// a run of unbounded repetitions that can take each other's
+		// characters, which can split their text between them in n^k ways
+		std::size_t chain = 0;
+		std::size_t chain_start = 0;
+		std::size_t chain_end = 0;
+		ranges chain_characters;
+
+		summary result;
+		for (std::size_t i = 0; i < terms.size(); ++i) {
+			auto part = analyze(terms[i]);
+
+			if (is_unbounded(terms[i])) {
+				if (!chain || !overlaps(chain_characters, part.all)) {
+					report_chain(terms, chain, chain_start, chain_end);
+					chain = 0;
+					chain_start = i;
+				}
+				++chain;
+				chain_end = i;
+				chain_characters = part.all;
+			} else if (!part.nullable || terms[i].is_assertion()) {
+				// the chain only backtracks when something after it fails
+				report_chain(terms, chain, chain_start, chain_end);
+				chain = 0;
+			}
+
+			result = concatenate(result, part);
+		}
+
+		// and at the end of the pattern nothing can
+		if (!top)
+			report_chain(terms, chain, chain_start, chain_end);
+
+		return result;
+	}
+
+	summary analyze(const term& value) {
+		if (value.is_assertion())
+			return {};
+
+		auto body = analyze(value.get_atom());
+		auto& quantifier = value.get_quantifier();
+		if (!quantifier)
+			return body;
+
+		auto [min, max] = bounds(*quantifier);
+		if (max == 0)
+			return {};
+		if (min == 0)
+			body.nullable = true;
+		if (max != unbounded)
+			return body;
+
+		// an inner repetition that can carry on into the next iteration, or
+		// take the end of the one before, splits the same text between
+		// iterations in exponentially many ways
+		bool nested = overlaps(body.loop_tail, body.first) ||
+					  overlaps(body.loop_head, body.last);
+		if (!body.reported && (nested || body.ambiguous)) {
+			std::u32string source;
+			value.to_string(source);
+			into_.push_back(
+				{nested ? backtracking_hazard::type::nested_quantifier
+						: backtracking_hazard::type::overlapping_alternatives,
+				 true, 0, std::move(source)});
+			body.reported = true;
+		}
+
+		body.loop_head = body.last;
+		body.loop_tail = body.first;
+		body.ambiguous = false;
+		return body;
+	}
+
+	summary analyze(const atom& value) {
+		if (value.is_character()) {
+			auto ch = value.get_character();
+			ranges set{{ch, ch}};
+			if (has_flag(flags_, match_flags::ignore_case))
+				set.emplace_back(swap_case(ch), swap_case(ch));
+			return consuming(std::move(set));
+		}
+
+		if (value.is_builtin_class())
+			return consuming(builtin_ranges(value.get_builtin_class()));
+
+		if (value.is_character_class()) {
+			auto& source = value.get_character_class();
+			ranges set(source.get_ranges());
+			for (auto ch : source.get_characters()) {
+				set.emplace_back(ch, ch);
+				if (has_flag(flags_, match_flags::ignore_case))
+					set.emplace_back(swap_case(ch), swap_case(ch));
+			}
+
+			normalize(set);
+			return consuming(source.is_negated() ? complement(set) : set);
+		}
+
+		if (value.is_group()) {
+			auto& inner = value.get_group();
+			auto result = analyze(inner.get_disjunction(), false);
+			if (inner.get_type() == group::type::capturing ||
+				inner.get_type() == group::type::non_capturing) {
+				return result;
+			}
+
+			// lookaround doesn't consume anything
+			summary empty;
+			empty.reported = result.reported;
+			return empty;
+		}
+
+		// a backreference could be anything
+		auto result = consuming({{0, max_code_point}});
+		result.nullable = true;
+		return result;
+	}
+
+	ranges builtin_ranges(atom::builtin_class value) const {
+		switch (value) {
+			case atom::builtin_class::dot:
+				if (has_flag(flags_, match_flags::dot_all))
+					return {{0, max_code_point}};
+				return complement(
+					{{U'\n', U'\n'}, {U'\r', U'\r'}, {0x2028, 0x2029}});
+			case atom::builtin_class::word:
+				return {{U'0', U'9'}, {U'A', U'Z'}, {U'_', U'_'}, {U'a', U'z'}};
+			case atom::builtin_class::non_word:
+				return complement(builtin_ranges(atom::builtin_class::word));
+			case atom::builtin_class::digit:
+				return {{U'0', U'9'}};
+			case atom::builtin_class::non_digit:
+				return complement(builtin_ranges(atom::builtin_class::digit));
+			case atom::builtin_class::whitespace:
+				return {{0x9, 0xd},		  {0x20, 0x20},		{0xa0, 0xa0},
+						{0x1680, 0x1680}, {0x2000, 0x200a}, {0x2028, 0x2029},
+						{0x202f, 0x202f}, {0x205f, 0x205f}, {0x3000, 0x3000},
+						{0xfeff, 0xfeff}};
+			case atom::builtin_class::non_whitespace:
+				return complement(
+					builtin_ranges(atom::builtin_class::whitespace));
+		}
+		return {};
+	}
+
+	void report_chain(const std::vector<term>& terms,
+					  std::size_t chain,
+					  std::size_t start,
+					  std::size_t end) {
+		if (chain < 2)
+			return;
+
+		std::u32string source;
+		for (auto i = start; i <= end; ++i)
+			terms[i].to_string(source);
+
+		into_.push_back({backtracking_hazard::type::adjacent_quantifiers,
+						 false, chain, std::move(source)});
+	}
+
+	static std::pair<std::size_t, std::size_t> bounds(
+		const quantifier& value) {
+		if (value.is_range())
+			return value.get_range();
+
+		switch (value.get_prefix()) {
+			case quantifier::prefix::zero_or_more:
+				return {0, unbounded};
+			case quantifier::prefix::one_or_more:
+				return {1, unbounded};
+			case quantifier::prefix::zero_or_one:
+				return {0, 1};
+		}
+		return {0, unbounded};
+	}
+
+	static bool is_unbounded(const term& value) {
+		if (value.is_assertion())
+			return false;
+
+		auto& quantifier = value.get_quantifier();
+		return quantifier && bounds(*quantifier).second == unbounded;
+	}
+
+	match_flags flags_;
+	std::vector<backtracking_hazard>& into_;
+};
+
+}  // namespace
+
+std::vector<backtracking_hazard> find_backtracking_hazards(
+	const regular_expression& expression,
+	match_flags flags) {
+	std::vector<backtracking_hazard> result;
+	analyzer(flags, result).analyze(expression.get_disjunction(), true);
+	return result;
+}
+
+}  // namespace tsccore::regex
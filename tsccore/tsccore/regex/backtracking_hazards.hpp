@@ -0,0 +1,65 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "program.hpp"
+#include "regular_expression.hpp"
+
+namespace tsccore::regex {
+
+/**
+ * \brief A part of a pattern that a backtracking engine can take a very long
+ * time to fail on
+ *
+ * The engines in this library don't backtrack on these, but the ones in
+ * JavaScript runtimes do, so a pattern in source code that has one can stall
+ * a program on the wrong input.
+ */
+struct backtracking_hazard {
+	enum class type {
+		nested_quantifier,			// (a+)+
+		overlapping_alternatives,	// (\w|\d)*
+		adjacent_quantifiers		// \d+\d+x
+	};
+
+	type hazard_type;
+
+	// the steps to fail grow like 2^n when exponential, and like n^degree
+	// otherwise, for input of length n
+	bool exponential;
+	std::size_t degree;
+
+	// the part of the pattern that backtracks
+	std::u32string source;
+};
+
+/**
+ * \brief Look for the shapes of pattern that backtrack catastrophically
+ *
+ * This is a conservative check, and a pattern that has no hazards can still
+ * be slow. Unbounded repetitions are the only ones that are looked at.
+ */
+std::vector<backtracking_hazard> find_backtracking_hazards(
+	const regular_expression& expression,
+	match_flags flags = match_flags::none);
+
+}  // namespace tsccore::regex
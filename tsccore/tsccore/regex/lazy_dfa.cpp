@@ -0,0 +1,206 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lazy_dfa.hpp"
+#include <algorithm>
+
+using namespace tsccore::regex;
+
+std::size_t lazy_dfa::pcs_hash::operator()(
+	const std::vector<std::uint32_t>& pcs) const noexcept {
+	std::uint64_t hash = 0xcbf29ce484222325ull;
+	for (auto pc : pcs) {
+		hash ^= pc;
+		hash *= 0x100000001b3ull;
+	}
+	return static_cast<std::size_t>(hash);
+}
+
+lazy_dfa::lazy_dfa(const program& program, bool anchored)
+	: program_(program),
+	  anchored_(anchored),
+	  seen_(program.instructions().size()) {
+	starts_.fill(unknown);
+}
+
+bool lazy_dfa::search(std::u32string_view input, std::size_t from) {
+	auto current = start_state(from == 0);
+	for (auto position = from;; ++position) {
+		if (states_[current].accepting)
+			return true;
+
+		if (position == input.size())
+			return accepts_at_end(current, position == 0);
+
+		// nothing is left to match and nothing new gets started
+		if (anchored_ && states_[current].pcs.empty())
+			return false;
+
+		current = next_state(current, input[position]);
+	}
+}
+
+std::int32_t lazy_dfa::start_state(bool at_begin) {
+	auto& start = starts_[at_begin];
+	if (start == unknown) {
+		++generation_;
+		building_.clear();
+		closure(program::start, at_begin, false);
+		start = intern();
+	}
+
+	return start;
+}
+
+std::int32_t lazy_dfa::next_state(std::int32_t from, char32_t ch) {
+	if (ch < 128) {
+		auto known = states_[from].ascii[ch];
+		if (known != unknown)
+			return known;
+	} else {
+		auto found = states_[from].others.find(ch);
+		if (found != states_[from].others.end())
+			return found->second;
+	}
+
+	++generation_;
+	building_.clear();
+
+	auto instructions = program_.instructions();
+	for (auto pc : states_[from].pcs) {
+		auto& inst = instructions[pc];
+		if ((inst.op == program::opcode::character ||
+			 inst.op == program::opcode::any_of) &&
+			program_.accepts(inst, ch)) {
+			closure(pc + 1, false, false);
+		}
+	}
+
+	// the threads that start at the next character have the lowest priority,
+	// which doesn't matter here since only whether there's a match does
+	if (!anchored_)
+		closure(program::start, false, false);
+
+	auto flushes = flushes_;
+	auto to = intern();
+
+	// intern() threw everything away and from is gone
+	if (flushes != flushes_)
+		return to;
+
+	if (ch < 128)
+		states_[from].ascii[ch] = to;
+	else
+		states_[from].others.emplace(ch, to);
+
+	return to;
+}
+
+bool lazy_dfa::accepts_at_end(std::int32_t from, bool at_begin) {
+	++generation_;
+	building_.clear();
+
+	// $ is kept in a state until the end of the input says whether it holds
+	auto instructions = program_.instructions();
+	for (auto pc : states_[from].pcs) {
+		if (instructions[pc].op == program::opcode::line_end)
+			closure(pc + 1, at_begin, true);
+	}
+
+	return std::any_of(building_.begin(), building_.end(), [&](auto pc) {
+		return instructions[pc].op == program::opcode::match;
+	});
+}
+
+void lazy_dfa::closure(std::uint32_t pc, bool at_begin, bool at_end) {
+	using opcode = program::opcode;
+
+	auto instructions = program_.instructions();
+	stack_.push_back(pc);
+	while (!stack_.empty()) {
+		pc = stack_.back();
+		stack_.pop_back();
+
+		if (seen_[pc] == generation_)
+			continue;
+		seen_[pc] = generation_;
+
+		auto& inst = instructions[pc];
+		switch (inst.op) {
+			case opcode::jump:
+				stack_.push_back(inst.x);
+				break;
+			case opcode::split:
+				stack_.push_back(inst.y);
+				stack_.push_back(inst.x);
+				break;
+			case opcode::save:
+			case opcode::mark:
+			case opcode::reset:
+			// skipping an iteration that matched nothing never changes
+			// whether there's a match
+			case opcode::check_progress:
+				stack_.push_back(pc + 1);
+				break;
+			case opcode::line_start:
+				if (at_begin)
+					stack_.push_back(pc + 1);
+				break;
+			case opcode::line_end:
+				if (at_end)
+					stack_.push_back(pc + 1);
+				else
+					building_.push_back(pc);
+				break;
+			case opcode::character:
+			case opcode::any_of:
+			case opcode::match:
+				building_.push_back(pc);
+				break;
+			default:
+				// not DFA compatible
+				break;
+		}
+	}
+}
+
+std::int32_t lazy_dfa::intern() {
+	std::sort(building_.begin(), building_.end());
+
+	auto found = ids_.find(building_);
+	if (found != ids_.end())
+		return found->second;
+
+	if (states_.size() >= max_states) {
+		states_.clear();
+		ids_.clear();
+		starts_.fill(unknown);
+		++flushes_;
+	}
+
+	auto id = static_cast<std::int32_t>(states_.size());
+	auto& added = states_.emplace_back();
+	added.pcs = building_;
+	added.ascii.fill(unknown);
+	added.accepting = std::any_of(added.pcs.begin(), added.pcs.end(), [&](auto pc) {
+		return program_.instructions()[pc].op == program::opcode::match;
+	});
+	ids_.emplace(building_, id);
+
+	return id;
+}
@@ -0,0 +1,98 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "program.hpp"
+
+namespace tsccore::regex {
+
+/**
+ * \brief Answers whether a program matches with a DFA that is built as the
+ * input is read
+ *
+ * Each state is the set of pcs the NFA could be at, and a transition is only
+ * worked out the first time it's taken, after which it's a table lookup. This
+ * can't report captures, and only runs programs that are
+ * program::is_dfa_compatible(). When the cache grows past max_states it's
+ * thrown away and built up again.
+ */
+class lazy_dfa {
+public:
+	static constexpr std::size_t max_states = 4096;
+
+	/**
+	 * \param anchored Only look for matches that start where the search does
+	 */
+	lazy_dfa(const program& program, bool anchored);
+
+	/**
+	 * \brief Whether there's a match that starts at or after from
+	 */
+	bool search(std::u32string_view input, std::size_t from);
+
+	/**
+	 * \brief The number of states built so far
+	 */
+	std::size_t state_count() const noexcept { return states_.size(); }
+
+private:
+	static constexpr std::int32_t unknown = -1;
+
+	struct state {
+		std::vector<std::uint32_t> pcs;
+		bool accepting = false;
+		std::array<std::int32_t, 128> ascii;
+		std::unordered_map<char32_t, std::int32_t> others;
+	};
+
+	struct pcs_hash {
+		std::size_t operator()(const std::vector<std::uint32_t>& pcs) const noexcept;
+	};
+
+	std::int32_t start_state(bool at_begin);
+	std::int32_t next_state(std::int32_t from, char32_t ch);
+	bool accepts_at_end(std::int32_t from, bool at_begin);
+
+	/**
+	 * \brief Add the pcs reachable from pc without reading anything
+	 */
+	void closure(std::uint32_t pc, bool at_begin, bool at_end);
+	std::int32_t intern();
+
+	const program& program_;
+	bool anchored_;
+
+	std::vector<state> states_;
+	std::unordered_map<std::vector<std::uint32_t>, std::int32_t, pcs_hash> ids_;
+	std::array<std::int32_t, 2> starts_;
+	std::size_t flushes_ = 0;
+
+	// the set being built, and which pcs are already in it
+	std::vector<std::uint32_t> building_;
+	std::vector<std::uint32_t> seen_;
+	std::uint32_t generation_ = 0;
+	std::vector<std::uint32_t> stack_;
+};
+
+}  // namespace tsccore::regex
@@ -0,0 +1,330 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "literals.hpp"
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include "alternative.hpp"
+#include "atom.hpp"
+#include "character_class.hpp"
+#include "disjunction.hpp"
+
+namespace tsccore::regex {
+
+namespace {
+
+using strings = std::vector<std::u32string>;
+
+// bounds that keep the analysis cheap, past them less is known
+constexpr std::size_t max_exact = 16;
+constexpr std::size_t max_length = 64;
+constexpr std::size_t max_factors = 16;
+constexpr std::size_t max_repeats = 8;
+constexpr std::size_t max_class_size = 4;
+
+/**
+ * \brief What is known about the text that part of a pattern matches
+ */
+struct info {
+	// every string it can match, when there are few enough to list
+	std::optional<strings> exact;
+
+	std::u32string prefix;
+	std::u32string suffix;
+	strings factors;
+};
+
+std::u32string common_prefix(const std::u32string& lhs,
+							 const std::u32string& rhs) {
+	auto [end, _] =
+		std::mismatch(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	return {lhs.begin(), end};
+}
+
+std::u32string common_suffix(const std::u32string& lhs,
+							 const std::u32string& rhs) {
+	auto [end, _] =
+		std::mismatch(lhs.rbegin(), lhs.rend(), rhs.rbegin(), rhs.rend());
+	return {end.base(), lhs.end()};
+}
+
+// a set of factors is only as good as its shortest string, which is also
+// what a search for it skips over
+std::size_t selectivity(const strings& factors) {
+	if (factors.empty())
+		return 0;
+
+	return std::ranges::min(factors, {}, &std::u32string::size).size();
+}
+
+void consider(strings& factors, strings candidate) {
+	auto current = selectivity(factors);
+	auto offered = selectivity(candidate);
+	if (offered > current ||
+		(offered == current && offered && candidate.size() < factors.size())) {
+		factors = std::move(candidate);
+	}
+}
+
+info unknown() {
+	return {};
+}
+
+info from_exact(strings exact) {
+	std::ranges::sort(exact);
+	auto duplicates = std::ranges::unique(exact);
+	exact.erase(duplicates.begin(), duplicates.end());
+
+	info result;
+	result.prefix = exact.front();
+	result.suffix = exact.front();
+	for (auto& text : exact) {
+		result.prefix = common_prefix(result.prefix, text);
+		result.suffix = common_suffix(result.suffix, text);
+	}
+
+	consider(result.factors, exact);
+	consider(result.factors, {result.prefix});
+	consider(result.factors, {result.suffix});
+	result.exact = std::move(exact);
+	return result;
+}
+
+info empty_string() {
+	return from_exact({std::u32string{}});
+}
+
+info concatenate(info first, const info& second) {
+	if (first.exact && second.exact &&
+		first.exact->size() * second.exact->size() <= max_exact) {
+		strings product;
+		for (auto& lhs : *first.exact) {
+			for (auto& rhs : *second.exact)
+				product.push_back(lhs + rhs);
+		}
+
+		if (std::ranges::all_of(product, [](const std::u32string& text) {
+				return text.size() <= max_length;
+			})) {
+			return from_exact(std::move(product));
+		}
+	}
+
+	info result;
+	if (first.exact && first.exact->size() == 1)
+		result.prefix = first.exact->front() + second.prefix;
+	else
+		result.prefix = std::move(first.prefix);
+
+	if (second.exact && second.exact->size() == 1)
+		result.suffix = first.suffix + second.exact->front();
+	else
+		result.suffix = second.suffix;
+
+	// long runs of literals would otherwise be copied once per character
+	if (result.prefix.size() > max_length)
+		result.prefix.resize(max_length);
+	if (result.suffix.size() > max_length)
+		result.suffix.erase(0, result.suffix.size() - max_length);
+
+	result.factors = std::move(first.factors);
+	consider(result.factors, second.factors);
+	consider(result.factors, {first.suffix + second.prefix});
+	consider(result.factors, {result.prefix});
+	consider(result.factors, {result.suffix});
+	return result;
+}
+
+info alternate(std::vector<info> alternatives) {
+	std::size_t total = 0;
+	for (auto& alternative : alternatives)
+		total += alternative.exact ? alternative.exact->size() : max_exact + 1;
+
+	if (total <= max_exact) {
+		strings all;
+		for (auto& alternative : alternatives)
+			all.insert(all.end(), alternative.exact->begin(),
+					   alternative.exact->end());
+		return from_exact(std::move(all));
+	}
+
+	info result;
+	result.prefix = alternatives.front().prefix;
+	result.suffix = alternatives.front().suffix;
+
+	// every match contains a factor of the alternative it went through
+	strings any;
+	bool known = true;
+	for (auto& alternative : alternatives) {
+		result.prefix = common_prefix(result.prefix, alternative.prefix);
+		result.suffix = common_suffix(result.suffix, alternative.suffix);
+
+		if (!selectivity(alternative.factors))
+			known = false;
+		any.insert(any.end(), alternative.factors.begin(),
+				   alternative.factors.end());
+	}
+
+	std::ranges::sort(any);
+	auto duplicates = std::ranges::unique(any);
+	any.erase(duplicates.begin(), duplicates.end());
+
+	if (known && any.size() <= max_factors)
+		consider(result.factors, std::move(any));
+	consider(result.factors, {result.prefix});
+	consider(result.factors, {result.suffix});
+	return result;
+}
+
+class analyzer {
+public:
+	explicit analyzer(match_flags flags)
+		: ignore_case_(has_flag(flags, match_flags::ignore_case)) {}
+
+	info analyze(const disjunction& value) const {
+		std::vector<info> alternatives;
+		for (auto& alternative : value.get_alternatives())
+			alternatives.push_back(analyze(alternative));
+
+		if (alternatives.empty())
+			return empty_string();
+		return alternate(std::move(alternatives));
+	}
+
+private:
+	info analyze(const alternative& value) const {
+		auto result = empty_string();
+		for (auto& term : value.get_terms())
+			result = concatenate(std::move(result), analyze(term));
+		return result;
+	}
+
+	info analyze(const term& value) const {
+		// assertions don't consume anything
+		if (value.is_assertion())
+			return empty_string();
+
+		auto body = analyze(value.get_atom());
+		auto& quantifier = value.get_quantifier();
+		if (!quantifier)
+			return body;
+
+		std::size_t min = 0;
+		std::size_t max = std::numeric_limits<std::size_t>::max();
+		if (quantifier->is_prefix()) {
+			switch (quantifier->get_prefix()) {
+				case quantifier::prefix::zero_or_more:
+					break;
+				case quantifier::prefix::one_or_more:
+					min = 1;
+					break;
+				case quantifier::prefix::zero_or_one:
+					max = 1;
+					break;
+			}
+		} else {
+			std::tie(min, max) = quantifier->get_range();
+		}
+
+		return repeat(body, min, max);
+	}
+
+	info analyze(const atom& value) const {
+		if (value.is_character()) {
+			auto ch = value.get_character();
+			if (ignore_case_ && (fold_case(ch) != ch || swap_case(ch) != ch))
+				return unknown();
+			return from_exact({std::u32string(1, ch)});
+		}
+
+		if (value.is_character_class())
+			return analyze(value.get_character_class());
+
+		if (value.is_group()) {
+			auto& inner = value.get_group();
+			switch (inner.get_type()) {
+				case group::type::capturing:
+				case group::type::non_capturing:
+					return analyze(inner.get_disjunction());
+				default:
+					// lookaround doesn't consume anything either
+					return empty_string();
+			}
+		}
+
+		return unknown();
+	}
+
+	info analyze(const character_class& value) const {
+		if (value.is_negated() || ignore_case_)
+			return unknown();
+
+		strings exact;
+		for (auto ch : value.get_characters())
+			exact.emplace_back(1, ch);
+		for (auto [first, last] : value.get_ranges()) {
+			if (last < first || last - first >= max_class_size)
+				return unknown();
+			for (char32_t offset = 0; offset <= last - first; ++offset)
+				exact.emplace_back(1, first + offset);
+		}
+
+		if (exact.empty() || exact.size() > max_class_size)
+			return unknown();
+		return from_exact(std::move(exact));
+	}
+
+	static info repeat(const info& body, std::size_t min, std::size_t max) {
+		if (max == 0)
+			return empty_string();
+
+		if (min == 0) {
+			if (max == 1 && body.exact)
+				return alternate({body, empty_string()});
+			return unknown();
+		}
+
+		auto result = body;
+		for (std::size_t i = 1; i < std::min(min, max_repeats); ++i)
+			result = concatenate(std::move(result), body);
+
+		// the repetitions that weren't written out could be anything
+		if (max > min || min > max_repeats)
+			result = concatenate(std::move(result), unknown());
+		return result;
+	}
+
+	bool ignore_case_;
+};
+
+}  // namespace
+
+required_literals find_required_literals(const regular_expression& expression,
+										 match_flags flags) {
+	auto found = analyzer(flags).analyze(expression.get_disjunction());
+
+	required_literals result;
+	result.prefix = std::move(found.prefix);
+	result.suffix = std::move(found.suffix);
+	if (selectivity(found.factors))
+		result.factors = std::move(found.factors);
+	return result;
+}
+
+}  // namespace tsccore::regex
@@ -0,0 +1,59 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "program.hpp"
+#include "regular_expression.hpp"
+
+namespace tsccore::regex {
+
+/**
+ * \brief Literal text that every match of a pattern is known to contain
+ *
+ * A matcher can look for these with a plain string search before running an
+ * engine: a match can't start before the next place the prefix appears, and
+ * there's no match at all in text that contains none of the factors.
+ */
+struct required_literals {
+	// every match starts with this
+	std::u32string prefix;
+
+	// every match ends with this
+	std::u32string suffix;
+
+	// every match contains at least one of these, empty when nothing is known
+	std::vector<std::u32string> factors;
+
+	bool empty() const noexcept {
+		return prefix.empty() && suffix.empty() && factors.empty();
+	}
+};
+
+/**
+ * \brief Work out the literals every match of the pattern has to contain
+ *
+ * With the i flag, letters that have another case aren't literal and end
+ * whatever literal they're in.
+ */
+required_literals find_required_literals(const regular_expression& expression,
+										 match_flags flags = match_flags::none);
+
+}  // namespace tsccore::regex
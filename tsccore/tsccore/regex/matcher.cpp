@@ -0,0 +1,122 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "matcher.hpp"
+#include <algorithm>
+#include <limits>
+#include "backtracker.hpp"
+#include "lazy_dfa.hpp"
+#include "pike_vm.hpp"
+#include "scan_regex.hpp"
+
+using namespace tsccore::regex;
+
+matcher::matcher(const regular_expression& expression, match_flags flags)
+	: program_(std::make_unique<program>(program::compile(expression, flags))),
+	  literals_(find_required_literals(expression, flags)) {}
+
+matcher::matcher(matcher&& other) noexcept = default;
+matcher& matcher::operator=(matcher&& other) noexcept = default;
+matcher::~matcher() = default;
+
+matcher matcher::compile(std::u32string_view pattern, match_flags flags) {
+	regular_expression expression;
+	scan(pattern, expression);
+	return matcher(expression, flags);
+}
+
+bool matcher::test(std::u32string_view input, std::size_t from) {
+	if (from > input.size())
+		return false;
+
+	if (!skip_ahead(input, from))
+		return false;
+
+	if (!program_->is_dfa_compatible())
+		return exec(input, from).has_value();
+
+	if (!dfa_) {
+		dfa_ = std::make_unique<lazy_dfa>(
+			*program_, has_flag(program_->flags(), match_flags::sticky));
+	}
+	return dfa_->search(input, from);
+}
+
+std::optional<match_result> matcher::exec(std::u32string_view input,
+										  std::size_t from) {
+	if (from > input.size())
+		return std::nullopt;
+
+	if (!skip_ahead(input, from))
+		return std::nullopt;
+
+	bool anchored = has_flag(program_->flags(), match_flags::sticky);
+	bool matched;
+	if (program_->needs_backtracking()) {
+		if (!backtracker_)
+			backtracker_ = std::make_unique<backtracker>(*program_);
+		matched = backtracker_->search(input, from, anchored, slots_);
+	} else {
+		if (!pike_vm_)
+			pike_vm_ = std::make_unique<pike_vm>(*program_);
+		matched = pike_vm_->search(input, from, anchored, slots_);
+	}
+
+	if (!matched)
+		return std::nullopt;
+
+	constexpr auto unset = std::numeric_limits<std::size_t>::max();
+
+	match_result result;
+	result.groups.resize(program_->group_count());
+	for (std::size_t i = 0; i < result.groups.size(); ++i) {
+		auto begin = slots_[i * 2];
+		auto end = slots_[i * 2 + 1];
+		if (begin != unset && end != unset)
+			result.groups[i].emplace(begin, end);
+	}
+
+	return result;
+}
+
+std::optional<std::size_t> matcher::group_number(
+	std::u32string_view name) const {
+	return program_->group_number(name);
+}
+
+bool matcher::skip_ahead(std::u32string_view input, std::size_t& from) const {
+	auto rest = input.substr(from);
+	if (!literals_.prefix.empty()) {
+		if (has_flag(program_->flags(), match_flags::sticky))
+			return rest.starts_with(literals_.prefix);
+
+		auto found = rest.find(literals_.prefix);
+		if (found == std::u32string_view::npos)
+			return false;
+
+		from += found;
+		rest.remove_prefix(found);
+	}
+
+	if (literals_.factors.empty())
+		return true;
+
+	return std::ranges::any_of(literals_.factors, [rest](const auto& factor) {
+		return rest.find(factor) != std::u32string_view::npos;
+	});
+}
@@ -0,0 +1,113 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "literals.hpp"
+#include "program.hpp"
+#include "regular_expression.hpp"
+
+namespace tsccore::regex {
+
+class backtracker;
+class lazy_dfa;
+class pike_vm;
+
+/**
+ * \brief Where a match and each of its capture groups were found
+ */
+struct match_result {
+	using span = std::pair<std::size_t, std::size_t>;
+
+	// group 0 is the whole match, groups that didn't take part are empty
+	std::vector<std::optional<span>> groups;
+
+	std::size_t position() const noexcept { return groups[0]->first; }
+	std::size_t end() const noexcept { return groups[0]->second; }
+};
+
+/**
+ * \brief Runs a compiled regular expression over UTF-32 text, like RegExp's
+ * test() and exec()
+ *
+ * The engine is picked from what the pattern uses. test() runs a lazy DFA
+ * when it can, exec() runs a Pike VM for captures, and both fall back to
+ * backtracking only for backreferences and lookbehind. Before any engine
+ * runs, the input is searched for the literals every match has to contain,
+ * which skips to where a match could start or rules one out entirely. Engines are made the
+ * first time they're needed and keep their buffers between calls, so a
+ * matcher must not be used from more than one thread at a time.
+ */
+class matcher {
+public:
+	explicit matcher(const regular_expression& expression,
+					 match_flags flags = match_flags::none);
+	matcher(matcher&& other) noexcept;
+	matcher& operator=(matcher&& other) noexcept;
+	~matcher();
+
+	/**
+	 * \brief Scan and compile a pattern
+	 */
+	static matcher compile(std::u32string_view pattern,
+						   match_flags flags = match_flags::none);
+
+	/**
+	 * \brief Whether there's a match that starts at or after from, or only at
+	 * from for a sticky pattern
+	 */
+	bool test(std::u32string_view input, std::size_t from = 0);
+
+	/**
+	 * \brief Find the leftmost match that starts at or after from, or only at
+	 * from for a sticky pattern
+	 */
+	std::optional<match_result> exec(std::u32string_view input,
+									 std::size_t from = 0);
+
+	/**
+	 * \brief Get the number of the group with the given name
+	 */
+	std::optional<std::size_t> group_number(std::u32string_view name) const;
+
+	const program& get_program() const noexcept { return *program_; }
+
+	const required_literals& literals() const noexcept { return literals_; }
+
+private:
+	/**
+	 * \brief Move from up to where the required prefix next appears, false
+	 * when the literals show there's no match
+	 */
+	bool skip_ahead(std::u32string_view input, std::size_t& from) const;
+
+	// engines refer to the program, so it stays put when the matcher moves
+	std::unique_ptr<program> program_;
+	required_literals literals_;
+	std::unique_ptr<lazy_dfa> dfa_;
+	std::unique_ptr<pike_vm> pike_vm_;
+	std::unique_ptr<backtracker> backtracker_;
+	std::vector<std::size_t> slots_;
+};
+
+}  // namespace tsccore::regex
@@ -0,0 +1,197 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pike_vm.hpp"
+#include <algorithm>
+#include <limits>
+
+using namespace tsccore::regex;
+
+namespace {
+constexpr std::size_t unset = std::numeric_limits<std::size_t>::max();
+constexpr std::uint32_t no_slot = std::numeric_limits<std::uint32_t>::max();
+}  // namespace
+
+pike_vm::pike_vm(const program& program)
+	: program_(program), slot_count_(program.slot_count()) {
+	auto size = program.instructions().size();
+	for (auto list : {&current_, &next_}) {
+		list->dense.resize(size);
+		list->sparse.resize(size);
+		list->slots.resize(size * slot_count_);
+	}
+	scratch_.resize(slot_count_);
+}
+
+pike_vm::~pike_vm() = default;
+
+bool pike_vm::search(std::u32string_view input,
+					 std::size_t from,
+					 bool anchored,
+					 std::vector<std::size_t>& slots,
+					 std::uint32_t start) {
+	auto instructions = program_.instructions();
+	current_.count = 0;
+	next_.count = 0;
+
+	bool matched = false;
+	for (auto position = from;; ++position) {
+		// a thread that starts here has a lower priority than all of the
+		// threads that started earlier
+		if (!matched && (!anchored || position == from)) {
+			std::fill(scratch_.begin(), scratch_.end(), unset);
+			add_thread(current_, start, input, position);
+		}
+
+		if (current_.count == 0)
+			break;
+
+		for (std::size_t i = 0; i < current_.count; ++i) {
+			auto pc = current_.dense[i];
+			auto& inst = instructions[pc];
+			auto thread_slots = current_.slots.data() + pc * slot_count_;
+
+			if (inst.op == program::opcode::match) {
+				// the threads after this one have a lower priority
+				matched = true;
+				slots.assign(thread_slots, thread_slots + slot_count_);
+				break;
+			}
+
+			// the list also holds the pcs that were passed through on the
+			// way, only the ones that read a character go on
+			if (inst.op != program::opcode::character &&
+				inst.op != program::opcode::any_of)
+				continue;
+
+			if (position < input.size() &&
+				program_.accepts(inst, input[position])) {
+				std::copy_n(thread_slots, slot_count_, scratch_.begin());
+				add_thread(next_, pc + 1, input, position + 1);
+			}
+		}
+
+		if (position >= input.size())
+			break;
+
+		std::swap(current_, next_);
+		next_.count = 0;
+	}
+
+	return matched;
+}
+
+void pike_vm::add_thread(thread_list& list,
+						 std::uint32_t pc,
+						 std::u32string_view input,
+						 std::size_t position) {
+	using opcode = program::opcode;
+
+	auto instructions = program_.instructions();
+	stack_.push_back({pc, no_slot, 0});
+
+	auto set_slot = [this](std::uint32_t slot, std::size_t value) {
+		stack_.push_back({0, slot, scratch_[slot]});
+		scratch_[slot] = value;
+	};
+
+	while (!stack_.empty()) {
+		auto top = stack_.back();
+		stack_.pop_back();
+
+		if (top.slot != no_slot) {
+			scratch_[top.slot] = top.value;
+			continue;
+		}
+
+		pc = top.pc;
+		if (list.contains(pc))
+			continue;
+
+		list.sparse[pc] = static_cast<std::uint32_t>(list.count);
+		list.dense[list.count++] = pc;
+
+		auto& inst = instructions[pc];
+		switch (inst.op) {
+			case opcode::jump:
+				stack_.push_back({inst.x, no_slot, 0});
+				break;
+			case opcode::split:
+				stack_.push_back({inst.y, no_slot, 0});
+				stack_.push_back({inst.x, no_slot, 0});
+				break;
+			case opcode::save:
+			case opcode::mark:
+				set_slot(inst.x, position);
+				stack_.push_back({pc + 1, no_slot, 0});
+				break;
+			case opcode::reset:
+				for (auto group = inst.x; group <= inst.y; ++group) {
+					set_slot(group * 2, unset);
+					set_slot(group * 2 + 1, unset);
+				}
+				stack_.push_back({pc + 1, no_slot, 0});
+				break;
+			case opcode::check_progress:
+				if (scratch_[inst.x] != position)
+					stack_.push_back({pc + 1, no_slot, 0});
+				break;
+			case opcode::line_start:
+			case opcode::line_end:
+			case opcode::word_boundary:
+			case opcode::non_word_boundary:
+				if (program_.holds(inst, input, position))
+					stack_.push_back({pc + 1, no_slot, 0});
+				break;
+			case opcode::lookaround: {
+				auto& lookaround = program_.get_lookaround(inst.x);
+				if (!nested_)
+					nested_ = std::make_unique<pike_vm>(program_);
+
+				std::vector<std::size_t> found;
+				bool matched = nested_->search(input, position, true, found,
+											   lookaround.start);
+
+				if (lookaround.type != group::type::positive_lookahead) {
+					if (!matched)
+						stack_.push_back({pc + 1, no_slot, 0});
+					break;
+				}
+
+				if (!matched)
+					break;
+
+				// groups captured inside a positive lookahead are kept
+				for (std::uint32_t slot = 0; slot < program_.group_count() * 2;
+					 ++slot) {
+					if (found[slot] != unset)
+						set_slot(slot, found[slot]);
+				}
+				stack_.push_back({pc + 1, no_slot, 0});
+				break;
+			}
+			case opcode::backreference:
+				// not supported here, the matcher uses the backtracker
+				stack_.push_back({pc + 1, no_slot, 0});
+				break;
+			default:
+				std::copy(scratch_.begin(), scratch_.end(),
+						  list.slots.begin() + pc * slot_count_);
+		}
+	}
+}
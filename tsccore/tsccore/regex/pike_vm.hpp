@@ -0,0 +1,92 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "program.hpp"
+
+namespace tsccore::regex {
+
+/**
+ * \brief Runs a program by stepping every thread over the input at once
+ *
+ * Threads are kept in priority order and a thread that reaches a pc another
+ * thread already holds is dropped, so the work for each character is bounded
+ * by the size of the program and matching takes time linear in the input.
+ * Lookahead is run as a nested match. Backreferences and lookbehind aren't
+ * supported, see backtracker for those.
+ */
+class pike_vm {
+public:
+	explicit pike_vm(const program& program);
+	~pike_vm();
+
+	/**
+	 * \brief Find the leftmost match that starts at or after from
+	 * \param anchored Only try a match that starts at from
+	 * \param slots Filled with the capture slots of the match
+	 * \param start The pc to start at
+	 */
+	bool search(std::u32string_view input,
+				std::size_t from,
+				bool anchored,
+				std::vector<std::size_t>& slots,
+				std::uint32_t start = program::start);
+
+private:
+	struct thread_list {
+		std::vector<std::uint32_t> dense;
+		std::vector<std::uint32_t> sparse;
+		std::vector<std::size_t> slots;
+		std::size_t count = 0;
+
+		bool contains(std::uint32_t pc) const noexcept {
+			auto index = sparse[pc];
+			return index < count && dense[index] == pc;
+		}
+	};
+
+	// either a pc to follow, or a slot to put back once the threads after
+	// it have been added
+	struct entry {
+		std::uint32_t pc;
+		std::uint32_t slot;
+		std::size_t value;
+	};
+
+	void add_thread(thread_list& list,
+					std::uint32_t pc,
+					std::u32string_view input,
+					std::size_t position);
+
+	const program& program_;
+	std::size_t slot_count_;
+	thread_list current_;
+	thread_list next_;
+	std::vector<std::size_t> scratch_;
+	std::vector<entry> stack_;
+
+	// for lookahead, made when it's first needed
+	std::unique_ptr<pike_vm> nested_;
+};
+
+}  // namespace tsccore::regex
@@ -0,0 +1,524 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "program.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include "alternative.hpp"
+#include "atom.hpp"
+#include "character_class.hpp"
+#include "disjunction.hpp"
+
+namespace tsccore::regex {
+
+namespace {
+
+constexpr std::size_t unbounded = std::numeric_limits<std::size_t>::max();
+
+// counted repetitions are expanded into copies of their atom, which is
+// where a program could grow without bound
+constexpr std::size_t max_instructions = std::size_t{1} << 20;
+
+void normalize(std::vector<std::pair<char32_t, char32_t>>& ranges) {
+	std::sort(ranges.begin(), ranges.end());
+
+	std::size_t kept = 0;
+	for (auto& range : ranges) {
+		if (kept && range.first <= ranges[kept - 1].second + 1) {
+			ranges[kept - 1].second =
+				std::max(ranges[kept - 1].second, range.second);
+		} else {
+			ranges[kept++] = range;
+		}
+	}
+	ranges.resize(kept);
+}
+
+}  // namespace
+
+char32_t fold_case(char32_t ch) noexcept {
+	if (ch >= U'A' && ch <= U'Z')
+		return ch + 32;
+	if (ch < 0xc0)
+		return ch;
+	if (ch <= 0xde && ch != 0xd7)
+		return ch + 32;
+	if (ch >= 0x391 && ch <= 0x3a9 && ch != 0x3a2)
+		return ch + 32;
+	if (ch >= 0x400 && ch <= 0x40f)
+		return ch + 80;
+	if (ch >= 0x410 && ch <= 0x42f)
+		return ch + 32;
+	return ch;
+}
+
+char32_t swap_case(char32_t ch) noexcept {
+	if (ch >= U'a' && ch <= U'z')
+		return ch - 32;
+	if (ch >= 0xe0 && ch <= 0xfe && ch != 0xf7)
+		return ch - 32;
+	if (ch >= 0x3b1 && ch <= 0x3c9 && ch != 0x3c2)
+		return ch - 32;
+	if (ch >= 0x430 && ch <= 0x44f)
+		return ch - 32;
+	if (ch >= 0x450 && ch <= 0x45f)
+		return ch - 80;
+	return fold_case(ch);
+}
+
+bool program::char_set::contains(char32_t ch) const noexcept {
+	auto after = std::upper_bound(
+		ranges.begin(), ranges.end(), ch,
+		[](char32_t value, const auto& range) { return value < range.first; });
+	return after != ranges.begin() && ch <= std::prev(after)->second;
+}
+
+std::optional<std::size_t> program::group_number(
+	std::u32string_view name) const {
+	for (std::size_t i = 1; i < names_.size(); ++i) {
+		if (names_[i] && *names_[i] == name)
+			return i;
+	}
+	return std::nullopt;
+}
+
+bool program::holds(const instruction& inst,
+					std::u32string_view input,
+					std::size_t position) const noexcept {
+	bool multiline = has_flag(flags_, match_flags::multiline);
+	switch (inst.op) {
+		case opcode::line_start:
+			return position == 0 ||
+				   (multiline && is_line_terminator(input[position - 1]));
+		case opcode::line_end:
+			return position == input.size() ||
+				   (multiline && is_line_terminator(input[position]));
+		case opcode::word_boundary:
+		case opcode::non_word_boundary: {
+			bool before =
+				position > 0 && is_word_character(input[position - 1]);
+			bool after = position < input.size() &&
+						 is_word_character(input[position]);
+			return (before != after) == (inst.op == opcode::word_boundary);
+		}
+		default:
+			return true;
+	}
+}
+
+/**
+ * \brief Turns the tree of a regular expression into a program
+ */
+class compiler {
+public:
+	compiler(program& into, match_flags flags) : into_(into) {
+		into_.flags_ = flags;
+		into_.ignore_case_ = has_flag(flags, match_flags::ignore_case);
+	}
+
+	void compile(const regular_expression& expression) {
+		into_.names_.emplace_back();
+		number_groups(expression.get_disjunction());
+
+		emit(program::opcode::save, 0);
+		compile(expression.get_disjunction());
+		emit(program::opcode::save, 1);
+		emit(program::opcode::match);
+
+		// lookaround bodies can queue more of their own
+		for (std::size_t i = 0; i < pending_.size(); ++i) {
+			auto [index, body] = pending_[i];
+			into_.lookarounds_[index].start = size();
+			compile(*body);
+			emit(program::opcode::match);
+		}
+
+		into_.slot_count_ = into_.names_.size() * 2 + marks_;
+	}
+
+private:
+	using opcode = program::opcode;
+
+	std::uint32_t size() const noexcept {
+		return static_cast<std::uint32_t>(into_.instructions_.size());
+	}
+
+	std::uint32_t emit(opcode op, std::uint32_t x = 0, std::uint32_t y = 0) {
+		if (into_.instructions_.size() >= max_instructions)
+			throw std::length_error("regular expression is too large");
+
+		into_.instructions_.push_back({op, x, y});
+		return size() - 1;
+	}
+
+	program::instruction& at(std::uint32_t pc) noexcept {
+		return into_.instructions_[pc];
+	}
+
+	// groups are numbered by the order of their opening parentheses, which
+	// isn't the order lookaround bodies are compiled in
+	void number_groups(const disjunction& value) {
+		for (auto& alternative : value.get_alternatives()) {
+			for (auto& term : alternative.get_terms()) {
+				if (term.is_assertion() || !term.get_atom().is_group())
+					continue;
+
+				auto& group = term.get_atom().get_group();
+				if (group.get_type() == group::type::capturing) {
+					numbers_[&group] =
+						static_cast<std::uint32_t>(into_.names_.size());
+					into_.names_.push_back(group.get_name());
+				}
+				number_groups(group.get_disjunction());
+			}
+		}
+	}
+
+	// the first and last capturing groups inside a disjunction, which are
+	// numbered consecutively
+	void group_range(const disjunction& value,
+					 std::uint32_t& first,
+					 std::uint32_t& last) const {
+		for (auto& alternative : value.get_alternatives()) {
+			for (auto& term : alternative.get_terms()) {
+				if (term.is_assertion() || !term.get_atom().is_group())
+					continue;
+
+				auto& group = term.get_atom().get_group();
+				auto found = numbers_.find(&group);
+				if (found != numbers_.end()) {
+					first = std::min(first, found->second);
+					last = std::max(last, found->second);
+				}
+				group_range(group.get_disjunction(), first, last);
+			}
+		}
+	}
+
+	static bool can_be_empty(const term& value) {
+		if (value.is_assertion())
+			return true;
+
+		auto& quantifier = value.get_quantifier();
+		if (quantifier) {
+			bool optional =
+				quantifier->is_prefix()
+					? quantifier->get_prefix() != quantifier::prefix::one_or_more
+					: quantifier->get_range().first == 0;
+			if (optional)
+				return true;
+		}
+
+		return can_be_empty(value.get_atom());
+	}
+
+	static bool can_be_empty(const disjunction& value) {
+		auto alternatives = value.get_alternatives();
+		if (alternatives.empty())
+			return true;
+
+		return std::any_of(
+			alternatives.begin(), alternatives.end(), [](auto& alternative) {
+				auto& terms = alternative.get_terms();
+				return std::all_of(terms.begin(), terms.end(), [](auto& term) {
+					return can_be_empty(term);
+				});
+			});
+	}
+
+	static bool can_be_empty(const atom& value) {
+		if (value.is_backreference())
+			return true;
+		if (!value.is_group())
+			return false;
+
+		// lookarounds never consume anything
+		auto type = value.get_group().get_type();
+		if (type != group::type::capturing && type != group::type::non_capturing)
+			return true;
+
+		return can_be_empty(value.get_group().get_disjunction());
+	}
+
+	void compile(const disjunction& value) {
+		auto alternatives = value.get_alternatives();
+		std::vector<std::uint32_t> exits;
+		for (std::size_t i = 0; i < alternatives.size(); ++i) {
+			bool last = i + 1 == alternatives.size();
+			std::uint32_t split = 0;
+			if (!last)
+				split = emit(opcode::split, size() + 1);
+
+			compile(alternatives[i]);
+
+			if (!last) {
+				exits.push_back(emit(opcode::jump));
+				at(split).y = size();
+			}
+		}
+
+		for (auto exit : exits)
+			at(exit).x = size();
+	}
+
+	void compile(const alternative& value) {
+		for (auto& term : value.get_terms())
+			compile(term);
+	}
+
+	void compile(const term& value) {
+		if (value.is_assertion()) {
+			compile(value.get_assertion());
+			return;
+		}
+
+		auto& quantifier = value.get_quantifier();
+		if (!quantifier) {
+			compile(value.get_atom());
+			return;
+		}
+
+		std::size_t min = 0;
+		std::size_t max = unbounded;
+		if (quantifier->is_prefix()) {
+			switch (quantifier->get_prefix()) {
+				case quantifier::prefix::zero_or_more:
+					break;
+				case quantifier::prefix::one_or_more:
+					min = 1;
+					break;
+				case quantifier::prefix::zero_or_one:
+					max = 1;
+					break;
+			}
+		} else {
+			std::tie(min, max) = quantifier->get_range();
+		}
+
+		compile_repeat(value.get_atom(), min, max, quantifier->is_greedy());
+	}
+
+	void compile(const assertion& value) {
+		// the DFA only knows whether it's at either end of the input
+		bool needs_context = has_flag(into_.flags_, match_flags::multiline);
+		switch (value.get_type()) {
+			case assertion::type::start_of_line:
+				emit(opcode::line_start);
+				break;
+			case assertion::type::end_of_line:
+				emit(opcode::line_end);
+				break;
+			case assertion::type::word_boundary:
+				emit(opcode::word_boundary);
+				needs_context = true;
+				break;
+			case assertion::type::non_word_boundary:
+				emit(opcode::non_word_boundary);
+				needs_context = true;
+				break;
+		}
+
+		if (needs_context)
+			into_.dfa_compatible_ = false;
+	}
+
+	void compile_repeat(const atom& value,
+						std::size_t min,
+						std::size_t max,
+						bool greedy) {
+		// captures inside the atom start over with each repetition
+		std::uint32_t first = std::numeric_limits<std::uint32_t>::max();
+		std::uint32_t last = 0;
+		if (value.is_group()) {
+			auto found = numbers_.find(&value.get_group());
+			if (found != numbers_.end())
+				first = last = found->second;
+			group_range(value.get_group().get_disjunction(), first, last);
+		}
+
+		auto body = [&] {
+			if (first <= last)
+				emit(opcode::reset, first, last);
+			compile(value);
+		};
+
+		for (std::size_t i = 0; i < min; ++i)
+			body();
+
+		if (max == unbounded) {
+			auto loop = emit(opcode::split);
+
+			// an iteration that matches nothing ends the loop, otherwise
+			// (a*)* would spin forever
+			bool check = can_be_empty(value);
+			std::uint32_t slot = 0;
+			if (check) {
+				slot = static_cast<std::uint32_t>(into_.names_.size() * 2 +
+												  marks_++);
+				emit(opcode::mark, slot);
+			}
+
+			body();
+			if (check)
+				emit(opcode::check_progress, slot);
+			emit(opcode::jump, loop);
+
+			branch(loop, loop + 1, size(), greedy);
+			return;
+		}
+
+		std::vector<std::uint32_t> splits;
+		for (std::size_t i = min; i < max; ++i) {
+			splits.push_back(emit(opcode::split));
+			body();
+		}
+
+		for (auto split : splits)
+			branch(split, split + 1, size(), greedy);
+	}
+
+	void branch(std::uint32_t split,
+				std::uint32_t repeat,
+				std::uint32_t skip,
+				bool greedy) {
+		at(split).x = greedy ? repeat : skip;
+		at(split).y = greedy ? skip : repeat;
+	}
+
+	std::uint32_t add_set(program::char_set set) {
+		normalize(set.ranges);
+		into_.sets_.push_back(std::move(set));
+		return static_cast<std::uint32_t>(into_.sets_.size() - 1);
+	}
+
+	std::uint32_t builtin_set(atom::builtin_class value) {
+		auto found = builtins_.find(value);
+		if (found != builtins_.end())
+			return found->second;
+
+		program::char_set set;
+		switch (value) {
+			case atom::builtin_class::dot:
+				if (has_flag(into_.flags_, match_flags::dot_all)) {
+					set.ranges = {{0, 0x10ffff}};
+				} else {
+					set.ranges = {{U'\n', U'\n'},
+								  {U'\r', U'\r'},
+								  {0x2028, 0x2029}};
+					set.negated = true;
+				}
+				break;
+			case atom::builtin_class::non_word:
+				set.negated = true;
+				[[fallthrough]];
+			case atom::builtin_class::word:
+				set.ranges = {
+					{U'0', U'9'}, {U'A', U'Z'}, {U'_', U'_'}, {U'a', U'z'}};
+				break;
+			case atom::builtin_class::non_digit:
+				set.negated = true;
+				[[fallthrough]];
+			case atom::builtin_class::digit:
+				set.ranges = {{U'0', U'9'}};
+				break;
+			case atom::builtin_class::non_whitespace:
+				set.negated = true;
+				[[fallthrough]];
+			case atom::builtin_class::whitespace:
+				set.ranges = {{0x9, 0xd},		{0x20, 0x20},
+							  {0xa0, 0xa0},		{0x1680, 0x1680},
+							  {0x2000, 0x200a}, {0x2028, 0x2029},
+							  {0x202f, 0x202f}, {0x205f, 0x205f},
+							  {0x3000, 0x3000}, {0xfeff, 0xfeff}};
+				break;
+		}
+
+		auto index = add_set(std::move(set));
+		builtins_.emplace(value, index);
+		return index;
+	}
+
+	void compile(const atom& value) {
+		if (value.is_character()) {
+			auto ch = value.get_character();
+			emit(opcode::character, into_.ignore_case_ ? fold_case(ch) : ch);
+		} else if (value.is_builtin_class()) {
+			emit(opcode::any_of, builtin_set(value.get_builtin_class()));
+		} else if (value.is_character_class()) {
+			auto& source = value.get_character_class();
+			program::char_set set;
+			set.negated = source.is_negated();
+			for (auto ch : source.get_characters())
+				set.ranges.emplace_back(ch, ch);
+			for (auto& range : source.get_ranges())
+				set.ranges.push_back(range);
+			emit(opcode::any_of, add_set(std::move(set)));
+		} else if (value.is_backreference()) {
+			emit(opcode::backreference,
+				 static_cast<std::uint32_t>(value.get_backreference().number));
+			into_.needs_backtracking_ = true;
+			into_.dfa_compatible_ = false;
+		} else {
+			compile(value.get_group());
+		}
+	}
+
+	void compile(const group& value) {
+		switch (value.get_type()) {
+			case group::type::capturing: {
+				auto number = numbers_.at(&value);
+				emit(opcode::save, number * 2);
+				compile(value.get_disjunction());
+				emit(opcode::save, number * 2 + 1);
+				break;
+			}
+			case group::type::non_capturing:
+				compile(value.get_disjunction());
+				break;
+			case group::type::positive_lookbehind:
+			case group::type::negative_lookbehind:
+				into_.needs_backtracking_ = true;
+				[[fallthrough]];
+			default: {
+				auto index =
+					static_cast<std::uint32_t>(into_.lookarounds_.size());
+				into_.lookarounds_.push_back({value.get_type(), 0});
+				pending_.emplace_back(index, &value.get_disjunction());
+				emit(opcode::lookaround, index);
+				into_.dfa_compatible_ = false;
+			}
+		}
+	}
+
+	program& into_;
+	std::unordered_map<const group*, std::uint32_t> numbers_;
+	std::unordered_map<atom::builtin_class, std::uint32_t> builtins_;
+	std::vector<std::pair<std::uint32_t, const disjunction*>> pending_;
+	std::uint32_t marks_ = 0;
+};
+
+program program::compile(const regular_expression& expression,
+						 match_flags flags) {
+	program result;
+	compiler(result, flags).compile(expression);
+	return result;
+}
+
+}  // namespace tsccore::regex
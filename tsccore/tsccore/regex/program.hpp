@@ -0,0 +1,230 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "group.hpp"
+#include "regular_expression.hpp"
+
+namespace tsccore::regex {
+
+enum class match_flags : std::uint8_t {
+	none = 0,
+	ignore_case = 1 << 0,
+	multiline = 1 << 1,
+	dot_all = 1 << 2,
+	unicode = 1 << 3,
+	sticky = 1 << 4
+};
+
+constexpr match_flags operator|(match_flags lhs, match_flags rhs) noexcept {
+	return static_cast<match_flags>(static_cast<std::uint8_t>(lhs) |
+									static_cast<std::uint8_t>(rhs));
+}
+
+constexpr match_flags operator&(match_flags lhs, match_flags rhs) noexcept {
+	return static_cast<match_flags>(static_cast<std::uint8_t>(lhs) &
+									static_cast<std::uint8_t>(rhs));
+}
+
+constexpr bool has_flag(match_flags value, match_flags flag) noexcept {
+	return (value & flag) == flag;
+}
+
+/**
+ * \brief The simple case folding used by the i flag
+ *
+ * Letters fold to lower case. This covers ASCII, Latin-1, Greek and Cyrillic,
+ * other characters are left alone.
+ */
+char32_t fold_case(char32_t ch) noexcept;
+
+/**
+ * \brief The other case of a letter that fold_case() knows about, or the
+ * character itself
+ */
+char32_t swap_case(char32_t ch) noexcept;
+
+/**
+ * \brief A regular expression compiled to instructions for a matching engine
+ *
+ * The instructions are those of a Thompson NFA: consuming instructions that
+ * test one character, and splits, jumps and assertions that don't consume
+ * anything. Capture group n is recorded in slots 2n and 2n + 1, with group 0
+ * being the whole match. Lookaround bodies are compiled after the main
+ * program, each ending in its own match instruction.
+ */
+class program {
+public:
+	enum class opcode : std::uint8_t {
+		character,			// x is the character, folded for the i flag
+		any_of,				// x is the index of a char_set
+		split,				// try x, then y
+		jump,				// continue at x
+		save,				// record the position in slot x
+		line_start,			// ^
+		line_end,			// $
+		word_boundary,		// \b
+		non_word_boundary,	// \B
+		backreference,		// x is the group number
+		lookaround,			// x is the index of a lookaround
+		reset,				// forget groups x to y
+		mark,				// record the position in slot x
+		check_progress,		// fail unless the position moved past slot x
+		match
+	};
+
+	struct instruction {
+		opcode op;
+		std::uint32_t x = 0;
+		std::uint32_t y = 0;
+	};
+
+	/**
+	 * \brief A set of characters as sorted, disjoint ranges
+	 */
+	struct char_set {
+		std::vector<std::pair<char32_t, char32_t>> ranges;
+		bool negated = false;
+
+		/**
+		 * \brief Whether the character is in one of the ranges, ignoring
+		 * negated
+		 */
+		bool contains(char32_t ch) const noexcept;
+	};
+
+	struct lookaround {
+		group::type type;
+		std::uint32_t start;
+	};
+
+	/**
+	 * \brief Compile a parsed pattern
+	 *
+	 * Throws std::length_error when counted repetitions would make the
+	 * program unreasonably large.
+	 */
+	static program compile(const regular_expression& expression,
+						   match_flags flags = match_flags::none);
+
+	std::span<const instruction> instructions() const noexcept {
+		return instructions_;
+	}
+
+	const char_set& get_set(std::uint32_t index) const noexcept {
+		return sets_[index];
+	}
+
+	const lookaround& get_lookaround(std::uint32_t index) const noexcept {
+		return lookarounds_[index];
+	}
+
+	match_flags flags() const noexcept { return flags_; }
+
+	/**
+	 * \brief The number of capture groups, counting the whole match
+	 */
+	std::size_t group_count() const noexcept { return names_.size(); }
+
+	/**
+	 * \brief The number of slots a thread needs: two per group and one for
+	 * each loop that checks for progress
+	 */
+	std::size_t slot_count() const noexcept { return slot_count_; }
+
+	/**
+	 * \brief Get the number of the group with the given name
+	 */
+	std::optional<std::size_t> group_number(std::u32string_view name) const;
+
+	/**
+	 * \brief Whether the program uses backreferences or lookbehind, which
+	 * only the backtracking engine runs
+	 */
+	bool needs_backtracking() const noexcept { return needs_backtracking_; }
+
+	/**
+	 * \brief Whether a DFA can run the program: nothing but characters,
+	 * splits and anchors that only look at the ends of the input
+	 */
+	bool is_dfa_compatible() const noexcept { return dfa_compatible_; }
+
+	/**
+	 * \brief Whether a consuming instruction accepts the character
+	 */
+	bool accepts(const instruction& inst, char32_t ch) const noexcept {
+		if (inst.op == opcode::character) {
+			return inst.x == ch ||
+				   (ignore_case_ && inst.x == fold_case(ch));
+		}
+
+		auto& set = sets_[inst.x];
+		bool found = set.contains(ch) ||
+					 (ignore_case_ && set.contains(swap_case(ch)));
+		return found != set.negated;
+	}
+
+	/**
+	 * \brief Whether an assertion holds at the position
+	 */
+	bool holds(const instruction& inst,
+			   std::u32string_view input,
+			   std::size_t position) const noexcept;
+
+	static constexpr std::uint32_t start = 0;
+
+private:
+	friend class compiler;
+
+	std::vector<instruction> instructions_;
+	std::vector<char_set> sets_;
+	std::vector<lookaround> lookarounds_;
+	std::vector<std::optional<std::u32string>> names_;
+	std::size_t slot_count_ = 0;
+	match_flags flags_ = match_flags::none;
+	bool ignore_case_ = false;
+	bool needs_backtracking_ = false;
+	bool dfa_compatible_ = true;
+};
+
+/**
+ * \brief Whether a character is one of the line terminators ^ and $ stop at
+ * in multiline mode
+ */
+constexpr bool is_line_terminator(char32_t ch) noexcept {
+	return ch == U'\n' || ch == U'\r' || ch == U'\u2028' ||
+		   ch == U'\u2029';
+}
+
+/**
+ * \brief Whether a character is part of a word for \b and \w
+ */
+constexpr bool is_word_character(char32_t ch) noexcept {
+	return (ch >= U'a' && ch <= U'z') || (ch >= U'A' && ch <= U'Z') ||
+		   (ch >= U'0' && ch <= U'9') || ch == U'_';
+}
+
+}  // namespace tsccore::regex
@@ -55,10 +55,12 @@ void append_number(std::u32string& to, std::size_t value) {
 
 }  // namespace
 
-quantifier::quantifier(prefix prefix_type) : value_(prefix_type) {}
+quantifier::quantifier(prefix prefix_type, bool greedy)
+	: value_(prefix_type), greedy_(greedy) {}
 
-quantifier::quantifier(std::pair<std::size_t, std::size_t> min_max)
-	: value_(min_max) {}
+quantifier::quantifier(std::pair<std::size_t, std::size_t> min_max,
+					   bool greedy)
+	: value_(min_max), greedy_(greedy) {}
 
 bool quantifier::is_prefix() const {
 	return std::holds_alternative<prefix>(value_);
@@ -68,6 +70,10 @@ bool quantifier::is_range() const {
 	return std::holds_alternative<min_max_length>(value_);
 }
 
+bool quantifier::is_greedy() const {
+	return greedy_;
+}
+
 quantifier::prefix quantifier::get_prefix() const {
 	return std::get<prefix>(value_);
 }
@@ -77,19 +83,20 @@ const std::pair<std::size_t, std::size_t>& quantifier::get_range() const {
 }
 
 std::size_t quantifier::string_size() const noexcept {
+	std::size_t lazy = greedy_ ? 0 : 1;
 	if (is_prefix()) {
-		return 1;
+		return 1 + lazy;
 	} else {
 		const auto& range = get_range();
 		std::size_t digits_min = count_digits(range.first);
 
 		if (range.second == std::numeric_limits<std::size_t>::max()) {
-			return 1 + digits_min + 2;
+			return 1 + digits_min + 2 + lazy;
 		} else if (range.first == range.second) {
-			return 1 + digits_min + 1;
+			return 1 + digits_min + 1 + lazy;
 		} else {
 			std::size_t digits_max = count_digits(range.second);
-			return 1 + digits_min + 1 + digits_max + 1;
+			return 1 + digits_min + 1 + digits_max + 1 + lazy;
 		}
 	}
 }
@@ -111,10 +118,13 @@ void quantifier::to_string(std::u32string& to) const {
 		}
 		to += U'}';
 	}
+
+	if (!greedy_)
+		to += U'?';
 }
 
 bool quantifier::operator==(const quantifier& other) const noexcept {
-	return value_ == other.value_;
+	return value_ == other.value_ && greedy_ == other.greedy_;
 }
 
 bool quantifier::operator!=(const quantifier& other) const noexcept {
@@ -31,12 +31,19 @@ public:
 		zero_or_one = '?'
 	};
 
-	explicit quantifier(prefix prefix_type);
-	explicit quantifier(std::pair<std::size_t, std::size_t> min_max);
+	explicit quantifier(prefix prefix_type, bool greedy = true);
+	explicit quantifier(std::pair<std::size_t, std::size_t> min_max,
+						bool greedy = true);
 
 	bool is_prefix() const;
 	bool is_range() const;
 
+	/**
+	 * \brief Whether as many repetitions as possible are tried first, false
+	 * for a lazy quantifier that's followed by '?'
+	 */
+	bool is_greedy() const;
+
 	prefix get_prefix() const;
 	const std::pair<std::size_t, std::size_t>& get_range() const;
 
@@ -49,6 +56,7 @@ public:
 private:
 	using min_max_length = std::pair<std::size_t, std::size_t>;
 	std::variant<prefix, min_max_length> value_;
+	bool greedy_;
 };
 
 }  // namespace tsccore::regex
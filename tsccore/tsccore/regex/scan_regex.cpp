@@ -304,6 +304,23 @@ atom scan_atom(const std::u32string_view& input, size_t& pos) {
 				case U'S':
 					++pos;
 					return atom::builtin_class::non_whitespace;
+				case U'1':
+				case U'2':
+				case U'3':
+				case U'4':
+				case U'5':
+				case U'6':
+				case U'7':
+				case U'8':
+				case U'9': {
+					std::size_t number = 0;
+					while (std::iswdigit(current_char(input, pos)) &&
+						   !at_end(input, pos)) {
+						number = number * 10 + (current_char(input, pos) - U'0');
+						++pos;
+					}
+					return atom::backreference{number};
+				}
 				case U'b':
 				case U'B':
 					// These should be handled as assertions, not atoms
@@ -340,18 +357,30 @@ assertion scan_assertion(const std::u32string_view& input, size_t& pos) {
 	}
 }
 
+// a '?' after a quantifier makes it lazy
+bool scan_greedy(const std::u32string_view& input, size_t& pos) noexcept {
+	if (current_char(input, pos) != U'?')
+		return true;
+
+	++pos;
+	return false;
+}
+
 std::optional<quantifier> scan_quantifier(const std::u32string_view& input,
 										  size_t& pos) {
 	switch (current_char(input, pos)) {
 		case U'*':
 			++pos;
-			return quantifier{quantifier::prefix::zero_or_more};
+			return quantifier{quantifier::prefix::zero_or_more,
+							  scan_greedy(input, pos)};
 		case U'+':
 			++pos;
-			return quantifier{quantifier::prefix::one_or_more};
+			return quantifier{quantifier::prefix::one_or_more,
+							  scan_greedy(input, pos)};
 		case U'?':
 			++pos;
-			return quantifier{quantifier::prefix::zero_or_one};
+			return quantifier{quantifier::prefix::zero_or_one,
+							  scan_greedy(input, pos)};
 		case U'{': {
 			++pos;	// skip '{'
 
@@ -388,7 +417,7 @@ std::optional<quantifier> scan_quantifier(const std::u32string_view& input,
 
 			++pos;	// skip '}'
 
-			return quantifier(std::make_pair(min, max));
+			return quantifier(std::make_pair(min, max), scan_greedy(input, pos));
 		}
 		default:
 			return std::nullopt;
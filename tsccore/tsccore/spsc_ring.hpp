@@ -0,0 +1,143 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+namespace tscc {
+
+/**
+ * \brief A bounded ring of slots passed from one thread to another
+ *
+ * One producer thread fills slots and one consumer thread reads them, with
+ * no locks between them. The slots are constructed once and handed back to
+ * the producer when the consumer is done with them, so the producer can
+ * reuse whatever they own (such as a token's string) instead of allocating.
+ *
+ * Waiting on a full or empty ring spins and then yields, since both sides
+ * are expected to be busy for as long as the ring is in use.
+ */
+template <typename T>
+class spsc_ring {
+	// keep the two sides' indices on separate cache lines
+	static constexpr std::size_t line_size = 64;
+
+public:
+	/**
+	 * \brief Make a ring with at least the given number of slots
+	 */
+	explicit spsc_ring(std::size_t capacity)
+		: capacity_(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity)),
+		  slots_(std::make_unique<T[]>(capacity_)) {}
+
+	spsc_ring(const spsc_ring&) = delete;
+	spsc_ring& operator=(const spsc_ring&) = delete;
+
+	/**
+	 * \brief Get the number of slots
+	 */
+	std::size_t capacity() const noexcept { return capacity_; }
+
+	/**
+	 * \brief Get the next slot to fill, waiting while the ring is full
+	 *
+	 * Called by the producer. The same slot is returned until it's
+	 * published. Returns nullptr once the ring has been closed.
+	 */
+	T* acquire() noexcept {
+		auto head = head_.load(std::memory_order_relaxed);
+		for (std::size_t spins = 0; head - tail_cache_ == capacity_; ++spins) {
+			if (closed_.load(std::memory_order_relaxed))
+				return nullptr;
+
+			tail_cache_ = tail_.load(std::memory_order_acquire);
+			pause(spins);
+		}
+
+		if (closed_.load(std::memory_order_relaxed))
+			return nullptr;
+
+		return &slots_[head & (capacity_ - 1)];
+	}
+
+	/**
+	 * \brief Hand the slot from acquire() to the consumer
+	 */
+	void publish() noexcept {
+		head_.store(head_.load(std::memory_order_relaxed) + 1,
+					std::memory_order_release);
+	}
+
+	/**
+	 * \brief Get the oldest published slot, waiting while the ring is empty
+	 *
+	 * Called by the consumer. The slot belongs to the consumer until it's
+	 * released.
+	 */
+	T& front() noexcept {
+		auto tail = tail_.load(std::memory_order_relaxed);
+		for (std::size_t spins = 0; tail == head_cache_; ++spins) {
+			head_cache_ = head_.load(std::memory_order_acquire);
+			if (tail == head_cache_)
+				pause(spins);
+		}
+
+		return slots_[tail & (capacity_ - 1)];
+	}
+
+	/**
+	 * \brief Give the slot from front() back to the producer
+	 */
+	void release() noexcept {
+		tail_.store(tail_.load(std::memory_order_relaxed) + 1,
+					std::memory_order_release);
+	}
+
+	/**
+	 * \brief Make the producer stop
+	 *
+	 * acquire() returns nullptr from now on, including in a producer that
+	 * is waiting for the ring to drain.
+	 */
+	void close() noexcept { closed_.store(true, std::memory_order_relaxed); }
+
+private:
+	static void pause(std::size_t spins) noexcept {
+		if (spins >= 64)
+			std::this_thread::yield();
+	}
+
+	std::size_t capacity_;
+	std::unique_ptr<T[]> slots_;
+	std::atomic<bool> closed_{false};
+
+	// written by the producer, with its last look at the consumer's index
+	alignas(line_size) std::atomic<std::size_t> head_{0};
+	std::size_t tail_cache_ = 0;
+
+	// written by the consumer, with its last look at the producer's index
+	alignas(line_size) std::atomic<std::size_t> tail_{0};
+	std::size_t head_cache_ = 0;
+};
+
+}  // namespace tscc
@@ -18,6 +18,13 @@
 
 #include "utf8.hpp"
 
+#include <cstdint>
+#include <cstring>
+
+#if defined(__GNUC__) && defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 std::size_t tscc::utf8_size(const std::u32string_view& str) noexcept {
 	std::size_t len = str.size();
 	for (std::size_t i = 0; i < str.size(); i++) {
@@ -97,4 +104,423 @@ std::string tscc::utf8_encode(const std::u32string_view& str) noexcept
 	}
 
 	return result;
-}
\ No newline at end of file
+}
+
+namespace {
+
+using ascii_scanner = std::size_t (*)(const char*, std::size_t) noexcept;
+
+std::size_t ascii_prefix_scalar(const char* data, std::size_t size) noexcept {
+	constexpr std::uint64_t high_bits = 0x8080808080808080ull;
+
+	std::size_t at = 0;
+	for (; at + sizeof(std::uint64_t) <= size; at += sizeof(std::uint64_t)) {
+		std::uint64_t word;
+		std::memcpy(&word, data + at, sizeof(word));
+		if (word & high_bits)
+			break;
+	}
+
+	while (at < size && static_cast<unsigned char>(data[at]) <= 0x7f)
+		++at;
+
+	return at;
+}
+
+using ascii_run_scanner = std::size_t (*)(const char*,
+										  std::size_t,
+										  char,
+										  char) noexcept;
+
+std::size_t ascii_run_scalar(const char* data,
+							 std::size_t size,
+							 char stop_a,
+							 char stop_b) noexcept {
+	std::size_t at = 0;
+	while (at < size) {
+		auto ch = data[at];
+		if (static_cast<unsigned char>(ch) > 0x7f || ch == stop_a ||
+			ch == stop_b)
+			break;
+
+		++at;
+	}
+
+	return at;
+}
+
+std::size_t find_either_scalar(const char* data,
+							   std::size_t size,
+							   char a,
+							   char b) noexcept {
+	std::size_t at = 0;
+	while (at < size && data[at] != a && data[at] != b)
+		++at;
+
+	return at;
+}
+
+#if defined(__GNUC__) && defined(__SSE2__)
+std::size_t ascii_prefix_sse2(const char* data, std::size_t size) noexcept {
+	std::size_t at = 0;
+	for (; at + 16 <= size; at += 16) {
+		auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + at));
+		auto mask = _mm_movemask_epi8(block);
+		if (mask)
+			return at + __builtin_ctz(mask);
+	}
+
+	return at + ascii_prefix_scalar(data + at, size - at);
+}
+
+__attribute__((target("avx2"))) std::size_t ascii_prefix_avx2(
+	const char* data,
+	std::size_t size) noexcept {
+	std::size_t at = 0;
+	for (; at + 32 <= size; at += 32) {
+		auto block =
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + at));
+		auto mask = static_cast<unsigned>(_mm256_movemask_epi8(block));
+		if (mask)
+			return at + __builtin_ctz(mask);
+	}
+
+	return at + ascii_prefix_sse2(data + at, size - at);
+}
+
+std::size_t ascii_run_sse2(const char* data,
+						   std::size_t size,
+						   char stop_a,
+						   char stop_b) noexcept {
+	auto a = _mm_set1_epi8(stop_a);
+	auto b = _mm_set1_epi8(stop_b);
+
+	std::size_t at = 0;
+	for (; at + 16 <= size; at += 16) {
+		auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + at));
+		auto stops = _mm_or_si128(_mm_cmpeq_epi8(block, a),
+								  _mm_cmpeq_epi8(block, b));
+		auto mask = _mm_movemask_epi8(_mm_or_si128(block, stops));
+		if (mask)
+			return at + __builtin_ctz(mask);
+	}
+
+	return at + ascii_run_scalar(data + at, size - at, stop_a, stop_b);
+}
+
+__attribute__((target("avx2"))) std::size_t ascii_run_avx2(
+	const char* data,
+	std::size_t size,
+	char stop_a,
+	char stop_b) noexcept {
+	auto a = _mm256_set1_epi8(stop_a);
+	auto b = _mm256_set1_epi8(stop_b);
+
+	std::size_t at = 0;
+	for (; at + 32 <= size; at += 32) {
+		auto block =
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + at));
+		auto stops = _mm256_or_si256(_mm256_cmpeq_epi8(block, a),
+									 _mm256_cmpeq_epi8(block, b));
+		auto mask = static_cast<unsigned>(
+			_mm256_movemask_epi8(_mm256_or_si256(block, stops)));
+		if (mask)
+			return at + __builtin_ctz(mask);
+	}
+
+	return at + ascii_run_sse2(data + at, size - at, stop_a, stop_b);
+}
+
+std::size_t find_either_sse2(const char* data,
+							 std::size_t size,
+							 char a,
+							 char b) noexcept {
+	auto va = _mm_set1_epi8(a);
+	auto vb = _mm_set1_epi8(b);
+
+	std::size_t at = 0;
+	for (; at + 16 <= size; at += 16) {
+		auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + at));
+		auto mask = _mm_movemask_epi8(
+			_mm_or_si128(_mm_cmpeq_epi8(block, va), _mm_cmpeq_epi8(block, vb)));
+		if (mask)
+			return at + __builtin_ctz(mask);
+	}
+
+	return at + find_either_scalar(data + at, size - at, a, b);
+}
+
+__attribute__((target("avx2"))) std::size_t find_either_avx2(
+	const char* data,
+	std::size_t size,
+	char a,
+	char b) noexcept {
+	auto va = _mm256_set1_epi8(a);
+	auto vb = _mm256_set1_epi8(b);
+
+	std::size_t at = 0;
+	for (; at + 32 <= size; at += 32) {
+		auto block =
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + at));
+		auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(
+			_mm256_cmpeq_epi8(block, va), _mm256_cmpeq_epi8(block, vb))));
+		if (mask)
+			return at + __builtin_ctz(mask);
+	}
+
+	return at + find_either_sse2(data + at, size - at, a, b);
+}
+
+// Multibyte validation after Keiser and Lemire, "Validating UTF-8 in less
+// than one instruction per byte". Each byte is classified by the high and
+// low nibble of the byte before it and the high nibble of itself; the three
+// table lookups are ANDed so any bit left over is an error. Whether a byte
+// has to be the second or third continuation of a 3 or 4 byte sequence is
+// checked separately against the bytes two and three positions back.
+namespace simd_utf8 {
+
+constexpr std::uint8_t too_short = 1 << 0;
+constexpr std::uint8_t too_long = 1 << 1;
+constexpr std::uint8_t overlong_3 = 1 << 2;
+constexpr std::uint8_t too_large = 1 << 3;
+constexpr std::uint8_t surrogate = 1 << 4;
+constexpr std::uint8_t overlong_2 = 1 << 5;
+constexpr std::uint8_t too_large_1000 = 1 << 6;
+constexpr std::uint8_t overlong_4 = 1 << 6;
+constexpr std::uint8_t two_conts = 1 << 7;
+constexpr std::uint8_t carry = too_short | too_long | two_conts;
+
+__attribute__((target("avx2"))) inline __m256i table(
+	std::uint8_t v0, std::uint8_t v1, std::uint8_t v2, std::uint8_t v3,
+	std::uint8_t v4, std::uint8_t v5, std::uint8_t v6, std::uint8_t v7,
+	std::uint8_t v8, std::uint8_t v9, std::uint8_t va, std::uint8_t vb,
+	std::uint8_t vc, std::uint8_t vd, std::uint8_t ve, std::uint8_t vf) {
+	return _mm256_setr_epi8(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, va, vb, vc,
+							vd, ve, vf, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9,
+							va, vb, vc, vd, ve, vf);
+}
+
+__attribute__((target("avx2"))) inline __m256i high_nibbles(__m256i v) {
+	return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0f));
+}
+
+// the input shifted right by N bytes with the end of the previous block
+// shifted in
+template <int N>
+__attribute__((target("avx2"))) inline __m256i previous(__m256i input,
+														__m256i prev_input) {
+	return _mm256_alignr_epi8(
+		input, _mm256_permute2x128_si256(prev_input, input, 0x21), 16 - N);
+}
+
+__attribute__((target("avx2"))) inline __m256i block_errors(
+	__m256i input,
+	__m256i prev_input) {
+	auto prev1 = previous<1>(input, prev_input);
+
+	auto byte_1_high = _mm256_shuffle_epi8(
+		table(too_long, too_long, too_long, too_long, too_long, too_long,
+			  too_long, too_long, two_conts, two_conts, two_conts, two_conts,
+			  too_short | overlong_2, too_short,
+			  too_short | overlong_3 | surrogate,
+			  too_short | too_large | too_large_1000 | overlong_4),
+		high_nibbles(prev1));
+
+	auto byte_1_low = _mm256_shuffle_epi8(
+		table(carry | overlong_3 | overlong_2 | overlong_4,
+			  carry | overlong_2, carry, carry, carry | too_large,
+			  carry | too_large | too_large_1000,
+			  carry | too_large | too_large_1000,
+			  carry | too_large | too_large_1000,
+			  carry | too_large | too_large_1000,
+			  carry | too_large | too_large_1000,
+			  carry | too_large | too_large_1000,
+			  carry | too_large | too_large_1000,
+			  carry | too_large | too_large_1000,
+			  carry | too_large | too_large_1000 | surrogate,
+			  carry | too_large | too_large_1000,
+			  carry | too_large | too_large_1000),
+		_mm256_and_si256(prev1, _mm256_set1_epi8(0x0f)));
+
+	auto byte_2_high = _mm256_shuffle_epi8(
+		table(too_short, too_short, too_short, too_short, too_short,
+			  too_short, too_short, too_short,
+			  too_long | overlong_2 | two_conts | overlong_3 |
+				  too_large_1000 | overlong_4,
+			  too_long | overlong_2 | two_conts | overlong_3 | too_large,
+			  too_long | overlong_2 | two_conts | surrogate | too_large,
+			  too_long | overlong_2 | two_conts | surrogate | too_large,
+			  too_short, too_short, too_short, too_short),
+		high_nibbles(input));
+
+	auto special =
+		_mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+	// 111_____ two bytes back or 1111____ three bytes back means this byte
+	// must be a continuation, which is exactly where two_conts has to be set
+	auto third = _mm256_subs_epu8(previous<2>(input, prev_input),
+								  _mm256_set1_epi8(static_cast<char>(0xe0 - 0x80)));
+	auto fourth = _mm256_subs_epu8(previous<3>(input, prev_input),
+								   _mm256_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+	auto must_be_continuation =
+		_mm256_and_si256(_mm256_or_si256(third, fourth),
+						 _mm256_set1_epi8(static_cast<char>(0x80)));
+
+	return _mm256_xor_si256(must_be_continuation, special);
+}
+
+}  // namespace simd_utf8
+
+// length of the prefix made of whole 32 byte blocks that validate cleanly,
+// backed up to the start of any sequence that may run past the last one
+__attribute__((target("avx2"))) std::size_t utf8_valid_blocks_avx2(
+	const unsigned char* data,
+	std::size_t size) noexcept {
+	auto prev_input = _mm256_setzero_si256();
+
+	std::size_t at = 0;
+	for (; at + 32 <= size; at += 32) {
+		auto input =
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + at));
+		auto errors = simd_utf8::block_errors(input, prev_input);
+		if (!_mm256_testz_si256(errors, errors))
+			break;
+
+		prev_input = input;
+	}
+
+	// a sequence that starts in the last three bytes is checked against the
+	// next block, so it isn't known to be valid yet
+	for (std::size_t back = 1; back <= 3 && back <= at; back++) {
+		auto ch = data[at - back];
+		if (ch < 0x80)
+			break;
+
+		if (ch >= 0xc0)
+			return at - back;
+	}
+
+	return at;
+}
+#endif
+
+ascii_scanner select_ascii_scanner() noexcept {
+#if defined(__GNUC__) && defined(__SSE2__)
+	if (__builtin_cpu_supports("avx2"))
+		return ascii_prefix_avx2;
+
+	return ascii_prefix_sse2;
+#else
+	return ascii_prefix_scalar;
+#endif
+}
+
+ascii_run_scanner select_ascii_run_scanner() noexcept {
+#if defined(__GNUC__) && defined(__SSE2__)
+	if (__builtin_cpu_supports("avx2"))
+		return ascii_run_avx2;
+
+	return ascii_run_sse2;
+#else
+	return ascii_run_scalar;
+#endif
+}
+
+ascii_run_scanner select_find_either() noexcept {
+#if defined(__GNUC__) && defined(__SSE2__)
+	if (__builtin_cpu_supports("avx2"))
+		return find_either_avx2;
+
+	return find_either_sse2;
+#else
+	return find_either_scalar;
+#endif
+}
+
+// length of the well-formed multibyte sequence starting at data, or 0 if it
+// is malformed or truncated
+std::size_t utf8_sequence_length(const unsigned char* data,
+								 std::size_t size) noexcept {
+	auto lead = data[0];
+	auto continuation = [](unsigned char ch) { return (ch & 0xc0) == 0x80; };
+
+	if (lead >= 0xc2 && lead <= 0xdf) {
+		return size >= 2 && continuation(data[1]) ? 2 : 0;
+	}
+
+	if (lead >= 0xe0 && lead <= 0xef) {
+		if (size < 3 || !continuation(data[2]))
+			return 0;
+
+		// E0 must not be overlong, ED must not encode a surrogate
+		auto lower = lead == 0xe0 ? 0xa0 : 0x80;
+		auto upper = lead == 0xed ? 0x9f : 0xbf;
+		return data[1] >= lower && data[1] <= upper ? 3 : 0;
+	}
+
+	if (lead >= 0xf0 && lead <= 0xf4) {
+		if (size < 4 || !continuation(data[2]) || !continuation(data[3]))
+			return 0;
+
+		// F0 must not be overlong, F4 must not go past U+10FFFF
+		auto lower = lead == 0xf0 ? 0x90 : 0x80;
+		auto upper = lead == 0xf4 ? 0x8f : 0xbf;
+		return data[1] >= lower && data[1] <= upper ? 4 : 0;
+	}
+
+	return 0;
+}
+
+}  // namespace
+
+std::size_t tscc::ascii_prefix_length(std::string_view bytes) noexcept {
+	static const ascii_scanner scanner = select_ascii_scanner();
+	return scanner(bytes.data(), bytes.size());
+}
+
+std::size_t tscc::ascii_run_length(std::string_view bytes,
+								   char stop_a,
+								   char stop_b) noexcept {
+	static const ascii_run_scanner scanner = select_ascii_run_scanner();
+	return scanner(bytes.data(), bytes.size(), stop_a, stop_b);
+}
+
+std::size_t tscc::find_either(std::string_view bytes,
+							  char a,
+							  char b) noexcept {
+	static const ascii_run_scanner scanner = select_find_either();
+	return scanner(bytes.data(), bytes.size(), a, b);
+}
+
+std::size_t tscc::utf8_valid_prefix_length(std::string_view bytes) noexcept {
+	auto data = reinterpret_cast<const unsigned char*>(bytes.data());
+
+	// validate whole blocks with vector instructions first, then finish the
+	// tail (or pin down the error) one sequence at a time
+	std::size_t at = 0;
+#if defined(__GNUC__) && defined(__SSE2__)
+	// SSE2 has no byte shuffle for the nibble lookups, so without AVX2 the
+	// multibyte runs are validated by the scalar loop alone
+	static const bool vectorized = __builtin_cpu_supports("avx2");
+	if (vectorized)
+		at = utf8_valid_blocks_avx2(data, bytes.size());
+#endif
+
+	while (at < bytes.size()) {
+		at += ascii_prefix_length(bytes.substr(at));
+		if (at == bytes.size())
+			break;
+
+		// validate the multibyte run one sequence at a time and go back to
+		// the vectorized scan as soon as we hit ASCII again
+		while (at < bytes.size() && data[at] > 0x7f) {
+			auto length = utf8_sequence_length(data + at, bytes.size() - at);
+			if (!length)
+				return at;
+
+			at += length;
+		}
+	}
+
+	return at;
+}
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 namespace tscc
 {
@@ -26,4 +27,46 @@ namespace tscc
 std::size_t utf8_size(const std::u32string_view& str) noexcept;
 std::string utf8_encode(const std::u32string_view& str) noexcept;
 
+/**
+ * \brief Count the leading bytes of a buffer that are plain 7-bit ASCII
+ *
+ * The scan uses the widest vector instructions available on the running CPU
+ * (AVX2 or SSE2 on x86) and falls back to a word-at-a-time scalar loop.
+ */
+std::size_t ascii_prefix_length(std::string_view bytes) noexcept;
+
+/**
+ * \brief Count the leading bytes of a buffer that are plain 7-bit ASCII and
+ * neither of the two stop bytes
+ *
+ * The scan is a single forward pass with the same vector instructions as
+ * ascii_prefix_length() and never looks past the first byte that ends it.
+ */
+std::size_t ascii_run_length(std::string_view bytes,
+							 char stop_a,
+							 char stop_b) noexcept;
+
+/**
+ * \brief Find the first byte that is either of two bytes
+ *
+ * Works like memchr for two needles at once with the same vector
+ * instructions as ascii_prefix_length(). Returns the size of the buffer
+ * when neither byte is found.
+ */
+std::size_t find_either(std::string_view bytes, char a, char b) noexcept;
+
+/**
+ * \brief Get the length of the longest prefix made of well-formed UTF-8
+ *
+ * With AVX2 the input is validated 32 bytes at a time using nibble lookup
+ * tables; otherwise ASCII runs are skipped with vector instructions and the
+ * multibyte sequences in between are checked one at a time.
+ *
+ * Only complete sequences are counted, so a sequence that is cut off by the
+ * end of the buffer stops validation right before it. Overlong forms,
+ * surrogates, code points above U+10FFFF and the legacy 5 and 6 byte
+ * sequences are all rejected.
+ */
+std::size_t utf8_valid_prefix_length(std::string_view bytes) noexcept;
+
 }
\ No newline at end of file
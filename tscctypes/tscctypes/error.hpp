@@ -31,6 +31,7 @@ namespace tscc {
  */
 enum class error_code : std::uint16_t {
 	// Lexer errors
+	ts998 = 998,
 	ts999 = 999,
 	ts1002 = 1002,
 	ts1003 = 1003,
@@ -60,6 +61,9 @@ enum class error_code : std::uint16_t {
 	ts2304 = 2304,
 	ts2309 = 2309,
 	ts2528 = 2528,
+
+	// Driver errors
+	ts5012 = 5012,
 };
 
 /**
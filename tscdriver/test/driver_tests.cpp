@@ -0,0 +1,193 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tscdriver/driver.hpp>
+#include <tscdriver/thread_pool.hpp>
+#include <vector>
+
+using namespace tscc::driver;
+
+namespace {
+
+class counting_observer : public tscc::parse::parser_observer {
+public:
+	void on_push(const tscc::parse::state::parser_state&,
+				 const tscc::lex::token&,
+				 const tscc::parse::state::parser_state&) override {
+		++pushes;
+	}
+
+	void on_complete(const tscc::parse::state::parser_state&,
+					 const tscc::lex::token*,
+					 const tscc::parse::ast::ast_node*) override {
+		++completions;
+	}
+
+	void on_cascade(const tscc::parse::state::parser_state&,
+					const tscc::lex::token*,
+					const tscc::parse::ast::ast_node*) override {}
+
+	std::size_t pushes = 0;
+	std::size_t completions = 0;
+};
+
+}  // namespace
+
+TEST_CASE("Thread Pool", "[driver]") {
+	thread_pool pool(4);
+	CHECK(pool.size() == 4);
+
+	SECTION("Runs every task") {
+		std::atomic<int> count{0};
+		for (int i = 0; i < 1000; ++i)
+			pool.submit([&count] { ++count; });
+		pool.wait();
+		CHECK(count.load() == 1000);
+	}
+
+	SECTION("Tasks can submit more tasks") {
+		std::atomic<int> count{0};
+		for (int i = 0; i < 10; ++i) {
+			pool.submit([&pool, &count] {
+				for (int j = 0; j < 10; ++j)
+					pool.submit([&count] { ++count; });
+			});
+		}
+		pool.wait();
+		CHECK(count.load() == 100);
+	}
+
+	SECTION("Exceptions are rethrown by wait") {
+		std::atomic<int> count{0};
+		pool.submit([] { throw std::runtime_error("failed"); });
+		for (int i = 0; i < 10; ++i)
+			pool.submit([&count] { ++count; });
+		CHECK_THROWS_AS(pool.wait(), std::runtime_error);
+		CHECK(count.load() == 10);
+
+		// the error is only reported once
+		pool.wait();
+	}
+}
+
+TEST_CASE("Parse Project", "[driver]") {
+	// unique per run so concurrent test runs don't clobber each other
+	auto directory = std::filesystem::temp_directory_path() /
+					 ("tscdriver_test_" + std::to_string(std::random_device{}()));
+	std::filesystem::create_directories(directory);
+
+	std::vector<std::filesystem::path> paths;
+	for (int i = 0; i < 20; ++i) {
+		auto& path = paths.emplace_back(directory /
+										("file" + std::to_string(i) + ".ts"));
+		std::ofstream out(path, std::ios::binary);
+		out << "import { a" << i << " } from \"b\";\n";
+	}
+
+	auto& broken = paths.emplace_back(directory / "broken.ts");
+	std::ofstream(broken, std::ios::binary) << "}";
+	paths.push_back(directory / "missing.ts");
+
+	parse_options options;
+	options.threads = 4;
+	options.make_observer = [](const std::filesystem::path&) {
+		return std::make_unique<counting_observer>();
+	};
+
+	auto files = parse_project(paths, options);
+	REQUIRE(files.size() == paths.size());
+
+	SECTION("Files are parsed in order") {
+		for (std::size_t i = 0; i < 20; ++i) {
+			CHECK(files[i].path == paths[i]);
+			REQUIRE(files[i].root);
+			CHECK(files[i].root->children().size() == 1);
+			CHECK(files[i].root->source()->name() == paths[i].string());
+			CHECK(files[i].diagnostics.empty());
+		}
+	}
+
+	SECTION("Each parser gets its own observer") {
+		for (std::size_t i = 0; i < 20; ++i) {
+			auto& observer =
+				dynamic_cast<counting_observer&>(*files[i].observer);
+			CHECK(observer.pushes > 0);
+			CHECK(observer.pushes ==
+				  dynamic_cast<counting_observer&>(*files[0].observer).pushes);
+		}
+	}
+
+	SECTION("Errors are reported as diagnostics") {
+		CHECK_FALSE(files[20].root);
+		REQUIRE(files[20].diagnostics.size() == 1);
+		CHECK(files[20].diagnostics[0].code == tscc::error_code::ts1128);
+		CHECK(files[20].diagnostics[0].location.source() == files[20].source);
+
+		CHECK_FALSE(files[21].root);
+		CHECK_FALSE(files[21].source);
+		REQUIRE(files[21].diagnostics.size() == 1);
+		CHECK(files[21].diagnostics[0].code == tscc::error_code::ts5012);
+	}
+
+	SECTION("Recovering keeps the declarations that parsed") {
+		std::ofstream(paths[20], std::ios::binary)
+			<< "}\nimport { a } from \"b\";\n}\n";
+		options.recover = true;
+
+		auto recovered = parse_project(std::span{&paths[20], 1}, options);
+		REQUIRE(recovered[0].root);
+		CHECK(recovered[0].root->children().size() == 1);
+		REQUIRE(recovered[0].diagnostics.size() == 2);
+		CHECK(recovered[0].diagnostics[1].code == tscc::error_code::ts1128);
+	}
+
+	SECTION("Regex warnings are reported when asked for") {
+		std::ofstream(paths[20], std::ios::binary)
+			<< "}\n/(\\w|\\d)*x/;\n";
+		options.recover = true;
+		options.check_regexes = true;
+
+		auto checked = parse_project(std::span{&paths[20], 1}, options);
+		REQUIRE_FALSE(checked[0].diagnostics.empty());
+		CHECK(checked[0].diagnostics.back().code == tscc::error_code::ts998);
+		CHECK(checked[0].diagnostics.back().location.offset() == 2);
+	}
+
+	SECTION("Pipelined lexing parses the same files") {
+		options.pipeline_lexing = true;
+		auto pipelined = parse_project(paths, options);
+		REQUIRE(pipelined.size() == paths.size());
+
+		for (std::size_t i = 0; i < 20; ++i) {
+			REQUIRE(pipelined[i].root);
+			CHECK(pipelined[i].root->children().size() == 1);
+			CHECK(pipelined[i].diagnostics.empty());
+		}
+		REQUIRE(pipelined[20].diagnostics.size() == 1);
+		CHECK(pipelined[20].diagnostics[0].code == tscc::error_code::ts1128);
+	}
+
+	std::filesystem::remove_all(directory);
+}
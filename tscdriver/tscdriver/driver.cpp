@@ -0,0 +1,140 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "driver.hpp"
+#include <system_error>
+#include <tsclex/diagnostic_sink.hpp>
+#include <tsclex/error.hpp>
+#include <tsclex/mapped_source.hpp>
+#include <tscparse/diagnostic_sink.hpp>
+#include <tscparse/error.hpp>
+#include <tscparse/parser.hpp>
+#include "thread_pool.hpp"
+
+using namespace tscc;
+using namespace tscc::driver;
+
+namespace {
+
+// collects the errors a recovering parser reports into the file's results
+class diagnostic_collector final : public parse::diagnostic_sink {
+public:
+	explicit diagnostic_collector(std::vector<diagnostic>& diagnostics)
+		: diagnostics_(diagnostics) {}
+
+	void report(const parse::parse_error& error) override {
+		diagnostics_.push_back({error.code(), error.location(), error.what()});
+	}
+
+private:
+	std::vector<diagnostic>& diagnostics_;
+};
+
+// collects the warnings of a lexer. A pipelined lexer reports from its own
+// thread, so these are kept apart from the parser's until it's done
+class warning_collector final : public lex::diagnostic_sink {
+public:
+	void report(const lex::lex_error& warning) override {
+		warnings.push_back({warning.code(), warning.location(), warning.what()});
+	}
+
+	std::vector<diagnostic> warnings;
+};
+
+// replay the file's tokens from the cache, lexing the whole file and storing
+// its tokens first when they aren't cached yet
+void use_token_cache(lex::lexer& lexer,
+					 const lex::mapped_source& source,
+					 const parse_options& options) {
+	auto& cache = *options.token_cache;
+	std::string_view bytes(source.contents().data(), source.contents().size());
+	auto variant = source.language_variant();
+
+	auto tokens = cache.load(bytes, lexer.file(), options.version, variant);
+	if (!tokens) {
+		tokens = lex::token_table::tokenize(lexer);
+		cache.store(bytes, *tokens, options.version, variant);
+	}
+
+	lexer.replay(std::move(*tokens));
+}
+
+void parse_file(parsed_file& file, const parse_options& options) {
+	std::shared_ptr<lex::mapped_source> source;
+	try {
+		source = lex::source::open_mapped(file.path);
+	} catch (const std::system_error& e) {
+		file.diagnostics.push_back(
+			{error_code::ts5012, {},
+			 "Cannot read file '" + file.path.string() +
+				 "': " + e.code().message() + "."});
+		return;
+	}
+
+	file.source = source;
+	if (options.keep_trivia)
+		file.trivia = std::make_unique<parse::trivia_index>();
+	if (options.make_observer)
+		file.observer = options.make_observer(file.path);
+
+	warning_collector warnings;
+	try {
+		lex::lexer lexer(source->contents(), source, options.version);
+		if (options.check_regexes)
+			lexer.set_diagnostic_sink(&warnings);
+		if (options.token_cache)
+			use_token_cache(lexer, *source, options);
+		else if (options.pipeline_lexing)
+			lexer.pipeline();
+
+		parse::parser parser(lexer, file.trivia.get(), file.observer.get());
+		diagnostic_collector collector(file.diagnostics);
+		if (options.recover)
+			parser.set_diagnostic_sink(&collector);
+
+		file.root = parser.parse();
+	} catch (const lex::lex_error& e) {
+		file.diagnostics.push_back({e.code(), e.location(), e.what()});
+	} catch (const parse::parse_error& e) {
+		file.diagnostics.push_back({e.code(), e.location(), e.what()});
+	}
+
+	file.diagnostics.insert(file.diagnostics.end(), warnings.warnings.begin(),
+							warnings.warnings.end());
+
+	if (file.trivia)
+		file.trivia->finalize();
+}
+
+}  // namespace
+
+std::vector<parsed_file> tscc::driver::parse_project(
+	std::span<const std::filesystem::path> paths,
+	const parse_options& options) {
+	std::vector<parsed_file> result(paths.size());
+	for (std::size_t i = 0; i < paths.size(); ++i)
+		result[i].path = paths[i];
+
+	// every task writes only its own slot, so the results need no locking
+	thread_pool pool(options.threads);
+	for (auto& file : result)
+		pool.submit([&file, &options] { parse_file(file, options); });
+	pool.wait();
+
+	return result;
+}
@@ -0,0 +1,136 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <tsclex/lexer.hpp>
+#include <tsclex/source_location.hpp>
+#include <tsclex/token_cache.hpp>
+#include <tscctypes/error.hpp>
+#include <tscparse/ast/source_file_node.hpp>
+#include <tscparse/parser_observer.hpp>
+#include <tscparse/trivia_index.hpp>
+#include <vector>
+
+namespace tscc::driver {
+
+/**
+ * \brief An error or warning reported for one file of a project
+ */
+struct diagnostic {
+	error_code code;
+	lex::source_location location;
+	std::string message;
+};
+
+/**
+ * \brief The result of lexing and parsing one file
+ *
+ * root is nullptr when the file couldn't be read or parsing stopped at an
+ * error, in which case the reason is in diagnostics. When the parser
+ * recovers from errors, root holds the declarations that did parse and
+ * diagnostics has every error that was found.
+ */
+struct parsed_file {
+	std::filesystem::path path;
+	std::shared_ptr<lex::source> source;
+	std::unique_ptr<parse::ast::source_file_node> root;
+	std::unique_ptr<parse::trivia_index> trivia;
+	std::unique_ptr<parse::parser_observer> observer;
+	std::vector<diagnostic> diagnostics;
+};
+
+/**
+ * \brief Settings for parse_project()
+ */
+struct parse_options {
+	/**
+	 * \brief The number of worker threads, or 0 for one per hardware thread
+	 */
+	std::size_t threads = 0;
+
+	lex::language_version version = lex::language_version::latest;
+
+	/**
+	 * \brief Build a trivia index for each file
+	 */
+	bool keep_trivia = false;
+
+	/**
+	 * \brief Keep parsing a file after a parse error
+	 *
+	 * Every parse error in the file is reported instead of just the first.
+	 */
+	bool recover = false;
+
+	/**
+	 * \brief Warn about regular expression literals that can backtrack
+	 * catastrophically
+	 *
+	 * Files read from the token cache aren't lexed, so they aren't checked.
+	 */
+	bool check_regexes = false;
+
+	/**
+	 * \brief Lex each file on a thread of its own while it is parsed
+	 *
+	 * This helps when there are fewer files than worker threads. Files read
+	 * from the token cache aren't lexed, so they aren't pipelined.
+	 */
+	bool pipeline_lexing = false;
+
+	/**
+	 * \brief Read the tokens of unchanged files from this cache, if set
+	 *
+	 * Files without an entry are lexed in full before they are parsed and
+	 * their tokens stored for next time. The cache must outlive the call.
+	 */
+	const lex::token_cache* token_cache = nullptr;
+
+	/**
+	 * \brief Make the observer for the parser of a file, if set
+	 *
+	 * Called on the worker thread that parses the file. Each parser gets its
+	 * own observer, which is kept in the file's result.
+	 */
+	std::function<std::unique_ptr<parse::parser_observer>(
+		const std::filesystem::path&)>
+		make_observer;
+};
+
+/**
+ * \brief Lex and parse every file of a project in parallel
+ *
+ * Files are spread across a work-stealing thread_pool, with each file lexed
+ * straight from a memory mapping and parsed by its own parser. Results are
+ * returned in the same order as the paths.
+ *
+ * Lexer and parser errors, and files that can't be read, are reported in
+ * the file's diagnostics rather than thrown.
+ */
+std::vector<parsed_file> parse_project(
+	std::span<const std::filesystem::path> paths,
+	const parse_options& options = {});
+
+}  // namespace tscc::driver
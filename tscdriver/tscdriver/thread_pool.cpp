@@ -0,0 +1,146 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <utility>
+
+using namespace tscc::driver;
+
+namespace {
+
+// the pool and queue the current thread works for, so nested submissions
+// stay on the submitting worker
+thread_local const thread_pool* current_pool = nullptr;
+thread_local std::size_t current_queue = 0;
+
+}  // namespace
+
+thread_pool::thread_pool(std::size_t threads) {
+	if (!threads)
+		threads = std::max(1u, std::thread::hardware_concurrency());
+
+	queues_.reserve(threads);
+	for (std::size_t i = 0; i < threads; ++i)
+		queues_.push_back(std::make_unique<queue>());
+
+	workers_.reserve(threads);
+	for (std::size_t i = 0; i < threads; ++i)
+		workers_.emplace_back([this, i] { run(i); });
+}
+
+thread_pool::~thread_pool() {
+	{
+		std::lock_guard lock(mutex_);
+		stopping_ = true;
+	}
+	wake_.notify_all();
+
+	for (auto& worker : workers_)
+		worker.join();
+}
+
+void thread_pool::submit(task work) {
+	auto index = current_pool == this
+					 ? current_queue
+					 : next_queue_.fetch_add(1, std::memory_order_relaxed) %
+						   queues_.size();
+
+	{
+		std::lock_guard lock(mutex_);
+		++unfinished_;
+	}
+
+	{
+		auto& target = *queues_[index];
+		std::lock_guard lock(target.mutex);
+		target.tasks.push_back(std::move(work));
+	}
+
+	{
+		std::lock_guard lock(mutex_);
+		++queued_;
+	}
+	wake_.notify_one();
+}
+
+void thread_pool::wait() {
+	std::unique_lock lock(mutex_);
+	done_.wait(lock, [this] { return unfinished_ == 0; });
+
+	if (error_)
+		std::rethrow_exception(std::exchange(error_, nullptr));
+}
+
+void thread_pool::run(std::size_t index) {
+	current_pool = this;
+	current_queue = index;
+
+	while (true) {
+		task work;
+		if (pop(index, work)) {
+			std::exception_ptr error;
+			try {
+				work();
+			} catch (...) {
+				error = std::current_exception();
+			}
+
+			std::lock_guard lock(mutex_);
+			if (error && !error_)
+				error_ = error;
+			if (--unfinished_ == 0)
+				done_.notify_all();
+			continue;
+		}
+
+		std::unique_lock lock(mutex_);
+		wake_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+		if (stopping_ && queued_ <= 0)
+			return;
+	}
+}
+
+bool thread_pool::pop(std::size_t index, task& into) {
+	auto take = [this, &into](queue& from, bool newest) {
+		std::lock_guard lock(from.mutex);
+		if (from.tasks.empty())
+			return false;
+
+		if (newest) {
+			into = std::move(from.tasks.back());
+			from.tasks.pop_back();
+		} else {
+			into = std::move(from.tasks.front());
+			from.tasks.pop_front();
+		}
+
+		return true;
+	};
+
+	auto found = take(*queues_[index], true);
+	for (std::size_t i = 1; !found && i < queues_.size(); ++i)
+		found = take(*queues_[(index + i) % queues_.size()], false);
+
+	if (!found)
+		return false;
+
+	std::lock_guard lock(mutex_);
+	--queued_;
+	return true;
+}
@@ -0,0 +1,106 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tscc::driver {
+
+/**
+ * \brief A fixed set of worker threads that steal work from each other
+ *
+ * Every worker has its own queue. A worker takes the newest task from its
+ * own queue and, once that is empty, the oldest task from another worker's
+ * queue. Tasks submitted from outside the pool are spread across the queues
+ * in turn, and tasks submitted from a worker go onto that worker's queue.
+ */
+class thread_pool {
+public:
+	using task = std::function<void()>;
+
+	/**
+	 * \brief Start the workers
+	 *
+	 * \param threads The number of workers, or 0 for one per hardware thread
+	 */
+	explicit thread_pool(std::size_t threads = 0);
+
+	/**
+	 * \brief Finish every queued task and stop the workers
+	 */
+	~thread_pool();
+
+	thread_pool(const thread_pool&) = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+
+	/**
+	 * \brief Queue a task to run on one of the workers
+	 */
+	void submit(task work);
+
+	/**
+	 * \brief Block until every submitted task has finished
+	 *
+	 * If any task threw, the first exception is rethrown here once the rest
+	 * of the tasks have finished.
+	 */
+	void wait();
+
+	/**
+	 * \brief Get the number of workers
+	 */
+	std::size_t size() const noexcept { return queues_.size(); }
+
+private:
+	struct queue {
+		std::mutex mutex;
+		std::deque<task> tasks;
+	};
+
+	void run(std::size_t index);
+
+	// take a task from the worker's own queue or steal one from another
+	bool pop(std::size_t index, task& into);
+
+	std::vector<std::unique_ptr<queue>> queues_;
+	std::vector<std::thread> workers_;
+	std::atomic<std::size_t> next_queue_{0};
+
+	std::mutex mutex_;
+	std::condition_variable wake_;
+	std::condition_variable done_;
+
+	// queued_ can briefly go below zero when a task is taken before its
+	// submitter has counted it
+	std::ptrdiff_t queued_ = 0;
+	std::size_t unfinished_ = 0;
+	bool stopping_ = false;
+	std::exception_ptr error_;
+};
+
+}  // namespace tscc::driver
@@ -0,0 +1,122 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <tscfakes/test_common.hpp>
+#include <tsclex/mapped_source.hpp>
+
+TEST_CASE("Contiguous Buffer Input", "[lexer]") {
+	auto [file, source, create_lexer, tokenize] = test_utils::create_test_setup();
+
+	auto tokenize_buffer = [source](std::string_view input) {
+		tscc::lex::lexer lexer(std::span(input.data(), input.size()), source);
+		return std::vector<tscc::lex::token>{lexer.begin(), lexer.end()};
+	};
+
+	SECTION("Simple statement") {
+		auto tokens = tokenize_buffer("const x = 'value';");
+		REQUIRE(tokens.size() == 5);
+		CHECK(tokens[0].is<tscc::lex::tokens::const_token>());
+		CHECK(tokens[1].is<tscc::lex::tokens::identifier_token>());
+		CHECK(tokens[1]->to_string() == "x");
+		CHECK(tokens[2].is<tscc::lex::tokens::eq_token>());
+		CHECK(tokens[3].is<tscc::lex::tokens::constant_value_token>());
+		CHECK(tokens[3]->to_string() == "'value'");
+		CHECK(tokens[4].is<tscc::lex::tokens::semicolon_token>());
+	}
+
+	SECTION("Empty buffer") {
+		auto tokens = tokenize_buffer("");
+		CHECK(tokens.empty());
+	}
+
+	SECTION("Matches the stream lexer across refill boundaries") {
+		// multibyte identifiers repeated well past the stream buffer size so
+		// that sequences straddle the stream lexer's refill points
+		std::string input;
+		for (int i = 0; i < 1000; ++i) {
+			input += "let varµァ";
+			input += std::to_string(i);
+			input += " = \"😀\" + `a${i}b`; // ✓\n";
+		}
+
+		auto streamed = tokenize(input);
+		auto buffered = tokenize_buffer(input);
+		REQUIRE(streamed.size() == buffered.size());
+		for (std::size_t i = 0; i < streamed.size(); ++i) {
+			CHECK(streamed[i] == buffered[i]);
+			CHECK(streamed[i].location().offset() ==
+				  buffered[i].location().offset());
+		}
+	}
+
+	SECTION("Unterminated string at the end of the buffer") {
+		std::string_view input = "const x = 'unterminated";
+		tscc::lex::lexer lexer(std::span(input.data(), input.size()), source);
+		REQUIRE_THROWS(
+			std::vector<tscc::lex::token>{lexer.begin(), lexer.end()});
+	}
+}
+
+TEST_CASE("Memory Mapped Sources", "[lexer]") {
+	// unique per run so concurrent test runs don't clobber each other
+	auto path = std::filesystem::temp_directory_path() /
+				("tsclex_mapped_source_test_" +
+				 std::to_string(std::random_device{}()) + ".ts");
+
+	SECTION("Lexes a mapped file") {
+		{
+			std::ofstream out(path, std::ios::binary | std::ios::trunc);
+			out << "import { a } from \"b\";\n";
+		}
+
+		auto mapped = tscc::lex::source::open_mapped(path);
+		CHECK(mapped->name() == path.string());
+		CHECK(mapped->contents().size() == 23);
+
+		tscc::lex::lexer lexer(mapped->contents(), mapped);
+		std::vector<tscc::lex::token> tokens{lexer.begin(), lexer.end()};
+		REQUIRE(tokens.size() == 8);
+		CHECK(tokens[0].is<tscc::lex::tokens::import_token>());
+		CHECK(tokens[5].is<tscc::lex::tokens::constant_value_token>());
+		CHECK(tokens[7].is<tscc::lex::tokens::newline_token>());
+	}
+
+	SECTION("Maps an empty file") {
+		{
+			std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		}
+
+		auto mapped = tscc::lex::source::open_mapped(path);
+		CHECK(mapped->contents().empty());
+
+		tscc::lex::lexer lexer(mapped->contents(), mapped);
+		CHECK(lexer.begin() == lexer.end());
+	}
+
+	SECTION("Missing file") {
+		std::filesystem::remove(path);
+		REQUIRE_THROWS_AS(tscc::lex::source::open_mapped(path),
+						  std::system_error);
+	}
+
+	std::filesystem::remove(path);
+}
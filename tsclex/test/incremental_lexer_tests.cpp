@@ -0,0 +1,134 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tscfakes/test_common.hpp>
+#include <tsclex/incremental_lexer.hpp>
+
+using namespace tscc::lex;
+
+namespace {
+
+// the edited tokens must match lexing the new text from scratch
+void check_matches_full_lex(const incremental_lexer& document,
+							const std::shared_ptr<source>& source) {
+	auto& text = document.text();
+	lexer lex(std::span{text.data(), text.size()}, source);
+	auto expected = token_table::tokenize(lex);
+
+	auto& actual = document.tokens();
+	REQUIRE(actual.size() == expected.size());
+	for (std::size_t i = 0; i < expected.size(); ++i) {
+		CHECK(actual.records()[i].kind == expected.records()[i].kind);
+		CHECK(actual.records()[i].offset == expected.records()[i].offset);
+		CHECK(actual.records()[i].length == expected.records()[i].length);
+		CHECK(actual.materialize(i) == expected.materialize(i));
+	}
+}
+
+}  // namespace
+
+TEST_CASE("Incremental Lexing", "[lexer]") {
+	auto [file, source, create_lexer, tokenize] = test_utils::create_test_setup();
+
+	std::string text;
+	for (int i = 0; i < 200; ++i)
+		text += "let value" + std::to_string(i) + " = \"text\" + " +
+				std::to_string(i) + ";\n";
+
+	incremental_lexer document(source, text);
+	check_matches_full_lex(document, source);
+
+	SECTION("An edit inside a line only relexes around that line") {
+		auto at = document.text().find("value100");
+		auto result = document.edit(at, 8, "renamed");
+
+		CHECK(result.relexed < 100);
+		CHECK(result.removed == result.inserted);
+		CHECK(document.text().find("renamed =") != std::string::npos);
+		check_matches_full_lex(document, source);
+	}
+
+	SECTION("Inserting lines adds tokens and shifts the rest") {
+		auto at = document.text().find("let value50");
+		auto result = document.edit(at, 0, "const a = 1;\nconst b = 2;\n");
+
+		CHECK(result.inserted == result.removed + 12);
+		CHECK(result.relexed < 100);
+		check_matches_full_lex(document, source);
+	}
+
+	SECTION("Edits inside a template restart with its nesting") {
+		auto at = document.text().find("\"text\" + 10;");
+		document.edit(at, 6, "`a${\n1 +\n2\n}b`");
+		check_matches_full_lex(document, source);
+
+		// the checkpoints inside the substitution keep the template open
+		at = document.text().find("2\n}b`");
+		auto result = document.edit(at, 1, "3");
+		CHECK(result.relexed < 20);
+		check_matches_full_lex(document, source);
+
+		// splitting the substitution in two
+		at = document.text().find("1 +\n");
+		document.edit(at, 3, "1}c${0");
+		check_matches_full_lex(document, source);
+	}
+
+	SECTION("Edits at the edges of the text") {
+		document.edit(0, 0, "// header\n");
+		check_matches_full_lex(document, source);
+
+		document.edit(document.text().size(), 0, "let end = 1");
+		check_matches_full_lex(document, source);
+
+		document.edit(0, document.text().size(), "x");
+		CHECK(document.tokens().size() == 1);
+		check_matches_full_lex(document, source);
+	}
+
+	SECTION("Joining a line break with the text around it") {
+		auto at = document.text().find(";\nlet value7 ");
+		document.edit(at + 1, 1, "");
+		check_matches_full_lex(document, source);
+
+		document.edit(at + 1, 0, "\r");
+		check_matches_full_lex(document, source);
+		document.edit(at + 2, 0, "\n");
+		check_matches_full_lex(document, source);
+	}
+
+	SECTION("Edits that don't lex leave the document unchanged") {
+		auto before = document.text();
+		auto count = document.tokens().size();
+		CHECK_THROWS_AS(document.edit(10, 0, "\"open"), lex_error);
+		CHECK(document.text() == before);
+		CHECK(document.tokens().size() == count);
+
+		CHECK_THROWS_AS(document.edit(before.size(), 1, ""), std::out_of_range);
+	}
+
+	SECTION("Many small edits in a row") {
+		auto at = document.text().find("value30");
+		for (char ch : std::string_view{"abcdefghij"}) {
+			document.edit(at, 0, std::string(1, ch));
+			++at;
+		}
+		check_matches_full_lex(document, source);
+		CHECK(document.text().find("abcdefghijvalue30") != std::string::npos);
+	}
+}
@@ -137,4 +137,31 @@ TEST_CASE("Keywords", "[lexer]") {
 		CHECK(tokens[4].is<tscc::lex::tokens::namespace_token>());
 		CHECK(tokens[5].is<tscc::lex::tokens::enum_token>());
 	}
-}
\ No newline at end of file
+
+	SECTION("Near Misses Stay Identifiers") {
+		// same length and same first, second and last characters as a
+		// keyword, so they land on the keyword's hash slot
+		auto tokens = tokenize("cane cless thus tyxeof yiild");
+		REQUIRE(tokens.size() == 5);
+		for (const auto& token : tokens) {
+			CHECK(token.is<tscc::lex::tokens::identifier_token>());
+		}
+		CHECK(tokens[1]->to_string() == "cless");
+	}
+
+	SECTION("Keywords Respect The Language Version") {
+		auto lexer = create_lexer("let async using",
+								  tscc::lex::language_version::es5);
+		std::vector<tscc::lex::token> tokens{lexer.begin(), lexer.end()};
+		REQUIRE(tokens.size() == 3);
+		CHECK(tokens[0].is<tscc::lex::tokens::identifier_token>());
+		CHECK(tokens[1].is<tscc::lex::tokens::identifier_token>());
+		CHECK(tokens[2].is<tscc::lex::tokens::identifier_token>());
+
+		tokens = tokenize("let async using");
+		REQUIRE(tokens.size() == 3);
+		CHECK(tokens[0].is<tscc::lex::tokens::let_token>());
+		CHECK(tokens[1].is<tscc::lex::tokens::async_token>());
+		CHECK(tokens[2].is<tscc::lex::tokens::using_token>());
+	}
+}
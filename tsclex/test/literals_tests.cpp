@@ -17,6 +17,7 @@
  */
 
 #include <tscfakes/test_common.hpp>
+#include <limits>
 
 TEST_CASE("Literals", "[lexer]") {
 	using namespace Catch::literals;
@@ -237,6 +238,33 @@ TEST_CASE("Literals", "[lexer]") {
 				CHECK(tokens[5]->to_string() == "0");
 			}
 
+			SECTION("Decimals round to the nearest double") {
+				auto tokens = tokenize(
+					"0.1 0.30000000000000004 2.2250738585072011e-308 "
+					"9007199254740993.0 1e400 1e-400 1_000.5e-3");
+				REQUIRE(tokens.size() == 7);
+				auto value = [&](std::size_t i) {
+					return *static_cast<tscc::lex::tokens::constant_value_token&>(
+								*tokens[i])
+								.decimal_value();
+				};
+				CHECK(value(0) == 0.1);
+				CHECK(value(1) == 0.30000000000000004);
+				CHECK(value(2) == 2.2250738585072011e-308);
+				CHECK(value(3) == 9007199254740992.0);
+				CHECK(value(4) == std::numeric_limits<double>::infinity());
+				CHECK(value(5) == 0.0);
+				CHECK(value(6) == 1.0005);
+				CHECK(tokens[1]->to_string() == "0.30000000000000004");
+
+				auto& separated =
+					static_cast<tscc::lex::tokens::constant_value_token&>(
+						*tokens[6]);
+				CHECK(separated.decimal_lexeme() == "1000.5e-3");
+				CHECK(separated.scientific_notation() ==
+					  std::pair{-3, false});
+			}
+
 			SECTION("Decimal with Separators") {
 				auto tokens = tokenize("1_234 1_234.567 1.2e4");
 				REQUIRE(tokens.size() == 3);
@@ -648,6 +676,21 @@ TEST_CASE("Literals", "[lexer]") {
 				CHECK(constant_value1.is_bigint() == true);
 			}
 
+			SECTION("BigInt wider than 64 bits") {
+				auto tokens = tokenize(
+					"123456789012345678901234567890n 0xffffffffffffffffffffn");
+				REQUIRE(tokens.size() == 2);
+				auto& decimal =
+					static_cast<tscc::lex::tokens::constant_value_token&>(
+						*tokens[0]);
+				REQUIRE(decimal.integer_value());
+				CHECK(decimal.integer_value()->to_string() ==
+					  "123456789012345678901234567890");
+				CHECK(tokens[0]->to_string() ==
+					  "123456789012345678901234567890n");
+				CHECK(tokens[1]->to_string() == "0xffffffffffffffffffffn");
+			}
+
 			SECTION("Mixed regular and BigInt numbers") {
 				auto tokens = tokenize("123 123n 0xFF 0xFFn");
 				REQUIRE(tokens.size() == 4);
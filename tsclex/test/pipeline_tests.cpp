@@ -0,0 +1,128 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <tscfakes/test_common.hpp>
+#include <tsclex/error/unterminated_string_literal.hpp>
+#include <tsclex/token_table.hpp>
+
+using namespace tscc::lex;
+
+TEST_CASE("Pipelined Lexing", "[lexer]") {
+	auto [file, source, create_lexer, tokenize] = test_utils::create_test_setup();
+
+	std::string input;
+	for (int i = 0; i < 300; ++i)
+		input += "let a" + std::to_string(i) + " = `x${b + `y${c}`}z`;\n";
+	auto expected = tokenize(input);
+	REQUIRE(expected.size() > 1000);
+
+	SECTION("Tokens come out the same as without a pipeline") {
+		auto lexer = create_lexer(input);
+		lexer.pipeline(4);
+
+		token current;
+		std::vector<token> tokens;
+		while (lexer.next(current))
+			tokens.push_back(current);
+
+		CHECK(tokens == expected);
+		CHECK(current.undefined());
+		CHECK_FALSE(lexer.next(current));
+		CHECK(lexer.offset() == input.size());
+	}
+
+	SECTION("Iterators and fill read from the pipeline") {
+		auto lexer = create_lexer(input);
+		lexer.pipeline();
+		std::array<token, 7> batch;
+		REQUIRE(lexer.fill(batch) == batch.size());
+
+		std::vector<token> tokens(batch.begin(), batch.end());
+		tokens.insert(tokens.end(), lexer.begin(), lexer.end());
+		CHECK(tokens == expected);
+	}
+
+	SECTION("Checkpoints are taken where the reader is") {
+		lexer plain(std::span{input.data(), input.size()}, source);
+		lexer pipelined(std::span{input.data(), input.size()}, source);
+		pipelined.pipeline(2);
+
+		token left, right;
+		for (std::size_t i = 0; i < expected.size(); ++i) {
+			REQUIRE(plain.next(left));
+			REQUIRE(pipelined.next(right));
+
+			auto expected_state = plain.save();
+			auto state = pipelined.save();
+			REQUIRE(state.offset() == expected_state.offset());
+			REQUIRE(state.same_state(expected_state));
+			REQUIRE(pipelined.offset() == plain.offset());
+		}
+	}
+
+	SECTION("Restoring carries on in the pipeline") {
+		lexer lexer(std::span{input.data(), input.size()}, source);
+		lexer.pipeline(8);
+
+		token current;
+		for (int i = 0; i < 100; ++i)
+			REQUIRE(lexer.next(current));
+		auto saved = lexer.save();
+		for (int i = 0; i < 50; ++i)
+			REQUIRE(lexer.next(current));
+
+		lexer.restore(saved);
+		std::vector<token> tokens;
+		while (lexer.next(current))
+			tokens.push_back(current);
+
+		CHECK(std::equal(tokens.begin(), tokens.end(), expected.begin() + 100,
+						 expected.end()));
+		CHECK(tokens.size() == expected.size() - 100);
+	}
+
+	SECTION("Replayed tables can be pipelined") {
+		auto lexer = create_lexer(input);
+		auto table = token_table::tokenize(lexer);
+		lexer.pipeline();
+		lexer.replay(std::move(table));
+
+		std::vector<token> tokens(lexer.begin(), lexer.end());
+		CHECK(tokens == expected);
+	}
+
+	SECTION("Errors are thrown when they are reached") {
+		auto lexer = create_lexer("a b c \"d");
+		lexer.pipeline(2);
+
+		token current;
+		for (int i = 0; i < 3; ++i)
+			REQUIRE(lexer.next(current));
+		CHECK_THROWS_AS(lexer.next(current), unterminated_string_literal);
+		CHECK_FALSE(lexer.next(current));
+	}
+
+	SECTION("The lexer can be dropped before the end") {
+		auto lexer = create_lexer(input);
+		lexer.pipeline(2);
+
+		token current;
+		REQUIRE(lexer.next(current));
+	}
+}
@@ -0,0 +1,83 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <tscfakes/test_common.hpp>
+
+using namespace tscc::lex;
+
+TEST_CASE("Pulling Tokens", "[lexer]") {
+	auto [file, source, create_lexer, tokenize] = test_utils::create_test_setup();
+
+	const std::string input = "import { a, b } from \"c\";\nlet d = `e${f}g`;";
+	auto expected = tokenize(input);
+	REQUIRE(expected.size() > 16);
+
+	SECTION("next produces the same tokens as the iterator") {
+		auto lexer = create_lexer(input);
+		token current;
+		std::size_t count = 0;
+		while (lexer.next(current)) {
+			REQUIRE(count < expected.size());
+			CHECK(current == expected[count]);
+			CHECK(current.location().offset() ==
+				  expected[count].location().offset());
+			++count;
+		}
+
+		CHECK(count == expected.size());
+		CHECK(current.undefined());
+		CHECK_FALSE(lexer.next(current));
+	}
+
+	SECTION("fill produces the same tokens in batches") {
+		auto lexer = create_lexer(input);
+		std::array<token, 5> batch;
+		std::vector<token> tokens;
+		while (auto count = lexer.fill(batch)) {
+			tokens.insert(tokens.end(), batch.begin(), batch.begin() + count);
+			if (count < batch.size())
+				break;
+		}
+
+		CHECK(tokens == expected);
+		CHECK(lexer.fill(batch) == 0);
+	}
+
+	SECTION("Iterators reach the end sentinel") {
+		auto lexer = create_lexer(input);
+		std::size_t count = 0;
+		for (auto it = lexer.begin(); it != std::default_sentinel; ++it)
+			++count;
+
+		CHECK(count == expected.size());
+	}
+
+	SECTION("Iterators at different tokens aren't equal") {
+		auto lexer = create_lexer("a a");
+		auto first = lexer.begin();
+		auto copy = first;
+		++first;
+
+		// both hold an identifier "a" but they're different positions
+		CHECK(first != copy);
+		CHECK(first != lexer.end());
+		++first;
+		CHECK(first == lexer.end());
+	}
+}
@@ -17,9 +17,27 @@
  */
 
 #include <tscfakes/test_common.hpp>
+#include <tsclex/diagnostic_sink.hpp>
+#include <tsclex/error/catastrophic_backtracking.hpp>
 #include <tsclex/error/conflicting_regex_flags.hpp>
 #include <tsclex/error/regex_flag_unavailable.hpp>
 
+namespace {
+
+struct collecting_sink : tscc::lex::diagnostic_sink {
+	void report(const tscc::lex::lex_error& warning) override {
+		codes.push_back(warning.code());
+		offsets.push_back(warning.location().offset());
+		messages.emplace_back(warning.what());
+	}
+
+	std::vector<tscc::error_code> codes;
+	std::vector<std::size_t> offsets;
+	std::vector<std::string> messages;
+};
+
+}  // namespace
+
 TEST_CASE("Regular Expressions", "[lexer]") {
 	auto [file, source, create_lexer, tokenize] = test_utils::create_test_setup();
 
@@ -37,7 +55,7 @@ TEST_CASE("Regular Expressions", "[lexer]") {
 	SECTION("Regex with Flags") {
 		auto tokens = tokenize(
 			"/test/g /pattern/i /multi/m /dotall/s /unicode/u /sticky/y");
-		REQUIRE(tokens.size() == 6);
+		REQUIRE(tokens.size() == 5);
 
 		// Global flag
 		CHECK(tokens[0].is<tscc::lex::tokens::regex_token>());
@@ -188,6 +206,30 @@ TEST_CASE("Regular Expressions", "[lexer]") {
 			  "5]|2[0-4][0-9]|[01]?[0-9][0-9]?)$/");
 	}
 
+	SECTION("Catastrophic backtracking is reported as a warning") {
+		auto lexer = create_lexer("/^(a+)+$/; /[a-z]+@x/; /.*.*=/");
+		collecting_sink sink;
+		lexer.set_diagnostic_sink(&sink);
+
+		std::vector<tscc::lex::token> tokens{lexer.begin(), lexer.end()};
+		REQUIRE(tokens.size() == 5);
+		CHECK(tokens[4].is<tscc::lex::tokens::regex_token>());
+
+		REQUIRE(sink.codes.size() == 2);
+		CHECK(sink.codes[0] == tscc::error_code::ts998);
+		CHECK(sink.offsets[0] == 0);
+		CHECK(sink.messages[0] ==
+			  "Regular expression can take exponential time to fail on "
+			  "'(a+)+'.");
+		CHECK(sink.offsets[1] == 23);
+		CHECK(sink.messages[1] ==
+			  "Regular expression can take time proportional to n^2 to fail "
+			  "on '.*.*'.");
+
+		// without a sink nothing is checked
+		CHECK(tokenize("/^(a+)+$/").size() == 1);
+	}
+
 	SECTION("Regex Error Cases") {
 		SECTION("Invalid Regex Flags") {
 			auto lexer = create_lexer("/pattern/xyz");
@@ -0,0 +1,126 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tscfakes/test_common.hpp>
+#include <tsclex/source_registry.hpp>
+
+using namespace tscc::lex;
+
+TEST_CASE("Source Registry", "[lexer]") {
+	auto [file, source, create_lexer, tokenize] = test_utils::create_test_setup();
+
+	SECTION("Locations are small and trivially copyable") {
+		STATIC_REQUIRE(sizeof(source_location) == 8);
+		STATIC_REQUIRE(std::is_trivially_copyable_v<source_location>);
+	}
+
+	SECTION("Lines and columns are looked up from the offset") {
+		auto tokens = tokenize("let a = 1;\n\n  const bc = 2;\n/* x\n y */ z");
+		REQUIRE(tokens.size() == 14);
+
+		CHECK(tokens[0].location().line() == 0);
+		CHECK(tokens[0].location().column() == 0);
+		CHECK(tokens[1].location().column() == 4);
+
+		// the newline token sits at the end of the line it ends
+		REQUIRE(tokens[5].is<tokens::newline_token>());
+		CHECK(tokens[5].location().line() == 0);
+		CHECK(tokens[5].location().column() == 10);
+
+		REQUIRE(tokens[6].is<tokens::const_token>());
+		CHECK(tokens[6].location().line() == 2);
+		CHECK(tokens[6].location().column() == 2);
+		CHECK(tokens[7].location().column() == 8);
+
+		REQUIRE(tokens[13].is<tokens::identifier_token>());
+		CHECK(tokens[13].location().line() == 4);
+		CHECK(tokens[13].location().column() == 6);
+	}
+
+	SECTION("Lines are found across stream chunks") {
+		std::string input;
+		for (int i = 0; i < 2000; ++i)
+			input += "let a = 1;\r\n";
+		input += "z";
+
+		auto tokens = tokenize(input);
+		REQUIRE(tokens.back().is<tokens::identifier_token>());
+		CHECK(tokens.back().location().line() == 2000);
+		CHECK(tokens.back().location().column() == 0);
+
+		auto lines = source_registry::global().lines(tokens.back().location().file());
+		REQUIRE(lines);
+		CHECK(lines->line_count() == 2001);
+		CHECK(lines->line_start(1000) == 12000);
+	}
+
+	SECTION("Buffers are scanned for lines up front") {
+		std::string_view input = "a\rb\n\nc";
+		lexer lexer(std::span{input.data(), input.size()}, source);
+		std::vector<token> tokens{lexer.begin(), lexer.end()};
+		REQUIRE(tokens.size() == 5);
+		CHECK(tokens[2].location().line() == 1);
+		CHECK(tokens[4].location().line() == 3);
+		CHECK(tokens[4].location().column() == 0);
+	}
+
+	SECTION("Line breaks split between chunks are counted once") {
+		line_map lines;
+		lines.scan("a\r", 0);
+		lines.scan("\nb\n", 2);
+		lines.scan("\r\r\n", 5);
+		CHECK(lines.line_count() == 5);
+		CHECK(lines.line_start(1) == 3);
+		CHECK(lines.line_start(2) == 5);
+		CHECK(lines.line_start(3) == 6);
+		CHECK(lines.line_start(4) == 8);
+		CHECK(lines.position(4) == std::pair<std::size_t, std::size_t>{1, 1});
+
+		// rescanning what was already seen doesn't add lines
+		lines.scan("\r\n", 6);
+		CHECK(lines.line_count() == 5);
+	}
+
+	SECTION("Each lexer gets its own file") {
+		auto first = create_lexer("a");
+		auto second = create_lexer("b");
+		CHECK(first.file() != source_registry::no_file);
+		CHECK(first.file() != second.file());
+		CHECK(source_registry::global().source(first.file()) == source);
+
+		auto tokens = tokenize("x");
+		REQUIRE(tokens.size() == 1);
+		CHECK(tokens[0].location().source() == source);
+	}
+
+	SECTION("Detached locations keep their line and column") {
+		source_location location(source, 10, 5, 100);
+		CHECK(location.line() == 10);
+		CHECK(location.column() == 5);
+		CHECK(location.offset() == 100);
+		CHECK((location + 3).column() == 8);
+		CHECK(location.source() == source);
+	}
+
+	SECTION("Default locations have no file") {
+		source_location location;
+		CHECK(location.file() == source_registry::no_file);
+		CHECK(location.source() == nullptr);
+		CHECK(location.line() == 0);
+	}
+}
@@ -0,0 +1,131 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <random>
+#include <tscfakes/test_common.hpp>
+#include <tsclex/token_cache.hpp>
+#include <tsclex/token_table.hpp>
+
+using namespace tscc::lex;
+
+TEST_CASE("Token Cache", "[lexer]") {
+	auto [file, source, create_lexer, tokenize] = test_utils::create_test_setup();
+
+	// unique per run so concurrent test runs don't clobber each other
+	auto directory = std::filesystem::temp_directory_path() /
+					 ("tsclex_token_cache_test_" +
+					  std::to_string(std::random_device{}()));
+	token_cache cache(directory);
+
+	auto round_trip = [&](const std::string& input,
+						  language_version version = language_version::latest) {
+		auto lexer = create_lexer(input, version);
+		auto table = token_table::tokenize(lexer);
+		cache.store(input, table, version, source->language_variant());
+
+		auto replayed = create_lexer(input, version);
+		auto cached = cache.load(input, replayed.file(), version,
+								 source->language_variant());
+		REQUIRE(cached);
+		REQUIRE(cached->size() == table.size());
+		for (std::size_t i = 0; i < table.size(); ++i) {
+			CHECK(cached->records()[i].kind == table.records()[i].kind);
+			CHECK(cached->records()[i].offset == table.records()[i].offset);
+			CHECK(cached->records()[i].length == table.records()[i].length);
+		}
+
+		replayed.replay(std::move(*cached));
+		std::vector<token> tokens{replayed.begin(), replayed.end()};
+		CHECK(tokens == tokenize(input));
+		CHECK(replayed.offset() == input.size());
+		return tokens;
+	};
+
+	SECTION("Tokens with data come back the same") {
+		auto tokens = round_trip(
+			"#!/usr/bin/env node\n"
+			"// line comment\n"
+			"/* multi\n   line */\n"
+			"/** @param {string} name - the name */\n"
+			"let s = 'it\\'s' + \"caf\\u00e9\" + `a${b}c`;\n"
+			"let n = [0x1F, 0o17, 0b101, 12n, 1.5, 2.5e-3, 6E+2];\n"
+			"let r = /(?<year>\\d{4})-[a-z0-9]+?|^\\bx*$/giu;\n");
+		CHECK(tokens.front().is<tokens::shebang_token>());
+		CHECK(tokens.back().is<tokens::newline_token>());
+	}
+
+	SECTION("Big integers wider than a varint come back the same") {
+		auto tokens =
+			round_trip("let n = 123456789012345678901234567890n + 0xffn;");
+		REQUIRE(tokens[3].is<tokens::constant_value_token>());
+		auto& value =
+			static_cast<tokens::constant_value_token&>(*tokens[3]);
+		CHECK(value.integer_value()->to_string() ==
+			  "123456789012345678901234567890");
+	}
+
+	SECTION("JSX text and attributes come back the same") {
+		source->language_variant(ts_language_variant::jsx);
+		round_trip("let a = <div title=\"&amp;lt;\">a &amp;amp; b {c}</div>;");
+	}
+
+	SECTION("Entries are keyed by content, version and variant") {
+		std::string input = "let a = 1;";
+		auto lexer = create_lexer(input);
+		cache.store(input, token_table::tokenize(lexer),
+					language_version::latest, ts_language_variant::ts);
+
+		CHECK(cache.load(input, lexer.file(), language_version::latest,
+						 ts_language_variant::ts));
+		CHECK_FALSE(cache.load("let a = 2;", lexer.file(),
+							   language_version::latest,
+							   ts_language_variant::ts));
+		CHECK_FALSE(cache.load(input, lexer.file(), language_version::es5,
+							   ts_language_variant::ts));
+		CHECK_FALSE(cache.load(input, lexer.file(), language_version::latest,
+							   ts_language_variant::tsx));
+	}
+
+	SECTION("Damaged entries are ignored") {
+		std::string input = "let a = 'abc';";
+		auto lexer = create_lexer(input);
+		cache.store(input, token_table::tokenize(lexer),
+					language_version::latest, ts_language_variant::ts);
+
+		// the only entry in the directory
+		std::filesystem::path entry;
+		for (auto& found : std::filesystem::directory_iterator(directory))
+			entry = found.path();
+		REQUIRE(entry.extension() == ".tokens");
+
+		std::filesystem::resize_file(entry,
+									 std::filesystem::file_size(entry) - 2);
+		CHECK_FALSE(cache.load(input, lexer.file(), language_version::latest,
+							   ts_language_variant::ts));
+	}
+
+	SECTION("Replaying a table of another file is an error") {
+		auto first = create_lexer("a");
+		auto second = create_lexer("a");
+		CHECK_THROWS_AS(second.replay(token_table::tokenize(first)),
+						std::invalid_argument);
+	}
+
+	std::filesystem::remove_all(directory);
+}
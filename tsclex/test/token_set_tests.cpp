@@ -0,0 +1,79 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tscfakes/test_common.hpp>
+#include <tsclex/token_set.hpp>
+
+using namespace tscc::lex;
+
+TEST_CASE("Token Kinds", "[lexer]") {
+	auto [file, source, create_lexer, tokenize] = test_utils::create_test_setup();
+
+	SECTION("Kinds follow the order of the token types") {
+		STATIC_REQUIRE(token::kind_of<tokens::abstract_token>() ==
+					   token_kind::abstract_token);
+		STATIC_REQUIRE(token::kind_of<tokens::yield_token>() ==
+					   token_kind::yield_token);
+		STATIC_REQUIRE(static_cast<std::size_t>(token_kind::yield_token) ==
+					   token_kind_count - 1);
+		STATIC_REQUIRE(token::index_of<tokens::close_brace_token>() ==
+					   static_cast<std::size_t>(token_kind::close_brace_token));
+	}
+
+	SECTION("Tokens report their kind") {
+		auto tokens = tokenize("type A = 1;");
+		REQUIRE(tokens.size() == 5);
+		CHECK(tokens[0].kind() == token_kind::type_token);
+		CHECK(tokens[1].kind() == token_kind::identifier_token);
+		CHECK(tokens[2].kind() == token_kind::eq_token);
+		CHECK(tokens[3].kind() == token_kind::constant_value_token);
+		CHECK(tokens[4].kind() == token_kind::semicolon_token);
+
+		CHECK_THROWS_AS(token{}.kind(), token_undefined);
+	}
+
+	SECTION("Sets are built at compile time") {
+		constexpr auto braces =
+			token_set::of<tokens::open_brace_token, tokens::close_brace_token>();
+		STATIC_REQUIRE(braces.contains(token_kind::open_brace_token));
+		STATIC_REQUIRE(braces.contains(token_kind::close_brace_token));
+		STATIC_REQUIRE_FALSE(braces.contains(token_kind::open_paren_token));
+		STATIC_REQUIRE_FALSE(braces.empty());
+		STATIC_REQUIRE(token_set{}.empty());
+
+		constexpr auto last = token_set::of<tokens::yield_token>();
+		STATIC_REQUIRE((braces | last).contains(token_kind::yield_token));
+		STATIC_REQUIRE((braces & last).empty());
+		STATIC_REQUIRE((braces | last) ==
+					   token_set{token_kind::yield_token,
+								 token_kind::close_brace_token,
+								 token_kind::open_brace_token});
+	}
+
+	SECTION("Tokens are tested against sets") {
+		constexpr auto keywords =
+			token_set::of<tokens::type_token, tokens::import_token>();
+
+		auto tokens = tokenize("type import x");
+		REQUIRE(tokens.size() == 3);
+		CHECK(keywords.contains(tokens[0]));
+		CHECK(keywords.contains(tokens[1]));
+		CHECK_FALSE(keywords.contains(tokens[2]));
+		CHECK_FALSE(keywords.contains(token{}));
+	}
+}
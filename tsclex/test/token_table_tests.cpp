@@ -0,0 +1,89 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tscfakes/test_common.hpp>
+#include <tsclex/token_table.hpp>
+
+using namespace tscc::lex;
+
+TEST_CASE("Compact Token Table", "[lexer]") {
+	auto [file, source, create_lexer, tokenize] = test_utils::create_test_setup();
+
+	const std::string input =
+		"// leading comment\n"
+		"const greeting = 'héllo';\n"
+		"let total = 0x1F + 2.5e3 + 10n;\n"
+		"if (/ab+c/gi.test(greeting)) {\n"
+		"  total += `${greeting} world`.length;\n"
+		"}\n";
+
+	SECTION("Materialized tokens match the lexer") {
+		auto expected = tokenize(input);
+		auto lexer = create_lexer(input);
+		auto table = token_table::tokenize(lexer);
+
+		REQUIRE(table.size() == expected.size());
+		for (std::size_t i = 0; i < expected.size(); ++i) {
+			auto materialized = table.materialize(i);
+			CHECK(materialized == expected[i]);
+			CHECK(materialized.location().line() ==
+				  expected[i].location().line());
+			CHECK(materialized.location().column() ==
+				  expected[i].location().column());
+			CHECK(materialized.location().offset() ==
+				  expected[i].location().offset());
+			CHECK(table[i].offset() == expected[i].location().offset());
+		}
+	}
+
+	SECTION("Views read token data without materializing") {
+		auto lexer = create_lexer(input);
+		auto table = token_table::tokenize(lexer);
+
+		REQUIRE(table.size() > 5);
+		CHECK(table[0].is<tokens::comment_token>());
+		CHECK(table[1].is<tokens::const_token>());
+		CHECK(table[1].record().payload == compact_token::no_payload);
+		CHECK(table[1].length() == 5);
+
+		REQUIRE(table[2].is<tokens::identifier_token>());
+		CHECK(table[2].get<tokens::identifier_token>()->to_string() ==
+			  "greeting");
+		CHECK(table[2].length() == 8);
+		CHECK(table[2].get<tokens::constant_value_token>() == nullptr);
+
+		REQUIRE(table[4].is<tokens::constant_value_token>());
+		CHECK(table[4].length() == std::string_view("'héllo'").size());
+		CHECK(table[4].materialize()->to_string() == "'héllo'");
+	}
+
+	SECTION("Records are 16 bytes") {
+		STATIC_REQUIRE(sizeof(compact_token) == 16);
+
+		auto lexer = create_lexer(input);
+		auto table = token_table::tokenize(lexer);
+		CHECK(table.records().size() == table.size());
+		CHECK(table.records().size_bytes() == table.size() * 16);
+	}
+
+	SECTION("Empty input") {
+		auto lexer = create_lexer("");
+		auto table = token_table::tokenize(lexer);
+		CHECK(table.empty());
+	}
+}
@@ -60,6 +60,73 @@ TEST_CASE("Native UTF-8 Handling", "[lexer]") {
 		CHECK(tokens[4].is<tscc::lex::tokens::semicolon_token>());
 	}
 
+	SECTION("Multibyte characters inside long ASCII runs") {
+		std::string padding(100, 'a');
+		auto tokens = tokenize("// " + padding + " ¢ " + padding +
+							   "\nconst " + padding + "µ" + padding +
+							   " = '" + padding + "汉" + padding + "'; /* " +
+							   padding + " 😀 */");
+		REQUIRE(tokens.size() == 7);
+		CHECK(tokens[0].is<tscc::lex::tokens::comment_token>());
+		CHECK(tokens[0]->to_string() == "// " + padding + " ¢ " + padding);
+		CHECK(tokens[1].is<tscc::lex::tokens::const_token>());
+		CHECK(tokens[2].is<tscc::lex::tokens::identifier_token>());
+		CHECK(tokens[2]->to_string() == padding + "µ" + padding);
+		CHECK(tokens[3].is<tscc::lex::tokens::eq_token>());
+		REQUIRE(tokens[4].is<tscc::lex::tokens::constant_value_token>());
+		std::u32string upadding(100, U'a');
+		CHECK(static_cast<tscc::lex::tokens::constant_value_token&>(*tokens[4])
+				  .string_value() == upadding + U"汉" + upadding);
+		CHECK(tokens[6].is<tscc::lex::tokens::multiline_comment_token>());
+	}
+
+	SECTION("Malformed bytes are read as single characters") {
+		// neither a stray 0xff byte nor a truncated sequence can be decoded,
+		// so each of their bytes is taken as the matching latin-1 character
+		auto tokens = tokenize("const x = 'a\xff\xe6\xb1" "b';");
+		REQUIRE(tokens.size() == 5);
+		REQUIRE(tokens[3].is<tscc::lex::tokens::constant_value_token>());
+		CHECK(static_cast<tscc::lex::tokens::constant_value_token&>(*tokens[3])
+				  .string_value() == U"a\u00ff\u00e6\u00b1b");
+		CHECK(tokens[4].is<tscc::lex::tokens::semicolon_token>());
+	}
+
+	SECTION("Identifiers are interned") {
+		auto tokens = tokenize("abc \\u0061bc varµ varµ abd");
+		REQUIRE(tokens.size() == 5);
+
+		auto name = [&tokens](std::size_t i) {
+			REQUIRE(tokens[i].is<tscc::lex::tokens::identifier_token>());
+			return static_cast<const tscc::lex::tokens::identifier_token&>(
+					   *tokens[i])
+				.name();
+		};
+
+		// the plain ASCII and escaped spellings take different paths into
+		// the interner but end up as the same atom
+		CHECK(name(0) == name(1));
+		CHECK(name(2) == name(3));
+		CHECK(name(0) != name(4));
+		CHECK(tscc::interner::global().view(name(2)) == "varµ");
+	}
+
+	SECTION("Identifiers take any code point of the version's ranges") {
+		// neither character is at the start or end of its range
+		auto tokens = tokenize("const 变量 = 1;");
+		REQUIRE(tokens.size() == 5);
+		CHECK(tokens[1].is<tscc::lex::tokens::identifier_token>());
+		CHECK(tokens[1]->to_string() == "变量");
+
+		// U+0220 was added after ES3
+		auto latest = create_lexer("a\u0220b");
+		std::vector<tscc::lex::token> identifier{latest.begin(), latest.end()};
+		REQUIRE(identifier.size() == 1);
+		CHECK(identifier[0].is<tscc::lex::tokens::identifier_token>());
+
+		auto es3 = create_lexer("a\u0220b", tscc::lex::language_version::es3);
+		CHECK_THROWS(std::vector<tscc::lex::token>{es3.begin(), es3.end()});
+	}
+
 	SECTION("Invalid Unicode Escape Sequences") {
 		// Test for invalid unicode escape sequences
 		auto lexer =
@@ -0,0 +1,44 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "error.hpp"
+
+namespace tscc::lex {
+
+/**
+ * \brief Receiver for the warnings of a lexer
+ *
+ * Warnings are problems that don't stop the input from being lexed, such as
+ * a regular expression literal that can backtrack catastrophically. Without
+ * a sink the lexer doesn't look for them.
+ */
+class diagnostic_sink {
+public:
+	virtual ~diagnostic_sink() = default;
+
+	/**
+	 * \brief Called for every warning, in the order they're found
+	 *
+	 * A pipelined lexer calls this from its lexing thread.
+	 */
+	virtual void report(const lex_error& warning) = 0;
+};
+
+}  // namespace tscc::lex
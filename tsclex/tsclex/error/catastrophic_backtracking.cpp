@@ -0,0 +1,42 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catastrophic_backtracking.hpp"
+#include <tsccore/utf8.hpp>
+
+using namespace tscc::lex;
+
+catastrophic_backtracking::catastrophic_backtracking(
+	const tscc::lex::source_location& location,
+	const tsccore::regex::backtracking_hazard& hazard)
+	: lex_error(location) {
+	what_ = "Regular expression can take ";
+	if (hazard.exponential)
+		what_ += "exponential time";
+	else
+		what_ += "time proportional to n^" + std::to_string(hazard.degree);
+	what_ += " to fail on '" + tscc::utf8_encode(hazard.source) + "'.";
+}
+
+const char* catastrophic_backtracking::what() const noexcept {
+	return what_.c_str();
+}
+
+tscc::error_code catastrophic_backtracking::code() const noexcept {
+	return error_code::ts998;
+}
@@ -0,0 +1,46 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <string>
+#include <tsccore/regex/backtracking_hazards.hpp>
+#include "../error.hpp"
+
+namespace tscc::lex {
+
+/**
+ * \brief A regular expression literal that can take exponential or high
+ * polynomial time to fail
+ *
+ * This is reported as a warning, never thrown.
+ */
+class catastrophic_backtracking : public lex_error {
+	std::string what_;
+
+public:
+	catastrophic_backtracking(
+		const source_location& location,
+		const tsccore::regex::backtracking_hazard& hazard);
+
+	const char* what() const noexcept override;
+
+	error_code code() const noexcept override;
+};
+
+}  // namespace tscc::lex
@@ -0,0 +1,138 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "incremental_lexer.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include "token.hpp"
+
+using namespace tscc::lex;
+
+incremental_lexer::incremental_lexer(std::shared_ptr<class source> source,
+									 std::string text,
+									 language_version version)
+	: source_(std::move(source)),
+	  text_(std::move(text)),
+	  version_(version),
+	  tokens_(source_registry::no_file) {
+	lexer lex(std::span{text_.data(), text_.size()}, source_, version_);
+	token_table tokens(lex.file());
+
+	token current;
+	while (lex.next(current)) {
+		tokens.push_back(current, lex.offset() - current.location().offset());
+		if (current.is<tokens::newline_token>())
+			restarts_.push_back({lex.save(), tokens.size()});
+	}
+
+	tokens_ = std::move(tokens);
+}
+
+incremental_lexer::edit_result incremental_lexer::edit(
+	std::size_t offset,
+	std::size_t removed,
+	std::string_view inserted) {
+	if (offset > text_.size() || removed > text_.size() - offset)
+		throw std::out_of_range("the edit is past the end of the text");
+
+	// restart from the last checkpoint where nothing lexed before it looked
+	// at the edited text. reach only grows, so the checkpoints are sorted by
+	// it
+	auto restart = std::partition_point(
+		restarts_.begin(), restarts_.end(),
+		[offset](const restart_point& point) {
+			return point.state.reach() <= offset;
+		});
+
+	std::string removed_text = text_.substr(offset, removed);
+	text_.replace(offset, removed, inserted);
+
+	try {
+		lexer lex(std::span{text_.data(), text_.size()}, source_, version_);
+		std::size_t first = 0;
+		if (restart != restarts_.begin()) {
+			lex.restore(std::prev(restart)->state);
+			first = std::prev(restart)->token;
+		}
+
+		auto start = lex.offset();
+		auto edit_end = offset + inserted.size();
+
+		token_table fresh(lex.file());
+		std::vector<restart_point> fresh_restarts;
+		auto resync = restarts_.end();
+		auto last = tokens_.size();
+
+		token current;
+		while (lex.next(current)) {
+			fresh.push_back(current,
+							lex.offset() - current.location().offset());
+			if (!current.is<tokens::newline_token>())
+				continue;
+
+			auto point = lex.save();
+			if (point.offset() >= edit_end) {
+				// the old checkpoint at the same place in the unchanged text
+				auto old_offset = point.offset() - inserted.size() + removed;
+				auto found = std::lower_bound(
+					restart, restarts_.end(), old_offset,
+					[](const restart_point& point, std::size_t offset) {
+						return point.state.offset() < offset;
+					});
+
+				if (found != restarts_.end() &&
+					found->state.offset() == old_offset &&
+					found->state.same_state(point)) {
+					fresh_restarts.push_back(
+						{std::move(point), first + fresh.size()});
+					resync = found;
+					last = found->token;
+					break;
+				}
+			}
+
+			fresh_restarts.push_back({std::move(point), first + fresh.size()});
+		}
+
+		edit_result result{first, last - first, fresh.size(),
+						   lex.offset() - start};
+
+		// everything after the resync point only moves
+		auto shift = static_cast<std::ptrdiff_t>(inserted.size()) -
+					 static_cast<std::ptrdiff_t>(removed);
+		auto token_shift = static_cast<std::ptrdiff_t>(result.inserted) -
+						   static_cast<std::ptrdiff_t>(result.removed);
+		auto kept = resync == restarts_.end() ? resync : std::next(resync);
+		for (auto it = kept; it != restarts_.end(); ++it) {
+			it->state.shift(offset, removed, inserted.size());
+			it->token = static_cast<std::size_t>(
+				static_cast<std::ptrdiff_t>(it->token) + token_shift);
+		}
+
+		tokens_.splice(first, last, std::move(fresh), shift);
+
+		auto at = restarts_.erase(restart, kept);
+		restarts_.insert(at, std::make_move_iterator(fresh_restarts.begin()),
+						 std::make_move_iterator(fresh_restarts.end()));
+
+		return result;
+	} catch (...) {
+		text_.replace(offset, inserted.size(), removed_text);
+		throw;
+	}
+}
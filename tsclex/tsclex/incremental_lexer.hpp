@@ -0,0 +1,111 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "lexer.hpp"
+#include "source.hpp"
+#include "token_table.hpp"
+
+namespace tscc::lex {
+
+/**
+ * \brief The tokens of a document that is edited in place
+ *
+ * Meant for editors, where the text changes a little at a time. The
+ * document is lexed once, taking a lexer checkpoint after every line break.
+ * An edit then only relexes from the last checkpoint before the edit, and
+ * stops as soon as the lexer reaches a line break past the edit in the same
+ * state the old tokens were lexed in; the tokens after that are kept and
+ * only have their offsets moved.
+ *
+ * Each version of the text is registered as a new file, so tokens from an
+ * earlier version keep reporting the lines and columns of that version.
+ */
+class incremental_lexer {
+public:
+	/**
+	 * \brief The tokens an edit replaced
+	 */
+	struct edit_result {
+		// the index of the first token that changed
+		std::size_t first;
+
+		// the number of old tokens that were replaced
+		std::size_t removed;
+
+		// the number of new tokens in their place
+		std::size_t inserted;
+
+		// the number of bytes that were lexed again
+		std::size_t relexed;
+	};
+
+	incremental_lexer(std::shared_ptr<class source> source,
+					  std::string text,
+					  language_version version = language_version::latest);
+
+	/**
+	 * \brief Replace part of the text and relex the tokens it affects
+	 * \param offset Where the replaced text starts
+	 * \param removed The number of bytes to remove
+	 * \param inserted The text to put in their place
+	 *
+	 * If the new text can't be lexed the error is thrown and the document
+	 * is left as it was.
+	 */
+	edit_result edit(std::size_t offset,
+					 std::size_t removed,
+					 std::string_view inserted);
+
+	/**
+	 * \brief Get the current text
+	 */
+	const std::string& text() const noexcept { return text_; }
+
+	/**
+	 * \brief Get the tokens of the current text
+	 */
+	const token_table& tokens() const noexcept { return tokens_; }
+
+	/**
+	 * \brief Get the file the current text is registered as
+	 */
+	file_id file() const noexcept { return tokens_.file(); }
+
+private:
+	struct restart_point {
+		lexer::checkpoint state;
+
+		// the index of the token right after the checkpoint
+		std::size_t token;
+	};
+
+	std::shared_ptr<class source> source_;
+	std::string text_;
+	language_version version_;
+	token_table tokens_;
+	std::vector<restart_point> restarts_;
+};
+
+}  // namespace tscc::lex
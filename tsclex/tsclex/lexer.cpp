@@ -19,10 +19,17 @@
 #include "lexer.hpp"
 #include <array>
 #include <cassert>
-#include <cmath>
+#include <charconv>
+#include <cstdlib>
 #include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <tsccore/regex/backtracking_hazards.hpp>
 #include <tsccore/regex/scan_regex.hpp>
+#include <tsccore/spsc_ring.hpp>
 #include <tsccore/xml.hpp>
+#include "error/catastrophic_backtracking.hpp"
 #include "error/conflicting_regex_flags.hpp"
 #include "error/duplicate_regex_flag.hpp"
 #include "error/expected_command.hpp"
@@ -40,12 +47,55 @@
 #include "error/unterminated_multiline_comment.hpp"
 #include "error/unterminated_string_literal.hpp"
 #include "error/unterminated_unicode_escape_sequence.hpp"
+#include "private/keyword_hash.hpp"
 #include "private/unicode_tables.hpp"
 #include "token.hpp"
+#include "token_table.hpp"
 #include "tsccore/utf8.hpp"
 
 using namespace tscc::lex;
 
+namespace {
+
+// the value of an escape that was already checked to be in range
+char32_t small_value(const tscc::big_int& value) noexcept {
+	return static_cast<char32_t>(value.to_int64().value_or(0));
+}
+
+// the nearest double to a decimal literal with its separators removed.
+// from_chars is correctly rounded and handles the common case without any
+// big number arithmetic; values past the range of a double are left to
+// strtod which rounds them to infinity or zero like JavaScript does
+double parse_decimal(const std::string& text) {
+	double result = 0;
+	auto [end, error] =
+		std::from_chars(text.data(), text.data() + text.size(), result);
+	if (error == std::errc::result_out_of_range)
+		return std::strtod(text.c_str(), nullptr);
+
+	return result;
+}
+
+const detail::identifier_table& identifier_start_table(
+	language_version version) {
+	if (version >= language_version::es2015)
+		return detail::unicode_tables::esnext_identifier_start;
+	if (version >= language_version::es5)
+		return detail::unicode_tables::es5_identifier_start;
+	return detail::unicode_tables::es3_identifier_start;
+}
+
+const detail::identifier_table& identifier_part_table(
+	language_version version) {
+	if (version >= language_version::es2015)
+		return detail::unicode_tables::esnext_identifier_part;
+	if (version >= language_version::es5)
+		return detail::unicode_tables::es5_identifier_part;
+	return detail::unicode_tables::es3_identifier_part;
+}
+
+}  // namespace
+
 lex_error::lex_error(const source_location& location) noexcept
 	: location_(location) {}
 
@@ -65,7 +115,7 @@ lexer::iterator& lexer::iterator::operator++() {
 	if (token_.use_count() > 1)
 		token_ = std::make_shared<token>();
 
-	if (!lexer_->scan(*token_))
+	if (!lexer_->read(*token_))
 		token_->undefine();
 	return *this;
 }
@@ -77,29 +127,88 @@ lexer::iterator lexer::iterator::operator++(int) {
 }
 
 bool lexer::iterator::operator==(const iterator& other) const {
-	return (token_ == other.token_) || (*token_ == *other.token_);
+	// only the end is equal to another iterator with a different token
+	auto at_end = token_->undefined();
+	return token_ == other.token_ ||
+		   (at_end && at_end == other.token_->undefined());
+}
+
+bool lexer::iterator::operator==(std::default_sentinel_t) const noexcept {
+	return token_->undefined();
 }
 
 bool lexer::iterator::operator!=(const iterator& other) const {
 	return !operator==(other);
 }
 
+struct lexer::pipeline_state {
+	struct slot {
+		token value;
+
+		// the state of the lexer after the token, for save()
+		checkpoint after;
+		bool more = false;
+		std::exception_ptr error;
+	};
+
+	explicit pipeline_state(std::size_t capacity) : ring(capacity) {}
+
+	tscc::spsc_ring<slot> ring;
+	std::thread producer;
+
+	// only used by the reader: the state after the last token read, and
+	// whether the end or an error was read
+	checkpoint after;
+	bool done = false;
+};
+
 lexer::iterator::iterator(lexer* source)
 	: token_(std::make_shared<token>()), lexer_(source) {}
 
 lexer::lexer(std::istream& stream,
 			 std::shared_ptr<class source> stream_metadata,
 			 language_version version)
-	: stream_(stream),
+	: stream_(&stream),
 	  source_(std::move(stream_metadata)),
+	  file_(source_registry::global().add(source_)),
+	  lines_(source_registry::global().lines(file_)),
 	  buffer_offset_(0),
+	  validated_begin_(0),
+	  validated_end_(0),
 	  end_(this),
 	  pnewline_(false),
 	  force_identifier_(false),
-	  vers_(version) {
+	  vers_(version),
+	  identifier_start_(&identifier_start_table(version)),
+	  identifier_part_(&identifier_part_table(version)) {
 	wbuffer_.reserve(buffer_size);
 }
 
+lexer::lexer(std::span<const char> buffer,
+			 std::shared_ptr<class source> stream_metadata,
+			 language_version version)
+	: stream_(nullptr),
+	  source_(std::move(stream_metadata)),
+	  file_(source_registry::global().add(source_)),
+	  lines_(source_registry::global().lines(file_)),
+	  input_(buffer.data(), buffer.size()),
+	  buffer_offset_(0),
+	  validated_begin_(0),
+	  validated_end_(0),
+	  end_(this),
+	  pnewline_(false),
+	  force_identifier_(false),
+	  vers_(version),
+	  identifier_start_(&identifier_start_table(version)),
+	  identifier_part_(&identifier_part_table(version)) {
+	wbuffer_.reserve(buffer_size);
+	lines_->scan(input_, 0);
+}
+
+lexer::~lexer() {
+	stop_pipeline();
+}
+
 lexer::iterator lexer::begin() {
 	lexer::iterator result(this);
 	++result;
@@ -110,448 +219,665 @@ lexer::iterator lexer::end() {
 	return end_;
 }
 
-std::unordered_map<std::u32string, lexer::versioned_keyword>
-	lexer::keyword_lookup{
-		{U"abstract",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::abstract_token>(location);
-		  },
-		  language_version::es3}},
-		{U"accessor",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::accessor_token>(location);
-		  },
-		  language_version::es3}},
-		{U"any",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::any_token>(location);
-		  },
-		  language_version::es3}},
-		{U"as",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::as_token>(location);
-		  },
-		  language_version::es3}},
-		{U"asserts",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::asserts_token>(location);
-		  },
-		  language_version::es3}},
-		{U"assert",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::assert_token>(location);
-		  },
-		  language_version::es3}},
-		{U"async",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::async_token>(location);
-		  },
-		  language_version::es2015}},
-		{U"await",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::await_token>(location);
-		  },
-		  language_version::es2015}},
-		{U"bigint",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::bigint_token>(location);
-		  },
-		  language_version::es3}},
-		{U"boolean",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::boolean_token>(location);
-		  },
-		  language_version::es3}},
-		{U"break",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::break_token>(location);
-		  },
-		  language_version::es3}},
-		{U"case",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::case_token>(location);
-		  },
-		  language_version::es3}},
-		{U"catch",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::catch_token>(location);
-		  },
-		  language_version::es3}},
-		{U"class",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::class_token>(location);
-		  },
-		  language_version::es2015}},
-		{U"continue",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::continue_token>(location);
-		  },
-		  language_version::es3}},
-		{U"const",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::const_token>(location);
-		  },
-		  language_version::es2015}},
-		{U"constructor",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::constructor_token>(location);
-		  },
-		  language_version::es3}},
-		{U"debugger",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::debugger_token>(location);
-		  },
-		  language_version::es3}},
-		{U"declare",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::declare_token>(location);
-		  },
-		  language_version::es3}},
-		{U"default",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::default_token>(location);
-		  },
-		  language_version::es2015}},
-		{U"delete",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::delete_token>(location);
-		  },
-		  language_version::es3}},
-		{U"do",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::do_token>(location);
-		  },
-		  language_version::es3}},
-		{U"else",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::else_token>(location);
-		  },
-		  language_version::es3}},
-		{U"enum",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::enum_token>(location);
-		  },
-		  language_version::es3}},
-		{U"export",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::export_token>(location);
-		  },
-		  language_version::es2015}},
-		{U"extends",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::extends_token>(location);
-		  },
-		  language_version::es2015}},
-		{U"false",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::false_token>(location);
-		  },
-		  language_version::es3}},
-		{U"finally",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::finally_token>(location);
-		  },
-		  language_version::es3}},
-		{U"for",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::for_token>(location);
-		  },
-		  language_version::es3}},
-		{U"from",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::from_token>(location);
-		  },
-		  language_version::es2015}},
-		{U"function",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::function_token>(location);
-		  },
-		  language_version::es3}},
-		{U"get",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::get_token>(location);
-		  },
-		  language_version::es5}},
-		{U"global",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::global_token>(location);
-		  },
-		  language_version::es3}},
-		{U"if",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::if_token>(location);
-		  },
-		  language_version::es3}},
-		{U"implements",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::implements_token>(location);
-		  },
-		  language_version::es3}},
-		{U"import",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::import_token>(location);
-		  },
-		  language_version::es2015}},
-		{U"in",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::in_token>(location);
-		  },
-		  language_version::es3}},
-		{U"infer",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::infer_token>(location);
-		  },
-		  language_version::es3}},
-		{U"instanceof",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::instanceof_token>(location);
-		  },
-		  language_version::es3}},
-		{U"interface",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::interface_token>(location);
-		  },
-		  language_version::es3}},
-		{U"intrinsic",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::intrinsic_token>(location);
-		  },
-		  language_version::es3}},
-		{U"is",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::is_token>(location);
-		  },
-		  language_version::es3}},
-		{U"keyof",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::keyof_token>(location);
-		  },
-		  language_version::es3}},
-		{U"let",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::let_token>(location);
-		  },
-		  language_version::es2015}},
-		{U"module",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::module_token>(location);
-		  },
-		  language_version::es3}},
-		{U"namespace",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::namespace_token>(location);
-		  },
-		  language_version::es3}},
-		{U"never",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::never_token>(location);
-		  },
-		  language_version::es3}},
-		{U"new",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::new_token>(location);
-		  },
-		  language_version::es3}},
-		{U"null",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::null_token>(location);
-		  },
-		  language_version::es3}},
-		{U"number",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::number_token>(location);
-		  },
-		  language_version::es3}},
-		{U"of",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::of_token>(location);
-		  },
-		  language_version::es2015}},
-		{U"object",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::object_token>(location);
-		  },
-		  language_version::es3}},
-		{U"package",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::package_token>(location);
-		  },
-		  language_version::es3}},
-		{U"private",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::private_token>(location);
-		  },
-		  language_version::es3}},
-		{U"protected",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::protected_token>(location);
-		  },
-		  language_version::es3}},
-		{U"public",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::public_token>(location);
-		  },
-		  language_version::es3}},
-		{U"override",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::override_token>(location);
-		  },
-		  language_version::es3}},
-		{U"out",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::out_token>(location);
-		  },
-		  language_version::es3}},
-		{U"readonly",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::readonly_token>(location);
-		  },
-		  language_version::es3}},
-		{U"require",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::require_token>(location);
-		  },
-		  language_version::es3}},
-		{U"return",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::return_token>(location);
-		  },
-		  language_version::es3}},
-		{U"satisfies",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::satisfies_token>(location);
-		  },
-		  language_version::es3}},
-		{U"set",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::set_token>(location);
-		  },
-		  language_version::es5}},
-		{U"static",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::static_token>(location);
-		  },
-		  language_version::es2015}},
-		{U"string",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::string_token>(location);
-		  },
-		  language_version::es3}},
-		{U"super",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::super_token>(location);
-		  },
-		  language_version::es2015}},
-		{U"switch",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::switch_token>(location);
-		  },
-		  language_version::es3}},
-		{U"symbol",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::symbol_token>(location);
-		  },
-		  language_version::es2015}},
-		{U"this",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::this_token>(location);
-		  },
-		  language_version::es3}},
-		{U"throw",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::throw_token>(location);
-		  },
-		  language_version::es3}},
-		{U"true",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::true_token>(location);
-		  },
-		  language_version::es3}},
-		{U"try",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::try_token>(location);
-		  },
-		  language_version::es3}},
-		{U"type",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::type_token>(location);
-		  },
-		  language_version::es3}},
-		{U"typeof",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::typeof_token>(location);
-		  },
-		  language_version::es3}},
-		{U"undefined",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::undefined_token>(location);
-		  },
-		  language_version::es3}},
-		{U"unique",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::unique_token>(location);
-		  },
-		  language_version::es3}},
-		{U"unknown",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::unknown_token>(location);
-		  },
-		  language_version::es3}},
-		{U"using",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::using_token>(location);
-		  },
-		  language_version::es2022}},
-		{U"var",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::var_token>(location);
-		  },
-		  language_version::es3}},
-		{U"void",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::void_token>(location);
-		  },
-		  language_version::es3}},
-		{U"while",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::while_token>(location);
-		  },
-		  language_version::es3}},
-		{U"with",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::with_token>(location);
-		  },
-		  language_version::es3}},
-		{U"yield",
-		 {[](token& into, const source_location& location) {
-			  into.emplace_token<tokens::yield_token>(location);
-		  },
-		  language_version::es2015}}};
+bool lexer::next(token& into) {
+	if (read(into))
+		return true;
+
+	into.undefine();
+	return false;
+}
+
+std::size_t lexer::fill(std::span<token> into) {
+	std::size_t count = 0;
+	while (count < into.size() && next(into[count]))
+		++count;
+
+	return count;
+}
+
+void lexer::replay(token_table tokens) {
+	if (tokens.file() != file_)
+		throw std::invalid_argument("the token table is for a different file");
+
+	auto capacity = stop_pipeline();
+	replay_ = std::make_unique<token_table>(std::move(tokens));
+	replay_next_ = 0;
+
+	if (capacity)
+		pipeline(capacity);
+}
+
+void lexer::pipeline(std::size_t capacity) {
+	if (pipeline_)
+		return;
+
+	pipeline_ = std::make_unique<pipeline_state>(capacity);
+	save_into(pipeline_->after);
+	pipeline_->producer = std::thread([this] { produce(); });
+}
+
+std::size_t lexer::offset() const noexcept {
+	return pipeline_ ? pipeline_->after.offset_ : gpos_.offset;
+}
+
+void lexer::set_diagnostic_sink(diagnostic_sink* sink) noexcept {
+	diagnostics_ = sink;
+}
+
+bool lexer::read(token& into) {
+	return pipeline_ ? read_pipelined(into) : scan(into);
+}
+
+bool lexer::read_pipelined(token& into) {
+	auto& state = *pipeline_;
+	if (state.done)
+		return false;
+
+	auto& slot = state.ring.front();
+	if (slot.error) {
+		auto error = std::exchange(slot.error, nullptr);
+		state.done = true;
+		state.ring.release();
+		std::rethrow_exception(error);
+	}
+
+	// swapping hands the old token and checkpoint back to be lexed over
+	auto more = slot.more;
+	if (more)
+		std::swap(into, slot.value);
+	else
+		state.done = true;
+	std::swap(state.after, slot.after);
+	state.ring.release();
+
+	return more;
+}
+
+void lexer::produce() {
+	auto& ring = pipeline_->ring;
+	auto slot = ring.acquire();
+	try {
+		for (; slot; slot = ring.acquire()) {
+			slot->more = scan(slot->value);
+			save_into(slot->after);
+			ring.publish();
+
+			if (!slot->more)
+				return;
+		}
+	} catch (...) {
+		// the slot of the token that failed wasn't published
+		slot->error = std::current_exception();
+		ring.publish();
+	}
+}
+
+std::size_t lexer::stop_pipeline() noexcept {
+	if (!pipeline_)
+		return 0;
+
+	pipeline_->ring.close();
+	pipeline_->producer.join();
+
+	auto capacity = pipeline_->ring.capacity();
+	pipeline_.reset();
+	return capacity;
+}
+
+lexer::checkpoint lexer::save() const {
+	if (pipeline_)
+		return pipeline_->after;
+
+	checkpoint result;
+	save_into(result);
+	return result;
+}
+
+void lexer::save_into(checkpoint& into) const {
+	into.offset_ = gpos_.offset;
+	into.reach_ = reach_;
+	into.force_identifier_ = force_identifier_;
+	into.pnewline_ = pnewline_;
+
+	into.contexts_.resize(context_stack_.size());
+	for (std::size_t i = 0; i < context_stack_.size(); ++i) {
+		auto& [kind, entry] = context_stack_[i];
+		into.contexts_[i].kind = kind;
+		into.contexts_[i].offset = entry.location.offset();
+		into.contexts_[i].text = entry.text;
+	}
+}
+
+void lexer::restore(const checkpoint& from) {
+	if (stream_)
+		throw std::logic_error("only a lexer over a buffer can be restored");
+	if (from.offset_ > input_.size())
+		throw std::out_of_range("the checkpoint is past the end of the input");
+
+	auto capacity = stop_pipeline();
+
+	gpos_.offset = from.offset_;
+	buffer_offset_ = from.offset_;
+	validated_begin_ = 0;
+	validated_end_ = 0;
+	reach_ = from.reach_;
+	force_identifier_ = from.force_identifier_;
+	pnewline_ = from.pnewline_;
+
+	context_stack_.clear();
+	for (auto& context : from.contexts_) {
+		context_stack_.emplace_back(
+			context.kind,
+			stack_entry{source_location{file_, context.offset}, context.text});
+	}
+
+	replay_.reset();
+
+	if (capacity)
+		pipeline(capacity);
+}
+
+bool lexer::checkpoint::same_state(const checkpoint& other) const noexcept {
+	return force_identifier_ == other.force_identifier_ &&
+		   pnewline_ == other.pnewline_ && contexts_ == other.contexts_;
+}
+
+void lexer::checkpoint::shift(std::size_t edit_offset,
+							  std::size_t removed,
+							  std::size_t inserted) noexcept {
+	auto move = [=](std::size_t& offset) {
+		if (offset >= edit_offset + removed)
+			offset = offset - removed + inserted;
+		else if (offset > edit_offset)
+			offset = edit_offset;
+	};
+
+	move(offset_);
+	move(reach_);
+	for (auto& context : contexts_)
+		move(context.offset);
+}
+
+bool lexer::scan_replayed(token& into) {
+	if (replay_next_ == replay_->size())
+		return false;
+
+	auto view = (*replay_)[replay_next_++];
+	into = view.materialize();
+	gpos_.offset = view.offset() + view.length();
+	return true;
+}
+
+template <typename CharT>
+const lexer::versioned_keyword* lexer::find_keyword(
+	std::basic_string_view<CharT> identifier) noexcept {
+	static constexpr std::array<versioned_keyword, 83> keywords{{
+		{"abstract",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::abstract_token>(location);
+		 },
+		 language_version::es3},
+		{"accessor",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::accessor_token>(location);
+		 },
+		 language_version::es3},
+		{"any",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::any_token>(location);
+		 },
+		 language_version::es3},
+		{"as",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::as_token>(location);
+		 },
+		 language_version::es3},
+		{"asserts",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::asserts_token>(location);
+		 },
+		 language_version::es3},
+		{"assert",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::assert_token>(location);
+		 },
+		 language_version::es3},
+		{"async",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::async_token>(location);
+		 },
+		 language_version::es2015},
+		{"await",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::await_token>(location);
+		 },
+		 language_version::es2015},
+		{"bigint",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::bigint_token>(location);
+		 },
+		 language_version::es3},
+		{"boolean",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::boolean_token>(location);
+		 },
+		 language_version::es3},
+		{"break",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::break_token>(location);
+		 },
+		 language_version::es3},
+		{"case",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::case_token>(location);
+		 },
+		 language_version::es3},
+		{"catch",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::catch_token>(location);
+		 },
+		 language_version::es3},
+		{"class",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::class_token>(location);
+		 },
+		 language_version::es2015},
+		{"continue",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::continue_token>(location);
+		 },
+		 language_version::es3},
+		{"const",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::const_token>(location);
+		 },
+		 language_version::es2015},
+		{"constructor",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::constructor_token>(location);
+		 },
+		 language_version::es3},
+		{"debugger",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::debugger_token>(location);
+		 },
+		 language_version::es3},
+		{"declare",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::declare_token>(location);
+		 },
+		 language_version::es3},
+		{"default",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::default_token>(location);
+		 },
+		 language_version::es2015},
+		{"delete",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::delete_token>(location);
+		 },
+		 language_version::es3},
+		{"do",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::do_token>(location);
+		 },
+		 language_version::es3},
+		{"else",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::else_token>(location);
+		 },
+		 language_version::es3},
+		{"enum",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::enum_token>(location);
+		 },
+		 language_version::es3},
+		{"export",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::export_token>(location);
+		 },
+		 language_version::es2015},
+		{"extends",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::extends_token>(location);
+		 },
+		 language_version::es2015},
+		{"false",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::false_token>(location);
+		 },
+		 language_version::es3},
+		{"finally",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::finally_token>(location);
+		 },
+		 language_version::es3},
+		{"for",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::for_token>(location);
+		 },
+		 language_version::es3},
+		{"from",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::from_token>(location);
+		 },
+		 language_version::es2015},
+		{"function",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::function_token>(location);
+		 },
+		 language_version::es3},
+		{"get",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::get_token>(location);
+		 },
+		 language_version::es5},
+		{"global",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::global_token>(location);
+		 },
+		 language_version::es3},
+		{"if",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::if_token>(location);
+		 },
+		 language_version::es3},
+		{"implements",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::implements_token>(location);
+		 },
+		 language_version::es3},
+		{"import",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::import_token>(location);
+		 },
+		 language_version::es2015},
+		{"in",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::in_token>(location);
+		 },
+		 language_version::es3},
+		{"infer",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::infer_token>(location);
+		 },
+		 language_version::es3},
+		{"instanceof",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::instanceof_token>(location);
+		 },
+		 language_version::es3},
+		{"interface",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::interface_token>(location);
+		 },
+		 language_version::es3},
+		{"intrinsic",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::intrinsic_token>(location);
+		 },
+		 language_version::es3},
+		{"is",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::is_token>(location);
+		 },
+		 language_version::es3},
+		{"keyof",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::keyof_token>(location);
+		 },
+		 language_version::es3},
+		{"let",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::let_token>(location);
+		 },
+		 language_version::es2015},
+		{"module",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::module_token>(location);
+		 },
+		 language_version::es3},
+		{"namespace",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::namespace_token>(location);
+		 },
+		 language_version::es3},
+		{"never",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::never_token>(location);
+		 },
+		 language_version::es3},
+		{"new",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::new_token>(location);
+		 },
+		 language_version::es3},
+		{"null",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::null_token>(location);
+		 },
+		 language_version::es3},
+		{"number",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::number_token>(location);
+		 },
+		 language_version::es3},
+		{"of",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::of_token>(location);
+		 },
+		 language_version::es2015},
+		{"object",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::object_token>(location);
+		 },
+		 language_version::es3},
+		{"package",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::package_token>(location);
+		 },
+		 language_version::es3},
+		{"private",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::private_token>(location);
+		 },
+		 language_version::es3},
+		{"protected",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::protected_token>(location);
+		 },
+		 language_version::es3},
+		{"public",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::public_token>(location);
+		 },
+		 language_version::es3},
+		{"override",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::override_token>(location);
+		 },
+		 language_version::es3},
+		{"out",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::out_token>(location);
+		 },
+		 language_version::es3},
+		{"readonly",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::readonly_token>(location);
+		 },
+		 language_version::es3},
+		{"require",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::require_token>(location);
+		 },
+		 language_version::es3},
+		{"return",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::return_token>(location);
+		 },
+		 language_version::es3},
+		{"satisfies",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::satisfies_token>(location);
+		 },
+		 language_version::es3},
+		{"set",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::set_token>(location);
+		 },
+		 language_version::es5},
+		{"static",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::static_token>(location);
+		 },
+		 language_version::es2015},
+		{"string",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::string_token>(location);
+		 },
+		 language_version::es3},
+		{"super",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::super_token>(location);
+		 },
+		 language_version::es2015},
+		{"switch",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::switch_token>(location);
+		 },
+		 language_version::es3},
+		{"symbol",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::symbol_token>(location);
+		 },
+		 language_version::es2015},
+		{"this",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::this_token>(location);
+		 },
+		 language_version::es3},
+		{"throw",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::throw_token>(location);
+		 },
+		 language_version::es3},
+		{"true",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::true_token>(location);
+		 },
+		 language_version::es3},
+		{"try",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::try_token>(location);
+		 },
+		 language_version::es3},
+		{"type",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::type_token>(location);
+		 },
+		 language_version::es3},
+		{"typeof",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::typeof_token>(location);
+		 },
+		 language_version::es3},
+		{"undefined",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::undefined_token>(location);
+		 },
+		 language_version::es3},
+		{"unique",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::unique_token>(location);
+		 },
+		 language_version::es3},
+		{"unknown",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::unknown_token>(location);
+		 },
+		 language_version::es3},
+		{"using",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::using_token>(location);
+		 },
+		 language_version::es2022},
+		{"var",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::var_token>(location);
+		 },
+		 language_version::es3},
+		{"void",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::void_token>(location);
+		 },
+		 language_version::es3},
+		{"while",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::while_token>(location);
+		 },
+		 language_version::es3},
+		{"with",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::with_token>(location);
+		 },
+		 language_version::es3},
+		{"yield",
+		 [](token& into, const source_location& location) {
+			 into.emplace_token<tokens::yield_token>(location);
+		 },
+		 language_version::es2015}}};
+
+	static constexpr detail::keyword_hash<keywords.size()> table{[] {
+		std::array<std::string_view, keywords.size()> names;
+		for (std::size_t i = 0; i < keywords.size(); i++)
+			names[i] = keywords[i].name;
+		return names;
+	}()};
+
+	auto index = table.find(identifier);
+	return index ? &keywords[*index] : nullptr;
+}
 
 inline std::size_t lexer::next_code_point(char32_t& into,
 										  std::size_t look_forward) {
+	// the longest sequence is 4 bytes, which is close enough for knowing
+	// which text the tokens so far depend on
+	reach_ = std::max(reach_, gpos_.offset + look_forward + 4);
+
 	auto read_more = [this](std::size_t needed) -> std::size_t {
-		if (stream_.eof())
+		// a contiguous buffer is already entirely resident
+		if (!stream_ || stream_->eof())
 			return 0;
 
 		auto sn = needed;
 		while (true) {
-			auto preserve_size = rbuffer_.size() - buffer_offset_;
+			auto preserve_size = input_.size() - buffer_offset_;
 			memmove(rbuffer_.data(), rbuffer_.data() + buffer_offset_,
 					preserve_size);
+			validated_begin_ = validated_begin_ > buffer_offset_
+								   ? validated_begin_ - buffer_offset_
+								   : 0;
+			validated_end_ =
+				validated_end_ > buffer_offset_ ? validated_end_ - buffer_offset_
+											   : 0;
 			buffer_offset_ = 0;
 
 			rbuffer_.resize(buffer_size);
-			auto read = stream_.readsome(
+			auto read = stream_->readsome(
 				rbuffer_.data() + preserve_size,
 				static_cast<std::streamsize>(buffer_size - preserve_size));
 
 			if (read <= 0) {
 				rbuffer_.resize(preserve_size);
+				input_ = rbuffer_;
 				return sn - needed;
 			}
 
 			rbuffer_.resize(preserve_size + read);
+			input_ = rbuffer_;
+			lines_->scan(input_.substr(preserve_size),
+						 gpos_.offset + preserve_size);
 			needed -= std::min(needed, static_cast<std::size_t>(read));
 
 			if (!needed)
@@ -559,201 +885,88 @@ inline std::size_t lexer::next_code_point(char32_t& into,
 		}
 	};
 
-	if ((buffer_offset_ + look_forward) >= rbuffer_.size()) {
-		if (!read_more(1))
-			return 0;
-	}
-
-	// get one character
-	auto chr0 =
-		static_cast<unsigned char>(rbuffer_[buffer_offset_ + look_forward]);
-	// if the value is either below 0x7f or isn't a valid utf-8 codepoint
-	if (chr0 <= 0x7f || (chr0 & 0xc0) != 0xc0) {
-		into = chr0;
-		return 1;
-	}
-
-	if ((chr0 & 0xe0) == 0xc0) {
-		// 2 characters -> 11 bits
-		if ((buffer_offset_ + look_forward + 1) >= rbuffer_.size() &&
-			read_more(1) < 1) {
-			into = chr0;
-			return 1;
-		}
-
-		auto chr1 = static_cast<unsigned char>(
-			rbuffer_[buffer_offset_ + look_forward + 1]);
-		if ((chr1 & 0xc0) != 0x80) {
-			into = chr0;
-			return 1;
-		}
-
-		into = (static_cast<char32_t>(chr0 & 0x1f) << 6) |
-			   static_cast<char32_t>(chr1 & 0x3f);
-		return 2;
-	}
-
-	if ((chr0 & 0xf0) == 0xe0) {
-		// 3 characters -> 16 bits
-		if ((buffer_offset_ + look_forward + 2) >= rbuffer_.size() &&
-			read_more(2) < 2) {
-			into = chr0;
-			return 1;
-		}
-
-		auto chr1 = static_cast<unsigned char>(
-			rbuffer_[buffer_offset_ + look_forward + 1]);
-		if ((chr1 & 0xc0) != 0x80) {
-			into = chr0;
-			return 1;
-		}
-
-		auto chr2 = static_cast<unsigned char>(
-			rbuffer_[buffer_offset_ + look_forward + 2]);
-		if ((chr2 & 0xc0) != 0x80) {
-			into = chr0;
-			return 1;
-		}
-
-		into = (static_cast<char32_t>(chr0 & 0x0f) << 12) |
-			   (static_cast<char32_t>(chr1 & 0x3f) << 6) |
-			   static_cast<char32_t>(chr2 & 0x3f);
-		return 3;
-	}
-
-	if ((chr0 & 0xf8) == 0xf0) {
-		// 4 characters -> 21 bits
-		if ((buffer_offset_ + look_forward + 3) >= rbuffer_.size() &&
-			read_more(3) < 3) {
-			into = chr0;
-			return 1;
-		}
+	// well-formed input only needs the lead byte to know the length of the
+	// sequence
+	auto decode = [this](std::size_t at, char32_t& into) -> std::size_t {
+		auto lead = static_cast<unsigned char>(input_[at]);
+		auto tail = [this, at](std::size_t i) {
+			return static_cast<char32_t>(input_[at + i] & 0x3f);
+		};
 
-		auto chr1 = static_cast<unsigned char>(
-			rbuffer_[buffer_offset_ + look_forward + 1]);
-		if ((chr1 & 0xc0) != 0x80) {
-			into = chr0;
+		if (lead <= 0x7f) {
+			into = lead;
 			return 1;
 		}
 
-		auto chr2 = static_cast<unsigned char>(
-			rbuffer_[buffer_offset_ + look_forward + 2]);
-		if ((chr2 & 0xc0) != 0x80) {
-			into = chr0;
-			return 1;
+		if (lead < 0xe0) {
+			into = (static_cast<char32_t>(lead & 0x1f) << 6) | tail(1);
+			return 2;
 		}
 
-		auto chr3 = static_cast<unsigned char>(
-			rbuffer_[buffer_offset_ + look_forward + 3]);
-		if ((chr3 & 0xc0) != 0x80) {
-			into = chr0;
-			return 1;
+		if (lead < 0xf0) {
+			into = (static_cast<char32_t>(lead & 0x0f) << 12) |
+				   (tail(1) << 6) | tail(2);
+			return 3;
 		}
 
-		into = (static_cast<char32_t>(chr0 & 0x07) << 18) |
-			   (static_cast<char32_t>(chr1 & 0x3f) << 12) |
-			   (static_cast<char32_t>(chr2 & 0x3f) << 6) |
-			   static_cast<char32_t>(chr3 & 0x3f);
+		into = (static_cast<char32_t>(lead & 0x07) << 18) | (tail(1) << 12) |
+			   (tail(2) << 6) | tail(3);
 		return 4;
-	}
-
-	if ((chr0 & 0xfc) == 0xf8) {
-		// 5 characters -> 26 bits
-		if ((buffer_offset_ + look_forward + 4) >= rbuffer_.size() &&
-			read_more(4) < 4) {
-			into = chr0;
-			return 1;
-		}
-
-		auto chr1 = static_cast<unsigned char>(
-			rbuffer_[buffer_offset_ + look_forward + 1]);
-		if ((chr1 & 0xc0) != 0x80) {
-			into = chr0;
-			return 1;
-		}
+	};
 
-		auto chr2 = static_cast<unsigned char>(
-			rbuffer_[buffer_offset_ + look_forward + 2]);
-		if ((chr2 & 0xc0) != 0x80) {
-			into = chr0;
-			return 1;
-		}
+	// fast path - inside the validated region
+	auto at = buffer_offset_ + look_forward;
+	if (at < validated_begin_ || at >= validated_end_)
+		extend_validated_input(at);
 
-		auto chr3 = static_cast<unsigned char>(
-			rbuffer_[buffer_offset_ + look_forward + 3]);
-		if ((chr3 & 0xc0) != 0x80) {
-			into = chr0;
-			return 1;
-		}
+	if (at >= validated_begin_ && at < validated_end_)
+		return decode(at, into);
 
-		auto chr4 = static_cast<unsigned char>(
-			rbuffer_[buffer_offset_ + look_forward + 4]);
-		if ((chr4 & 0xc0) != 0x80) {
-			into = chr0;
-			return 1;
-		}
-
-		into = (static_cast<char32_t>(chr0 & 0x03) << 24) |
-			   (static_cast<char32_t>(chr1 & 0x3f) << 18) |
-			   (static_cast<char32_t>(chr2 & 0x3f) << 12) |
-			   (static_cast<char32_t>(chr3 & 0x3f) << 6) |
-			   static_cast<char32_t>(chr4 & 0x3f);
-		return 5;
+	// slow path - malformed input or a sequence split across a stream refill
+	if ((buffer_offset_ + look_forward) >= input_.size()) {
+		if (!read_more(1))
+			return 0;
 	}
 
-	if ((chr0 & 0xfe) == 0xfc) {
-		// 6 characters -> 31 bits
-		if ((buffer_offset_ + look_forward + 5) >= rbuffer_.size() &&
-			read_more(5) < 5) {
-			into = chr0;
-			return 1;
-		}
-
-		auto chr1 = static_cast<unsigned char>(
-			rbuffer_[buffer_offset_ + look_forward + 1]);
-		if ((chr1 & 0xc0) != 0x80) {
+	auto chr0 =
+		static_cast<unsigned char>(input_[buffer_offset_ + look_forward]);
+	if (chr0 > 0x7f) {
+		// make sure the whole sequence is resident before validating it
+		std::size_t length = chr0 >= 0xf0 ? 4 : chr0 >= 0xe0 ? 3 : 2;
+		auto available = input_.size() - (buffer_offset_ + look_forward);
+		if (available < length)
+			read_more(length - available);
+
+		auto sequence = input_.substr(buffer_offset_ + look_forward, length);
+		if (tscc::utf8_valid_prefix_length(sequence) != length) {
+			// malformed bytes are taken one at a time as raw values
 			into = chr0;
 			return 1;
 		}
+	}
 
-		auto chr2 = static_cast<unsigned char>(
-			rbuffer_[buffer_offset_ + look_forward + 2]);
-		if ((chr2 & 0xc0) != 0x80) {
-			into = chr0;
-			return 1;
-		}
+	return decode(buffer_offset_ + look_forward, into);
+}
 
-		auto chr3 = static_cast<unsigned char>(
-			rbuffer_[buffer_offset_ + look_forward + 3]);
-		if ((chr3 & 0xc0) != 0x80) {
-			into = chr0;
-			return 1;
-		}
+void lexer::extend_validated_input(std::size_t from) {
+	static constexpr std::size_t validation_chunk = 64 * 1024;
 
-		auto chr4 = static_cast<unsigned char>(
-			rbuffer_[buffer_offset_ + look_forward + 4]);
-		if ((chr4 & 0xc0) != 0x80) {
-			into = chr0;
-			return 1;
-		}
+	if (from >= input_.size())
+		return;
 
-		auto chr5 = static_cast<unsigned char>(
-			rbuffer_[buffer_offset_ + look_forward + 5]);
-		if ((chr5 & 0xc0) != 0x80) {
-			into = chr0;
-			return 1;
-		}
+	// keep growing the current region when we're right at its end, otherwise
+	// start a new one since the bytes in between were never checked
+	if (from != validated_end_ || validated_begin_ == validated_end_)
+		validated_begin_ = from;
 
-		into = (static_cast<char32_t>(chr0 & 0x01) << 30) |
-			   (static_cast<char32_t>(chr1 & 0x3f) << 24) |
-			   (static_cast<char32_t>(chr2 & 0x3f) << 18) |
-			   (static_cast<char32_t>(chr3 & 0x3f) << 12) |
-			   (static_cast<char32_t>(chr4 & 0x3f) << 6) |
-			   static_cast<char32_t>(chr5 & 0x3f);
-		return 6;
-	}
+	validated_end_ = from + tscc::utf8_valid_prefix_length(
+								input_.substr(from, validation_chunk));
+}
 
-	return chr0;
+std::size_t lexer::ascii_run_to_eol(char stop) const {
+	// a single bounded pass - in buffer mode the window is the rest of the
+	// file so it must never be searched past the first byte that ends the run
+	return tscc::ascii_run_length(input_.substr(buffer_offset_), '\n', stop);
 }
 
 void lexer::scan_shebang(std::size_t shebang_offset, token& into) {
@@ -802,7 +1015,6 @@ void lexer::scan_string(token& into) {
 						auto nnnc = next_code_point(third);
 						if (nc && third == '\n') {
 							advance(nnc + nnnc);
-							gpos_.advance_line();
 							goto scan_next_char;
 						}
 
@@ -812,7 +1024,6 @@ void lexer::scan_string(token& into) {
 
 					if (second == '\n') {
 						advance(nnc);
-						gpos_.advance_line();
 						goto scan_next_char;
 					}
 				}
@@ -895,7 +1106,6 @@ void lexer::scan_template_string_part(token& into) {
 				// below
 				first = second;
 				advance(nc + gc);
-				gpos_.advance_line();
 				append_wbuffer(second);
 				continue;
 			}
@@ -903,8 +1113,6 @@ void lexer::scan_template_string_part(token& into) {
 			advance(nc + scan_escape_sequence(first));
 			append_wbuffer(first);
 		} else {
-			if (first == '\n')
-				gpos_.advance_line();
 			advance(nc);
 			append_wbuffer(first);
 		}
@@ -925,7 +1133,7 @@ std::size_t lexer::scan_escape_sequence(char32_t& into, std::size_t skip) {
 			is_curly_braced = true;
 		}
 
-		long long ucfirst;
+		tscc_big_int ucfirst;
 		auto scanned = scan_hex_number(ucfirst, is_curly_braced ? 1 : 4,
 									   is_curly_braced, false, gc + skip);
 
@@ -948,7 +1156,7 @@ std::size_t lexer::scan_escape_sequence(char32_t& into, std::size_t skip) {
 				throw unicode_value_out_of_range(location());
 			}
 
-			into = ucfirst;
+			into = small_value(ucfirst);
 			return gc + scanned + cc;
 		}
 
@@ -957,52 +1165,54 @@ std::size_t lexer::scan_escape_sequence(char32_t& into, std::size_t skip) {
 			throw unicode_value_out_of_range(location());
 		}
 
-		if ((ucfirst >> 11) != 0x1b) {
-			into = ucfirst;
+		auto first_unit = small_value(ucfirst);
+		if ((first_unit >> 11) != 0x1b) {
+			into = first_unit;
 			return gc + scanned;
 		}
 
 		char32_t next;
 		auto nnc = next_code_point(next, gc + skip + scanned);
 		if (!nnc || next != '\\') {
-			into = ucfirst;
+			into = first_unit;
 			return gc + scanned;
 		}
 
 		char32_t checku;
 		auto checkuc = next_code_point(checku, gc + skip + scanned + nnc);
 		if (!checkuc || (checku != 'u' && checku != 'U')) {
-			into = ucfirst;
+			into = first_unit;
 			return gc + scanned;
 		}
 
 		try {
-			long long ucsecond;
+			tscc_big_int ucsecond;
 			auto nscanned = scan_hex_number(
 				ucsecond, 4, false, false, gc + skip + scanned + nnc + checkuc);
-			if (ucsecond <= 0xFFFF && nscanned && (ucsecond >> 10) == 0x37) {
-				into =
-					(((ucfirst & 0x3ff) << 10) | (ucsecond & 0x3ff)) + 0x10000;
+			auto second_unit = small_value(ucsecond);
+			if (ucsecond <= 0xFFFF && nscanned && (second_unit >> 10) == 0x37) {
+				into = (((first_unit & 0x3ff) << 10) | (second_unit & 0x3ff)) +
+					   0x10000;
 				return gc + scanned + nnc + checkuc + nscanned;
 			}
 		} catch (...) {
 			// ignore errors in the subsequent section at this scope
 		}
 
-		into = ucfirst;
+		into = first_unit;
 		return gc + scanned;
 	}
 
 	if (into == 'x' || into == 'X') {
 		// handle 1 byte hex identifier
-		long long hexfirst;
+		tscc_big_int hexfirst;
 		auto scanned = scan_hex_number(hexfirst, 2, false, false, gc + skip);
 
 		if (!scanned || hexfirst > 0xFF) {
 			return gc + skip;
 		}
 
-		into = hexfirst;
+		into = small_value(hexfirst);
 		return scanned;
 	}
 
@@ -1011,20 +1221,20 @@ std::size_t lexer::scan_escape_sequence(char32_t& into, std::size_t skip) {
 		char32_t next;
 		auto nnc = next_code_point(next, gc + skip);
 		if (nnc == 'b' || nnc == 'B') {
-			long long number;
+			tscc_big_int number;
 			auto scanned = scan_binary_number(number, false, gc + nnc + skip);
 			if (scanned && number < 0x7f000000ll) {
-				into = static_cast<char32_t>(number);
+				into = small_value(number);
 				return scanned;
 			}
 
 			return gc + skip;
 		}
 
-		long long number;
+		tscc_big_int number;
 		auto scanned = scan_octal_number(number, false, false, skip);
 		if (scanned && number < 0x7f000000ll) {
-			into = static_cast<char32_t>(number);
+			into = small_value(number);
 			return scanned;
 		}
 
@@ -1032,10 +1242,10 @@ std::size_t lexer::scan_escape_sequence(char32_t& into, std::size_t skip) {
 	}
 
 	if (is_octal_digit(into)) {
-		long long number;
+		tscc_big_int number;
 		auto scanned = scan_octal_number(number, false, false, gc + skip);
 		if (scanned && number < 0x7f000000ll) {
-			into = static_cast<char32_t>(number);
+			into = small_value(number);
 			return scanned;
 		}
 
@@ -1088,6 +1298,12 @@ void lexer::scan_multiline_comment(token& into, bool is_jsdoc) {
 
 	char32_t first{};
 	while (true) {
+		if (auto run = ascii_run_to_eol('*')) {
+			wbuffer_.append(input_.begin() + buffer_offset_,
+							input_.begin() + buffer_offset_ + run);
+			advance(run);
+		}
+
 		auto nc = next_code_point(first);
 		if (!nc) {
 			throw unterminated_multiline_comment(comment_location);
@@ -1102,7 +1318,6 @@ void lexer::scan_multiline_comment(token& into, bool is_jsdoc) {
 			}
 
 			wbuffer_.erase(end);
-			gpos_.advance_line();
 
 			if (multiline_buffer_.size() == multiline_index) {
 				std::size_t new_size = multiline_buffer_.size() >= 1024
@@ -1227,6 +1442,10 @@ void lexer::scan_decimal_token(token& into) {
 
 	auto last_separator = location();
 
+	// the literal without its separators, which is what a decimal is parsed
+	// from
+	number_buffer_.clear();
+
 	char32_t first{};
 	while (true) {
 		nc = next_code_point(first);
@@ -1258,7 +1477,8 @@ void lexer::scan_decimal_token(token& into) {
 
 		is_first_character = false;
 		advance(nc);
-		number_part = (number_part * 10) + decimal_value(first);
+		number_part.multiply_add(10, decimal_value(first));
+		number_buffer_ += static_cast<char>(first);
 		last_was_separator = false;
 	}
 
@@ -1266,12 +1486,11 @@ void lexer::scan_decimal_token(token& into) {
 		throw separators_not_allowed_here{last_separator};
 	}
 
+	bool is_decimal = false;
 	if (nc && first == U'.') {
 		advance(nc);
-
-		// parse as a decimal
-		long double numerator = 0;
-		long long numerator_e = 0;
+		number_buffer_ += '.';
+		is_decimal = true;
 
 		while (true) {
 			nc = next_code_point(first);
@@ -1288,109 +1507,39 @@ void lexer::scan_decimal_token(token& into) {
 			}
 
 			advance(nc);
-			numerator = (numerator * 10) + decimal_value(first);
-			--numerator_e;
+			number_buffer_ += static_cast<char>(first);
 		}
-
-		auto value = static_cast<long double>(number_part) +
-					 (numerator * std::pow(10.0L, numerator_e));
-		if (nc && (first == 'e' || first == 'E')) {
-			advance(nc);
-			bool is_upper = first == 'E';
-
-			nc = next_code_point(first);
-			if (!nc) {
-				throw invalid_identifier(number_location);
-			}
-
-			long long exponent = 1;
-
-			switch (first) {
-				case U'_':
-					throw separators_not_allowed_here{location()};
-				case U'-':
-					exponent = -1;
-				case U'+':
-					advance(nc);
-
-					nc = next_code_point(first);
-					if (!nc || !is_decimal_digit(first)) {
-						throw invalid_identifier(number_location);
-					}
-
-					exponent *= decimal_value(first);
-					break;
-				default:
-					if (!is_decimal_digit(first)) {
-						throw invalid_identifier(number_location);
-					}
-					exponent = decimal_value(first);
-			}
-
-			advance(nc);
-
-			// this is a double with an e value
-			while (true) {
-				nc = next_code_point(first);
-				if (!nc || !is_decimal_digit(first)) {
-					if (nc && first == U'_') {
-						throw separators_not_allowed_here{location()};
-					}
-
-					break;
-				}
-
-				advance(nc);
-				exponent = (exponent * 10) + decimal_value(first);
-			}
-
-			into.emplace_token<tokens::constant_value_token>(
-				number_location, value, static_cast<int>(exponent), is_upper);
-		} else {
-			into.emplace_token<tokens::constant_value_token>(number_location,
-															 value);
-		}
-
-		return;
 	}
 
 	if (nc && (first == 'e' || first == 'E')) {
 		advance(nc);
-		bool is_upper = first == 'E';
+		number_buffer_ += static_cast<char>(first);
+		is_decimal = true;
 
 		nc = next_code_point(first);
 		if (!nc) {
 			throw invalid_identifier(number_location);
 		}
 
-		long long sign = 1;
-		long long exponent = 1;
-
 		switch (first) {
-			case '-':
-				sign = -1;
-				exponent = -1;
-				[[fallthrough]];
-			case '+':
+			case U'_':
+				throw separators_not_allowed_here{location()};
+			case U'-':
+			case U'+':
 				advance(nc);
+				number_buffer_ += static_cast<char>(first);
 
 				nc = next_code_point(first);
 				if (!nc || !is_decimal_digit(first)) {
 					throw invalid_identifier(number_location);
 				}
-
-				exponent *= decimal_value(first);
 				break;
 			default:
 				if (!is_decimal_digit(first)) {
 					throw invalid_identifier(number_location);
 				}
-				exponent = decimal_value(first);
 		}
 
-		advance(nc);
-
-		// this is an integer with an e value - convert to long double
 		while (true) {
 			nc = next_code_point(first);
 			if (!nc || !is_decimal_digit(first)) {
@@ -1402,12 +1551,13 @@ void lexer::scan_decimal_token(token& into) {
 			}
 
 			advance(nc);
-			exponent = (exponent * 10) + (sign * decimal_value(first));
+			number_buffer_ += static_cast<char>(first);
 		}
+	}
 
+	if (is_decimal) {
 		into.emplace_token<tokens::constant_value_token>(
-			number_location, static_cast<long double>(number_part),
-			static_cast<int>(exponent), is_upper);
+			number_location, parse_decimal(number_buffer_), number_buffer_);
 		return;
 	}
 
@@ -1584,7 +1734,6 @@ void lexer::scan_jsx_element_part(token& into) {
 
 		auto nc = next_code_point(next);
 		if (next == U'\n') {
-			gpos_.advance_line();
 			advance(nc);
 			continue;
 		}
@@ -1650,9 +1799,6 @@ void lexer::scan_jsx_element_part(token& into) {
 
 		if (std::iswspace(next)) {
 			advance(nc);
-			if (next == U'\n') {
-				gpos_.advance_line();
-			}
 			end_of_name = true;
 			continue;
 		}
@@ -1679,11 +1825,7 @@ void lexer::scan_jsx_attribute_part(token& into) {
 	auto nc = next_code_point(next);
 
 	while (std::iswspace(next)) {
-		if (next == U'\n') {
-			gpos_.advance_line();
-		} else {
-			advance(nc);
-		}
+		advance(nc);
 		nc = next_code_point(next);
 	}
 
@@ -1806,15 +1948,12 @@ auto nc = next_code_point(next);
 			throw unexpected_end_of_text(context_stack_.back().second.location);
 		}
 
-		if (next == U'\n') {
-			gpos_.advance_line();
-		} else if (next == U'\r') {
+		if (next == U'\r') {
 			char32_t check{};
 			auto gc = next_code_point(check);
 			if (gc && next == U'\n') {
 				advance(nc);
 				next = check;
-				gpos_.advance_line();
 			}
 		} else if (next == '{') {
 			try {
@@ -1950,6 +2089,20 @@ bool lexer::try_scan_regex(token& into) {
 end_flags:
 	tsccore::regex::regular_expression regex;
 	tsccore::regex::scan(std::u32string_view(wbuffer_), regex);
+
+	if (diagnostics_) {
+		auto match_flags = tsccore::regex::match_flags::none;
+		if (has_flag(flags, tokens::regex_token::flags::ignore_case))
+			match_flags = match_flags | tsccore::regex::match_flags::ignore_case;
+		if (has_flag(flags, tokens::regex_token::flags::dot_all))
+			match_flags = match_flags | tsccore::regex::match_flags::dot_all;
+
+		for (auto& hazard :
+			 tsccore::regex::find_backtracking_hazards(regex, match_flags))
+			diagnostics_->report(
+				catastrophic_backtracking(regex_location, hazard));
+	}
+
 	advance(total_skip);
 	into.emplace_token<tokens::regex_token>(regex_location, std::move(regex),
 											flags);
@@ -1973,8 +2126,8 @@ std::size_t lexer::scan_hex_number(tscc_big_int& into,
 	std::size_t hex_digits = 0;
 	bool prior_was_separator = false;
 	bool at_first_char = true;
-	char32_t value = 0;
 	size_t nc = 0;
+	into = 0;
 
 	// Read hex digits until we have enough or hit a non-hex character
 	while (true) {
@@ -2008,17 +2161,17 @@ std::size_t lexer::scan_hex_number(tscc_big_int& into,
 
 		// Convert hex digit to value
 		if (ch >= '0' && ch <= '9') {
-			value = (value << 4) | (ch - '0');
+			into.multiply_add(16, ch - '0');
 		} else if (ch >= 'A' && ch <= 'F') {
-			value = (value << 4) | (ch - 'A' + 10);
+			into.multiply_add(16, ch - 'A' + 10);
 		} else if (ch >= 'a' && ch <= 'f') {
-			value = (value << 4) | (ch - 'a' + 10);
+			into.multiply_add(16, ch - 'a' + 10);
 		} else if (ch >= 0xff10 && ch <= 0xff19) {
-			value = (value << 4) | (ch - 0xff10);
+			into.multiply_add(16, ch - 0xff10);
 		} else if (ch >= 0xff21 && ch <= 0xff26) {
-			value = (value << 4) | (ch - 0xff21 + 10);
+			into.multiply_add(16, ch - 0xff21 + 10);
 		} else if (ch >= 0xff41 && ch <= 0xff46) {
-			value = (value << 4) | (ch - 0xff41 + 10);
+			into.multiply_add(16, ch - 0xff41 + 10);
 		}
 
 		hex_digits++;
@@ -2039,7 +2192,6 @@ std::size_t lexer::scan_hex_number(tscc_big_int& into,
 		throw hexidecimal_digit_expected(location() + total_skip);
 	}
 
-	into = value;
 	return total_skip - skip;
 }
 
@@ -2086,7 +2238,7 @@ std::size_t lexer::scan_octal_number(tscc_big_int& into,
 
 		prior_was_separator = false;
 		at_first_char = false;
-		into = (into * 8) + decimal_value(first);
+		into.multiply_add(8, decimal_value(first));
 		taken += nc;
 	}
 
@@ -2134,7 +2286,7 @@ std::size_t lexer::scan_binary_number(tscc_big_int& into,
 		if (first != U'0' && first != U'1')
 			break;
 
-		into = (into * 2) + (first - U'0');
+		into.multiply_add(2, first - U'0');
 		taken += nc;
 	}
 
@@ -2149,15 +2301,17 @@ std::size_t lexer::scan_unicode_escape_into_wbuffer(
 	std::size_t min_size,
 	bool scan_as_many_as_possible,
 	bool can_have_separators) {
-	long long result;
+	tscc_big_int result;
 	auto scanned = scan_hex_number(result, min_size, scan_as_many_as_possible,
 								   can_have_separators);
 
 	if (!scanned)
 		throw invalid_identifier(location());
+	if (result > 0x10FFFF)
+		throw unicode_value_out_of_range(location());
 
 	advance(scanned);
-	append_wbuffer(result);
+	append_wbuffer(small_value(result));
 	return scanned;
 }
 
@@ -2166,6 +2320,17 @@ void lexer::scan_identifier(token& into, bool is_private) {
 	auto identifier_start = location();
 
 	while (true) {
+		// plain ASCII identifier characters are stepped over a byte at a time
+		// without going through the decoder
+		while (buffer_offset_ < input_.size()) {
+			auto byte = static_cast<unsigned char>(input_[buffer_offset_]);
+			if (byte > 0x7f || !is_identifier_part(byte))
+				break;
+
+			append_wbuffer(byte);
+			advance();
+		}
+
 		char32_t ch{};
 		auto pos = next_code_point(ch);
 
@@ -2238,16 +2403,33 @@ void lexer::scan_identifier(token& into, bool is_private) {
 		return;
 	}
 
+	// an identifier with as many bytes as characters is plain unescaped
+	// ASCII, so while its bytes are still in the window the keyword lookup
+	// and the interner can work on them directly
+	auto byte_length = gpos_.offset - identifier_start.offset();
+	auto raw = byte_length == wbuffer_.size() && buffer_offset_ >= byte_length
+				   ? input_.substr(buffer_offset_ - byte_length, byte_length)
+				   : std::string_view{};
+
 	if (!force_identifier_) {
-		auto kit = keyword_lookup.find(wbuffer_);
-		if (kit != keyword_lookup.end() && vers_ >= kit->second.min_version) {
-			kit->second.factory(into, identifier_start);
+		auto keyword = !raw.empty()
+						   ? find_keyword(raw)
+						   : find_keyword(std::u32string_view{wbuffer_});
+		if (keyword && vers_ >= keyword->min_version) {
+			keyword->factory(into, identifier_start);
 			return;
 		}
 	}
 
-	into.emplace_token<tokens::identifier_token>(identifier_start,
-												 std::move(wbuffer_));
+	if (!raw.empty()) {
+		into.emplace_token<tokens::identifier_token>(identifier_start, raw);
+	} else {
+		into.emplace_token<tokens::identifier_token>(identifier_start,
+													 wbuffer_);
+	}
+
+	// the buffer keeps its capacity for the next token
+	wbuffer_.clear();
 }
 
 constexpr bool lexer::is_decimal_digit(char32_t ch) {
@@ -2289,30 +2471,8 @@ constexpr bool lexer::is_identifier_part(char32_t ch, bool is_jsx) {
 	if (is_jsx && (ch == '-' || ch == ':' || ch == '.'))
 		return true;
 
-	if (ch > 0x7f) {
-		if (vers_ >= language_version::es2015) {
-			auto fnd = std::lower_bound(
-				detail::unicode_tables::esnext_identifier_part.begin(),
-				detail::unicode_tables::esnext_identifier_part.end(), ch);
-			return fnd !=
-					   detail::unicode_tables::esnext_identifier_part.end() &&
-				   *fnd == ch;
-		}
-
-		if (vers_ >= language_version::es5) {
-			auto fnd = std::lower_bound(
-				detail::unicode_tables::es5_identifier_part.begin(),
-				detail::unicode_tables::es5_identifier_part.end(), ch);
-			return fnd != detail::unicode_tables::es5_identifier_part.end() &&
-				   *fnd == ch;
-		}
-
-		auto fnd = std::lower_bound(
-			detail::unicode_tables::es3_identifier_part.begin(),
-			detail::unicode_tables::es3_identifier_part.end(), ch);
-		return fnd != detail::unicode_tables::es3_identifier_part.end() &&
-			   *fnd == ch;
-	}
+	if (ch > 0x7f)
+		return identifier_part_->contains(ch);
 
 	return false;
 }
@@ -2325,30 +2485,8 @@ constexpr bool lexer::is_identifier_start(char32_t ch) {
 	if (ch == U'$' || ch == U'_')
 		return true;
 
-	if (ch > 0x7f) {
-		if (vers_ >= language_version::es2015) {
-			auto fnd = std::lower_bound(
-				detail::unicode_tables::esnext_identifier_start.begin(),
-				detail::unicode_tables::esnext_identifier_start.end(), ch);
-			return fnd !=
-					   detail::unicode_tables::esnext_identifier_start.end() &&
-				   *fnd == ch;
-		}
-
-		if (vers_ >= language_version::es5) {
-			auto fnd = std::lower_bound(
-				detail::unicode_tables::es5_identifier_start.begin(),
-				detail::unicode_tables::es5_identifier_start.end(), ch);
-			return fnd != detail::unicode_tables::es5_identifier_start.end() &&
-				   *fnd == ch;
-		}
-
-		auto fnd = std::lower_bound(
-			detail::unicode_tables::es3_identifier_start.begin(),
-			detail::unicode_tables::es3_identifier_start.end(), ch);
-		return fnd != detail::unicode_tables::es3_identifier_start.end() &&
-			   *fnd == ch;
-	}
+	if (ch > 0x7f)
+		return identifier_start_->contains(ch);
 
 	return false;
 }
@@ -2382,6 +2520,12 @@ void lexer::scan_line_into_wbuffer(bool trim) {
 
 	// read the command until a eof or an eol
 	while (true) {
+		if (auto run = ascii_run_to_eol()) {
+			wbuffer_.append(input_.begin() + buffer_offset_,
+							input_.begin() + buffer_offset_ + run);
+			advance(run);
+		}
+
 		auto nc = next_code_point(first);
 		if (!nc) {
 			if (trim) {
@@ -2407,7 +2551,6 @@ void lexer::scan_line_into_wbuffer(bool trim) {
 
 				wbuffer_.erase(end);
 			}
-			gpos_.advance_line();
 			return;
 		}
 
@@ -2416,6 +2559,9 @@ void lexer::scan_line_into_wbuffer(bool trim) {
 }
 
 bool lexer::scan(token& into) {
+	if (replay_)
+		return scan_replayed(into);
+
 	// automatically reset one iteration flags after call
 	struct reset_one_iteration_values {
 		lexer* lexer_;
@@ -2503,7 +2649,6 @@ bool lexer::scan(token& into) {
 			}
 
 			advance(pos);
-			gpos_.advance_line();
 			if (pnewline_)
 				continue;
 
@@ -2515,7 +2660,6 @@ bool lexer::scan(token& into) {
 		if (ch == '\n') {
 			auto loc = location();
 			advance(pos);
-			gpos_.advance_line();
 
 			if (pnewline_)
 				continue;
@@ -3199,8 +3343,5 @@ bool lexer::check_and_consume_bigint_suffix() {
 }
 
 source_location lexer::location() const {
-	// get the column
-	auto column = gpos_.offset - gpos_.line.line_start_offset;
-	return source_location{source_, gpos_.line.current_line_number, column,
-						   gpos_.offset};
+	return source_location{file_, gpos_.offset};
 }
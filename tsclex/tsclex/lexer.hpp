@@ -20,16 +20,27 @@
 
 #include <deque>
 #include <istream>
+#include <iterator>
+#include <memory>
 #include <optional>
+#include <span>
+#include <string_view>
 #include <tsccore/bigint.hpp>
 #include <unordered_map>
 #include <vector>
+#include "diagnostic_sink.hpp"
 #include "error.hpp"
+#include "source_registry.hpp"
 
 namespace tscc::lex {
 
 // forward declaration of token
 class token;
+class token_table;
+
+namespace detail {
+struct identifier_table;
+}
 
 // TODO maybe move this
 /**
@@ -59,9 +70,25 @@ enum class language_version : std::uint8_t {
  * different tokens. As such, it is meant to be used one time to extract a
  * single iterator pair and that range can then be used to get a stream of
  * tokens out of a std::istream of chars.
+ *
+ * Alternatively the lexer can be constructed over a contiguous buffer that
+ * holds the entire source text (e.g. from source::open_mapped()). In that
+ * mode the text is never copied and lookahead never needs a refill.
+ *
+ * Callers that don't need an iterator can pull tokens with next() or fill()
+ * instead, which lex straight into storage the caller owns.
+ *
+ * A lexer can also replay() a token_table that was lexed earlier, such as
+ * one read back from a token_cache, in which case the input isn't lexed at
+ * all.
+ *
+ * After pipeline() the lexer runs ahead of the reader on a thread of its
+ * own, so the tokens of a file can be lexed on one core while the parser
+ * works on them on another.
  */
 class lexer {
 	static constexpr std::size_t buffer_size = 4096;
+	static constexpr std::size_t default_pipeline_capacity = 256;
 
 public:
 	class iterator {
@@ -87,6 +114,11 @@ public:
 		bool operator==(const iterator& other) const;
 		bool operator!=(const iterator& other) const;
 
+		/**
+		 * \brief Check for the end of the tokens without comparing tokens
+		 */
+		bool operator==(std::default_sentinel_t) const noexcept;
+
 	private:
 		explicit iterator(lexer* source);
 
@@ -106,9 +138,22 @@ public:
 		  std::shared_ptr<class source> stream_metadata,
 		  language_version version = language_version::latest);
 
+	/**
+	 * \brief Construct a lexer over a contiguous buffer
+	 * \param buffer The complete source text. It is not copied and must
+	 * outlive the lexer
+	 * \param stream_metadata
+	 *
+	 */
+	lexer(std::span<const char> buffer,
+		  std::shared_ptr<class source> stream_metadata,
+		  language_version version = language_version::latest);
+
 	// disable copy / move
 	lexer(const lexer&) = delete;
 
+	~lexer();
+
 	/**
 	 * \brief Get an iterator to the tokens in the stream
 	 */
@@ -119,43 +164,117 @@ public:
 	 */
 	iterator end();
 
+	/**
+	 * \brief Lex the next token into the given token
+	 *
+	 * The token is overwritten in place, so reusing the same token for every
+	 * call doesn't allocate for the token itself. At the end of the input the
+	 * token is left undefined and false is returned.
+	 */
+	bool next(token& into);
+
+	/**
+	 * \brief Lex as many tokens as fit into the given buffer
+	 *
+	 * Returns the number of tokens written, which is less than the size of
+	 * the buffer only at the end of the input.
+	 */
+	std::size_t fill(std::span<token> into);
+
+	/**
+	 * \brief Hand out the tokens of a table instead of lexing the input
+	 *
+	 * Every token read after this comes from the table, starting from its
+	 * first token, and offset() follows the tokens as they are read. The
+	 * table must have been made for this lexer's file.
+	 */
+	void replay(token_table tokens);
+
+	/**
+	 * \brief Lex ahead on a separate thread from now on
+	 * \param capacity The number of tokens that can be lexed ahead
+	 *
+	 * The lexing thread writes tokens into a ring that next(), fill() and
+	 * the iterators read from. Tokens that were read are swapped back into
+	 * the ring to be lexed over, so a reader that reuses its token doesn't
+	 * allocate. An error is thrown by the read that reaches the token where
+	 * it happened, and no tokens are read after it. The thread stops at the end of the input or when the
+	 * lexer is destroyed, and restore() and replay() restart it.
+	 *
+	 * Only the thread that reads the tokens may use the lexer while it is
+	 * pipelined.
+	 */
+	void pipeline(std::size_t capacity = default_pipeline_capacity);
+
+	class checkpoint;
+
+	/**
+	 * \brief Save the state of the lexer between two tokens
+	 */
+	checkpoint save() const;
+
+	/**
+	 * \brief Carry on lexing from a saved state
+	 *
+	 * The checkpoint can come from a lexer over an earlier version of the
+	 * text, as long as nothing the earlier lexer had looked at by then (see
+	 * checkpoint::reach()) has changed. Only lexers over a contiguous buffer
+	 * can be restored.
+	 */
+	void restore(const checkpoint& from);
+
 	/**
 	 * \brief Get the source file associated with this lexer
 	 */
 	const std::shared_ptr<class source>& source() const noexcept { return source_; }
 
+	/**
+	 * \brief Get the id the source was registered with
+	 */
+	file_id file() const noexcept { return file_; }
+
 	/**
 	 * \brief Get the ECMAScript language version
 	 */
 	language_version version() const noexcept { return vers_; }
 
+	/**
+	 * \brief Get the offset just past the last token that was read
+	 */
+	std::size_t offset() const noexcept;
+
+	/**
+	 * \brief Report warnings to the given sink, or stop with nullptr
+	 *
+	 * With a sink set, each regular expression literal is checked for
+	 * patterns that can backtrack catastrophically. Tokens that are replayed
+	 * aren't checked. The sink must outlive the lexer or be unset first.
+	 */
+	void set_diagnostic_sink(diagnostic_sink* sink) noexcept;
+
 private:
+	struct pipeline_state;
+
 	using tokfactory = void (*)(token& into, const source_location& location);
 	
 	struct versioned_keyword {
+		std::string_view name;
 		tokfactory factory;
 		language_version min_version;
 	};
-	
-	static std::unordered_map<std::u32string, versioned_keyword> keyword_lookup;
-
-	struct position_t {
-		struct line_t {
-			std::size_t current_line_number;
-			std::size_t line_start_offset;
 
-			constexpr line_t() noexcept
-				: current_line_number(0), line_start_offset(0) {}
-		} line;
+	// look up a keyword in the compile-time perfect hash, without allocating.
+	// Works on either the raw input bytes or the decoded identifier
+	template <typename CharT>
+	static const versioned_keyword* find_keyword(
+		std::basic_string_view<CharT> identifier) noexcept;
 
+	// lines and columns come from the file's line_map when they're asked
+	// for, so only the offset is tracked while lexing
+	struct position_t {
 		std::size_t offset;
 
 		constexpr position_t() noexcept : offset(0) {}
-
-		void advance_line() {
-			++line.current_line_number;
-			line.line_start_offset = offset;
-		}
 	};
 
 	constexpr void advance(std::size_t by = 1) {
@@ -166,10 +285,31 @@ private:
 	// read more data from the stream into the buffer
 	std::size_t next_code_point(char32_t& into, std::size_t look_forward = 0);
 
+	// validate a chunk of input starting at the given offset
+	void extend_validated_input(std::size_t from);
+
+	// length of the plain ASCII run at the read position before the next
+	// newline (or stop character) - those bytes can be copied without decoding
+	std::size_t ascii_run_to_eol(char stop = '\n') const;
+
 	// read the next token from the stream
 	void scan_line_into_wbuffer(bool trim = true);
 
+	// take the next token from the pipeline if there is one, otherwise scan
+	bool read(token& into);
+	bool read_pipelined(token& into);
+
+	// the body of the lexing thread of a pipeline
+	void produce();
+
+	// join the lexing thread and return the capacity of its ring, or 0
+	std::size_t stop_pipeline() noexcept;
+
+	// save into an existing checkpoint, reusing its storage
+	void save_into(checkpoint& into) const;
+
 	bool scan(token& into);
+	bool scan_replayed(token& into);
 	void scan_shebang(std::size_t shebang_offset, token& into);
 	void scan_string(token& into);
 	void scan_template_string_part(token& into);
@@ -177,7 +317,7 @@ private:
 	void scan_line_comment(std::size_t comment_offset, token& into);
 	void scan_multiline_comment(token& into, bool is_jsdoc);
 	void scan_binary_token(token& into);
-	std::size_t scan_binary_or_octal_number(long long& into,
+	std::size_t scan_binary_or_octal_number(tscc_big_int& into,
 											std::size_t base,
 											std::size_t skip = 0);
 	bool scan_octal_token(token& into, bool throw_on_invalid = true);
@@ -196,11 +336,11 @@ private:
 								bool scan_as_many_as_possible,
 								bool can_have_separators,
 								std::size_t skip = 0);
-	std::size_t scan_octal_number(long long& into,
+	std::size_t scan_octal_number(tscc_big_int& into,
 								  bool bail_on_decimal,
 								  bool can_have_separators,
 								  std::size_t skip = 0);
-	std::size_t scan_binary_number(long long& into,
+	std::size_t scan_binary_number(tscc_big_int& into,
 								   bool can_have_separators,
 								   std::size_t skip = 0);
 
@@ -223,15 +363,29 @@ private:
 
 	[[nodiscard]] source_location location() const;
 
-	std::istream& stream_;
+	// null when lexing a contiguous buffer
+	std::istream* stream_;
 	std::shared_ptr<class source> source_;
+	file_id file_;
+	line_map* lines_;
 
-	// input buffer
+	// input buffer - only used when reading from a stream
 	std::string rbuffer_;
+
+	// the readable window of input, either rbuffer_ or the entire source
+	std::string_view input_;
 	std::size_t buffer_offset_;
 
+	// the region of input_ that is known to be well-formed UTF-8 and can be
+	// decoded without any checks
+	std::size_t validated_begin_;
+	std::size_t validated_end_;
+
 	// output buffer
 	std::u32string wbuffer_;
+
+	// the digits of the decimal being scanned
+	std::string number_buffer_;
 	std::vector<std::u32string> multiline_buffer_;
 	position_t gpos_;
 	const iterator end_;
@@ -261,7 +415,83 @@ private:
 	};
 
 	std::deque<std::pair<lexer_context, stack_entry>> context_stack_;
+
+	// one past the last byte of input that was looked at so far
+	std::size_t reach_ = 0;
+
+	// set by replay(), after which tokens come from the table
+	std::unique_ptr<token_table> replay_;
+	std::size_t replay_next_ = 0;
+
+	// set by pipeline(). While it is, everything but the reading side of
+	// the pipeline belongs to the lexing thread
+	std::unique_ptr<pipeline_state> pipeline_;
+
 	const language_version vers_;
+
+	diagnostic_sink* diagnostics_ = nullptr;
+
+	// the code points allowed in identifiers by the language version
+	const detail::identifier_table* identifier_start_;
+	const detail::identifier_table* identifier_part_;
+};
+
+/**
+ * \brief The state of a lexer between two tokens
+ *
+ * Besides the offset, the only state that carries over from one token to
+ * the next is the nesting of templates and JSX, whether the last token was
+ * a line break and whether the next word must be an identifier. Two
+ * checkpoints with the same state lex the same text into the same tokens.
+ */
+class lexer::checkpoint {
+public:
+	/**
+	 * \brief Get the offset of the next token
+	 */
+	std::size_t offset() const noexcept { return offset_; }
+
+	/**
+	 * \brief Get one past the last byte the lexer had looked at
+	 *
+	 * Deciding a token can look ahead past its end, so the tokens before
+	 * the checkpoint depend on all of the text up to here.
+	 */
+	std::size_t reach() const noexcept { return reach_; }
+
+	/**
+	 * \brief Whether the lexer state is the same apart from the position
+	 */
+	bool same_state(const checkpoint& other) const noexcept;
+
+	/**
+	 * \brief Move the checkpoint to follow an edit before it
+	 * \param edit_offset Where the edit starts
+	 * \param removed The number of bytes the edit removed
+	 * \param inserted The number of bytes the edit inserted
+	 */
+	void shift(std::size_t edit_offset,
+			   std::size_t removed,
+			   std::size_t inserted) noexcept;
+
+private:
+	struct context {
+		lexer_context kind;
+		std::size_t offset;
+		std::u32string text;
+
+		bool operator==(const context& other) const noexcept {
+			return kind == other.kind && text == other.text;
+		}
+	};
+
+	std::size_t offset_ = 0;
+	std::size_t reach_ = 0;
+	std::vector<context> contexts_;
+	bool force_identifier_ = false;
+	bool pnewline_ = false;
+
+	friend class lexer;
 };
 
 }  // namespace tscc::lex
\ No newline at end of file
@@ -0,0 +1,83 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "line_map.hpp"
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <tsccore/utf8.hpp>
+
+using namespace tscc::lex;
+
+line_map::line_map() : starts_{0} {}
+
+void line_map::scan(std::string_view bytes, std::size_t file_offset) {
+	std::unique_lock lock(mutex_);
+
+	if (file_offset + bytes.size() <= scanned_)
+		return;
+
+	if (file_offset < scanned_) {
+		bytes.remove_prefix(scanned_ - file_offset);
+		file_offset = scanned_;
+	}
+
+	std::size_t at = 0;
+	while (true) {
+		at += tscc::find_either(bytes.substr(at), '\n', '\r');
+		if (at == bytes.size())
+			break;
+
+		auto next = static_cast<std::uint32_t>(file_offset + at + 1);
+		if (bytes[at] == '\r') {
+			starts_.push_back(next);
+			after_cr_ = next;
+		} else if (after_cr_ == next - 1 && after_cr_ != 0) {
+			// the "\n" of a "\r\n"
+			starts_.back() = next;
+		} else {
+			starts_.push_back(next);
+		}
+
+		++at;
+	}
+
+	scanned_ = file_offset + bytes.size();
+}
+
+std::pair<std::size_t, std::size_t> line_map::position(
+	std::size_t offset) const {
+	std::shared_lock lock(mutex_);
+
+	// the last line that starts at or before the offset
+	auto line = std::upper_bound(starts_.begin(), starts_.end(), offset) - 1;
+	return {static_cast<std::size_t>(line - starts_.begin()), offset - *line};
+}
+
+std::size_t line_map::line_count() const {
+	std::shared_lock lock(mutex_);
+	return starts_.size();
+}
+
+std::size_t line_map::line_start(std::size_t line) const {
+	std::shared_lock lock(mutex_);
+	if (line >= starts_.size())
+		throw std::out_of_range("line is past the scanned input");
+
+	return starts_[line];
+}
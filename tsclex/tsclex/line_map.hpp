@@ -0,0 +1,77 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace tscc::lex {
+
+/**
+ * \brief The offsets where each line of a file starts
+ *
+ * The lexer hands every chunk of input to scan() as it reads it, which finds
+ * the line breaks with a vectorized search instead of the lexer keeping a
+ * line count as it goes. Lines and columns are only worked out when a
+ * location asks for them, with a binary search over the line starts.
+ *
+ * "\r\n", "\n" and a lone "\r" each end a line, even when a "\r\n" is split
+ * between two chunks.
+ */
+class line_map {
+public:
+	line_map();
+
+	/**
+	 * \brief Record the line breaks in a chunk of the file
+	 *
+	 * Chunks must be scanned in order. Any part of the chunk before the end
+	 * of what has already been scanned is skipped.
+	 */
+	void scan(std::string_view bytes, std::size_t file_offset);
+
+	/**
+	 * \brief Get the 0-based line and column of an offset
+	 */
+	std::pair<std::size_t, std::size_t> position(std::size_t offset) const;
+
+	/**
+	 * \brief Get the number of lines seen so far
+	 */
+	std::size_t line_count() const;
+
+	/**
+	 * \brief Get the offset of the start of a line
+	 */
+	std::size_t line_start(std::size_t line) const;
+
+private:
+	mutable std::shared_mutex mutex_;
+	std::vector<std::uint32_t> starts_;
+
+	// the end of the scanned bytes, and the offset just past a "\r" that
+	// ended the previous chunk so a following "\n" joins its line break
+	std::size_t scanned_ = 0;
+	std::size_t after_cr_ = 0;
+};
+
+}  // namespace tscc::lex
@@ -0,0 +1,114 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mapped_source.hpp"
+#include <cerrno>
+#include <system_error>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TSCC_HAS_MMAP 1
+#else
+#include <fstream>
+#include <iterator>
+#define TSCC_HAS_MMAP 0
+#endif
+
+using namespace tscc::lex;
+
+mapped_source::mapped_source(std::string name)
+	: name_(std::move(name)), data_(nullptr), size_(0) {}
+
+mapped_source::~mapped_source() {
+#if TSCC_HAS_MMAP
+	if (data_ != nullptr && data_ != fallback_.data()) {
+		munmap(const_cast<char*>(data_), size_);
+	}
+#endif
+}
+
+std::string_view mapped_source::name() const {
+	return name_;
+}
+
+std::span<const char> mapped_source::contents() const noexcept {
+	return {data_, size_};
+}
+
+std::shared_ptr<mapped_source> source::open_mapped(
+	const std::filesystem::path& path) {
+	std::shared_ptr<mapped_source> result(new mapped_source(path.string()));
+
+#if TSCC_HAS_MMAP
+	auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		throw std::system_error(errno, std::generic_category(), path.string());
+	}
+
+	struct stat st {};
+	if (::fstat(fd, &st) != 0) {
+		auto err = errno;
+		::close(fd);
+		throw std::system_error(err, std::generic_category(), path.string());
+	}
+
+	// zero length mappings are invalid so empty files stay unmapped
+	if (st.st_size > 0) {
+		auto size = static_cast<std::size_t>(st.st_size);
+		auto* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED) {
+			auto err = errno;
+			::close(fd);
+			throw std::system_error(err, std::generic_category(),
+									path.string());
+		}
+
+		// the lexer walks the file front to back exactly once
+		::madvise(data, size, MADV_SEQUENTIAL);
+		result->data_ = static_cast<const char*>(data);
+		result->size_ = size;
+	} else {
+		result->data_ = result->fallback_.data();
+	}
+
+	::close(fd);
+#else
+	// streams don't carry an error code but the C runtime still sets errno
+	// for the underlying open and read failures
+	errno = 0;
+	std::ifstream in(path, std::ios::binary);
+	if (!in) {
+		throw std::system_error(errno ? errno : EIO, std::generic_category(),
+								path.string());
+	}
+
+	result->fallback_.assign(std::istreambuf_iterator<char>(in),
+							 std::istreambuf_iterator<char>());
+	if (in.bad()) {
+		throw std::system_error(errno ? errno : EIO, std::generic_category(),
+								path.string());
+	}
+	result->data_ = result->fallback_.data();
+	result->size_ = result->fallback_.size();
+#endif
+
+	return result;
+}
@@ -0,0 +1,61 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <span>
+#include <string>
+#include "source.hpp"
+
+namespace tscc::lex {
+
+/**
+ * \brief A source file whose full contents are mapped into memory
+ *
+ * Created through source::open_mapped(). The mapping lives as long as the
+ * source, so any lexer holding the source keeps its input buffer valid.
+ */
+class mapped_source : public source {
+public:
+	~mapped_source() override;
+
+	// disable copy / move - the mapping is owned
+	mapped_source(const mapped_source&) = delete;
+	mapped_source& operator=(const mapped_source&) = delete;
+
+	std::string_view name() const override;
+
+	/**
+	 * \brief Get the full contents of the file
+	 */
+	std::span<const char> contents() const noexcept;
+
+private:
+	explicit mapped_source(std::string name);
+
+	std::string name_;
+	const char* data_;
+	std::size_t size_;
+
+	// used when memory mapping isn't available on the platform
+	std::string fallback_;
+
+	friend class source;
+};
+
+}  // namespace tscc::lex
@@ -0,0 +1,133 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+namespace tscc::lex::detail {
+
+/**
+ * \brief A perfect hash over a fixed set of ASCII words built at compile time
+ *
+ * The hash only looks at the length and at the first, second and last
+ * characters of a word, so rejecting an identifier costs a handful of loads
+ * no matter how long it is. The seed is searched for at compile time until
+ * every word lands in its own slot, which means a lookup is a single probe
+ * followed by one comparison against the candidate.
+ */
+template <std::size_t N>
+class keyword_hash {
+	static_assert(N > 0 && N < 255, "slots index words with a single byte");
+
+	static constexpr std::size_t table_size = std::bit_ceil(N * 4);
+
+public:
+	consteval explicit keyword_hash(
+		const std::array<std::string_view, N>& words)
+		: words_(words), seed_(0), slots_{}, min_length_(~std::size_t{}),
+		  max_length_(0) {
+		for (auto word : words_) {
+			if (word.size() < 2)
+				throw std::logic_error("keywords must be two characters or more");
+
+			min_length_ = std::min(min_length_, word.size());
+			max_length_ = std::max(max_length_, word.size());
+		}
+
+		for (seed_ = 1; seed_ < 100000; ++seed_) {
+			if (try_seed())
+				return;
+		}
+
+		throw std::logic_error("no perfect hash seed for the keyword set");
+	}
+
+	/**
+	 * \brief Get the index of the word matching the given text
+	 */
+	template <typename CharT>
+	constexpr std::optional<std::size_t> find(
+		std::basic_string_view<CharT> text) const noexcept {
+		if (text.size() < min_length_ || text.size() > max_length_)
+			return std::nullopt;
+
+		auto slot = slots_[hash(seed_, text)];
+		if (!slot)
+			return std::nullopt;
+
+		auto word = words_[slot - 1];
+		if (word.size() != text.size())
+			return std::nullopt;
+
+		for (std::size_t i = 0; i < word.size(); i++) {
+			if (static_cast<char32_t>(text[i]) !=
+				static_cast<unsigned char>(word[i]))
+				return std::nullopt;
+		}
+
+		return slot - 1;
+	}
+
+private:
+	template <typename CharT>
+	static constexpr std::size_t hash(
+		std::uint32_t seed,
+		std::basic_string_view<CharT> text) noexcept {
+		// FNV-1a over the length and the three sampled characters
+		auto h = seed;
+		for (auto value : {static_cast<std::uint32_t>(text.size()),
+						   static_cast<std::uint32_t>(text[0]),
+						   static_cast<std::uint32_t>(text[1]),
+						   static_cast<std::uint32_t>(text.back())}) {
+			h = (h ^ value) * 0x01000193u;
+		}
+
+		h ^= h >> 15;
+		return h & (table_size - 1);
+	}
+
+	consteval bool try_seed() {
+		slots_ = {};
+		for (std::size_t i = 0; i < N; i++) {
+			auto& slot = slots_[hash(seed_, words_[i])];
+			if (slot)
+				return false;
+
+			slot = static_cast<std::uint8_t>(i + 1);
+		}
+
+		return true;
+	}
+
+	std::array<std::string_view, N> words_;
+	std::uint32_t seed_;
+
+	// index + 1 of the word hashed to each slot or 0 when the slot is empty
+	std::array<std::uint8_t, table_size> slots_;
+	std::size_t min_length_;
+	std::size_t max_length_;
+};
+
+}  // namespace tscc::lex::detail
@@ -17,10 +17,14 @@
  */
 
 #include "unicode_tables.hpp"
+#include <array>
 
 using namespace tscc::lex::detail;
 
-const std::array<char32_t, 512> unicode_tables::es3_identifier_start{
+namespace {
+
+// the sorted [first, last] ranges of code points in each set
+constexpr std::array<char32_t, 512> es3_identifier_start_ranges{
 	170,   170,	  181,	 181,	186,   186,	  192,	 214,	216,   246,	  248,
 	543,   546,	  563,	 592,	685,   688,	  696,	 699,	705,   720,	  721,
 	736,   740,	  750,	 750,	890,   890,	  902,	 902,	904,   906,	  908,
@@ -69,7 +73,7 @@ const std::array<char32_t, 512> unicode_tables::es3_identifier_start{
 	65140, 65142, 65276, 65313, 65338, 65345, 65370, 65382, 65470, 65474, 65479,
 	65482, 65487, 65490, 65495, 65498, 65500};
 
-const std::array<char32_t, 684> unicode_tables::es3_identifier_part{
+constexpr std::array<char32_t, 684> es3_identifier_part_ranges{
 	170,   170,	  181,	 181,	186,   186,	  192,	 214,	216,   246,	  248,
 	543,   546,	  563,	 592,	685,   688,	  696,	 699,	705,   720,	  721,
 	736,   740,	  750,	 750,	768,   846,	  864,	 866,	890,   890,	  902,
@@ -134,7 +138,7 @@ const std::array<char32_t, 684> unicode_tables::es3_identifier_part{
 	65343, 65345, 65370, 65381, 65470, 65474, 65479, 65482, 65487, 65490, 65495,
 	65498, 65500};
 
-const std::array<char32_t, 740> unicode_tables::es5_identifier_start{
+constexpr std::array<char32_t, 740> es5_identifier_start_ranges{
 	170,   170,	  181,	 181,	186,   186,	  192,	 214,	216,   246,	  248,
 	705,   710,	  721,	 736,	740,   748,	  748,	 750,	750,   880,	  884,
 	886,   887,	  890,	 893,	902,   902,	  904,	 906,	908,   908,	  910,
@@ -204,7 +208,7 @@ const std::array<char32_t, 740> unicode_tables::es5_identifier_start{
 	65313, 65338, 65345, 65370, 65382, 65470, 65474, 65479, 65482, 65487, 65490,
 	65495, 65498, 65500};
 
-const std::array<char32_t, 856> unicode_tables::es5_identifier_part{
+constexpr std::array<char32_t, 856> es5_identifier_part_ranges{
 	170,   170,	  181,	 181,	186,   186,	  192,	 214,	216,   246,	  248,
 	705,   710,	  721,	 736,	740,   748,	  748,	 750,	750,   768,	  884,
 	886,   887,	  890,	 893,	902,   902,	  904,	 906,	908,   908,	  910,
@@ -284,7 +288,7 @@ const std::array<char32_t, 856> unicode_tables::es5_identifier_part{
 	65142, 65276, 65296, 65305, 65313, 65338, 65343, 65343, 65345, 65370, 65382,
 	65470, 65474, 65479, 65482, 65487, 65490, 65495, 65498, 65500};
 
-const std::array<char32_t, 1218> unicode_tables::esnext_identifier_start{
+constexpr std::array<char32_t, 1218> esnext_identifier_start_ranges{
 	65,		90,		97,		122,	170,	170,	181,	181,	186,
 	186,	192,	214,	216,	246,	248,	705,	710,	721,
 	736,	740,	748,	748,	750,	750,	880,	884,	886,
@@ -422,7 +426,7 @@ const std::array<char32_t, 1218> unicode_tables::esnext_identifier_start{
 	131072, 173782, 173824, 177972, 177984, 178205, 178208, 183969, 183984,
 	191456, 194560, 195101};
 
-const std::array<char32_t, 1426> unicode_tables::esnext_identifier_part{
+constexpr std::array<char32_t, 1426> esnext_identifier_part_ranges{
 	48,		57,		65,		90,		95,		95,		97,		122,	170,
 	170,	181,	181,	183,	183,	186,	186,	192,	214,
 	216,	246,	248,	705,	710,	721,	736,	740,	748,
@@ -582,3 +586,149 @@ const std::array<char32_t, 1426> unicode_tables::esnext_identifier_part{
 	126603, 126619, 126625, 126627, 126629, 126633, 126635, 126651, 131072,
 	173782, 173824, 177972, 177984, 178205, 178208, 183969, 183984, 191456,
 	194560, 195101, 917760, 917999};
+
+// a bitmap for every block of code points, with the blocks that are the same
+// stored once
+template <std::size_t Blocks>
+struct identifier_table_data {
+	std::array<std::uint8_t, identifier_table::index_size> index{};
+	std::array<std::uint64_t, Blocks * identifier_table::words_per_block> bits{};
+};
+
+using block_bits = std::array<std::uint64_t, identifier_table::words_per_block>;
+
+template <std::size_t N>
+constexpr block_bits fill_block(const std::array<char32_t, N>& ranges,
+								std::size_t& range,
+								std::size_t block) {
+	block_bits result{};
+	auto first = static_cast<char32_t>(block * identifier_table::block_size);
+	auto last = first + identifier_table::block_size - 1;
+
+	// ranges are sorted, so the ones before this block can be skipped for
+	// good
+	while (range < N && ranges[range + 1] < first)
+		range += 2;
+
+	for (auto i = range; i < N && ranges[i] <= last; i += 2) {
+		auto from = (ranges[i] < first ? first : ranges[i]) - first;
+		auto to = (ranges[i + 1] > last ? last : ranges[i + 1]) - first;
+
+		// set the bits a word at a time
+		for (auto word = from / 64; word <= to / 64; ++word) {
+			auto low = from > word * 64 ? from % 64 : 0;
+			auto high = to < word * 64 + 63 ? to % 64 : 63;
+			auto upto = high == 63 ? ~std::uint64_t{0}
+								   : (std::uint64_t{1} << (high + 1)) - 1;
+			result[word] |= upto & ~((std::uint64_t{1} << low) - 1);
+		}
+	}
+
+	return result;
+}
+
+constexpr bool same_bits(const block_bits& left, const block_bits& right) {
+	for (std::size_t word = 0; word < left.size(); ++word) {
+		if (left[word] != right[word])
+			return false;
+	}
+
+	return true;
+}
+
+// the table with room for as many blocks as a byte can index, before it's
+// cut down to the blocks it uses
+struct unsized_table {
+	std::array<std::uint8_t, identifier_table::index_size> index{};
+	std::array<block_bits, 256> blocks{};
+	std::size_t count = 0;
+};
+
+template <std::size_t N>
+constexpr unsized_table build(const std::array<char32_t, N>& ranges) {
+	static_assert(N % 2 == 0);
+
+	// the empty block comes first, since most of Unicode is in it
+	unsized_table result;
+	result.count = 1;
+
+	std::size_t range = 0;
+	std::size_t last_found = 0;
+	for (std::size_t block = 0; block < identifier_table::index_size; ++block) {
+		auto bits = fill_block(ranges, range, block);
+
+		// neighbouring blocks are often the same
+		auto found = last_found;
+		if (!same_bits(result.blocks[found], bits)) {
+			found = 0;
+			while (found < result.count &&
+				   !same_bits(result.blocks[found], bits))
+				++found;
+		}
+
+		if (found == result.count) {
+			if (result.count == result.blocks.size())
+				throw "more distinct blocks than a byte can index";
+			result.blocks[result.count++] = bits;
+		}
+		result.index[block] = static_cast<std::uint8_t>(found);
+		last_found = found;
+	}
+
+	return result;
+}
+
+template <const unsized_table& Built>
+constexpr auto shrink() {
+	identifier_table_data<Built.count> result;
+	result.index = Built.index;
+	for (std::size_t block = 0; block < Built.count; ++block) {
+		for (std::size_t word = 0; word < identifier_table::words_per_block;
+			 ++word)
+			result.bits[block * identifier_table::words_per_block + word] =
+				Built.blocks[block][word];
+	}
+
+	return result;
+}
+
+constexpr auto es3_identifier_start_built = build(es3_identifier_start_ranges);
+constexpr auto es3_identifier_part_built = build(es3_identifier_part_ranges);
+constexpr auto es5_identifier_start_built = build(es5_identifier_start_ranges);
+constexpr auto es5_identifier_part_built = build(es5_identifier_part_ranges);
+constexpr auto esnext_identifier_start_built =
+	build(esnext_identifier_start_ranges);
+constexpr auto esnext_identifier_part_built =
+	build(esnext_identifier_part_ranges);
+
+constexpr auto es3_identifier_start_data =
+	shrink<es3_identifier_start_built>();
+constexpr auto es3_identifier_part_data = shrink<es3_identifier_part_built>();
+constexpr auto es5_identifier_start_data =
+	shrink<es5_identifier_start_built>();
+constexpr auto es5_identifier_part_data = shrink<es5_identifier_part_built>();
+constexpr auto esnext_identifier_start_data =
+	shrink<esnext_identifier_start_built>();
+constexpr auto esnext_identifier_part_data =
+	shrink<esnext_identifier_part_built>();
+
+}  // namespace
+
+constinit const identifier_table unicode_tables::es3_identifier_start{
+	es3_identifier_start_data.index.data(),
+	es3_identifier_start_data.bits.data()};
+constinit const identifier_table unicode_tables::es3_identifier_part{
+	es3_identifier_part_data.index.data(),
+	es3_identifier_part_data.bits.data()};
+constinit const identifier_table unicode_tables::es5_identifier_start{
+	es5_identifier_start_data.index.data(),
+	es5_identifier_start_data.bits.data()};
+constinit const identifier_table unicode_tables::es5_identifier_part{
+	es5_identifier_part_data.index.data(),
+	es5_identifier_part_data.bits.data()};
+constinit const identifier_table unicode_tables::esnext_identifier_start{
+	esnext_identifier_start_data.index.data(),
+	esnext_identifier_start_data.bits.data()};
+constinit const identifier_table unicode_tables::esnext_identifier_part{
+	esnext_identifier_part_data.index.data(),
+	esnext_identifier_part_data.bits.data()};
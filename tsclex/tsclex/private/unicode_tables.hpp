@@ -18,18 +18,48 @@
 
 #pragma once
 
-#include <array>
+#include <cstddef>
+#include <cstdint>
 
 namespace tscc::lex::detail {
 
+/**
+ * \brief A set of code points as a two-level bitmap
+ *
+ * The code points are split into blocks of block_size. The index holds the
+ * number of each block's bitmap, and blocks with the same bits share one
+ * bitmap, so the whole of Unicode fits in a few kilobytes. The tables are
+ * built at compile time from the ranges in unicode_tables.cpp.
+ */
+struct identifier_table {
+	static constexpr std::size_t block_size = 256;
+	static constexpr std::size_t words_per_block = block_size / 64;
+	static constexpr char32_t code_point_limit = 0x110000;
+	static constexpr std::size_t index_size = code_point_limit / block_size;
+
+	const std::uint8_t* index;
+	const std::uint64_t* bits;
+
+	/**
+	 * \brief Whether the code point is in the set, without branching
+	 */
+	constexpr bool contains(char32_t ch) const noexcept {
+		// nothing past the end of Unicode is in a set, and neither is 0
+		auto code = ch < code_point_limit ? ch : char32_t{0};
+		auto block = std::size_t{index[code / block_size]};
+		auto word = bits[block * words_per_block + code % block_size / 64];
+		return (word >> (code % 64)) & 1;
+	}
+};
+
 class unicode_tables {
 public:
-	static const std::array<char32_t, 512> es3_identifier_start;
-	static const std::array<char32_t, 684> es3_identifier_part;
-	static const std::array<char32_t, 740> es5_identifier_start;
-	static const std::array<char32_t, 856> es5_identifier_part;
-	static const std::array<char32_t, 1218> esnext_identifier_start;
-	static const std::array<char32_t, 1426> esnext_identifier_part;
+	static const identifier_table es3_identifier_start;
+	static const identifier_table es3_identifier_part;
+	static const identifier_table es5_identifier_start;
+	static const identifier_table es5_identifier_part;
+	static const identifier_table esnext_identifier_start;
+	static const identifier_table esnext_identifier_part;
 };
 
 }  // namespace tscc::lex::detail
\ No newline at end of file
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <filesystem>
+#include <memory>
 #include <string_view>
 
 #include <cstdint>
@@ -42,6 +44,16 @@ public:
 	 * \brief get the language variant the source uses
 	 */
 	virtual ts_language_variant language_variant() const;
+
+	/**
+	 * \brief Map a file on disk into memory for lexing
+	 *
+	 * The returned source owns the mapping and exposes the whole file as a
+	 * contiguous buffer that can be handed directly to the span-based lexer
+	 * constructor. Throws std::system_error if the file can't be opened.
+	 */
+	static std::shared_ptr<class mapped_source> open_mapped(
+		const std::filesystem::path& path);
 };
 
 }  // namespace tscc::lex
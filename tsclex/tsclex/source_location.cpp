@@ -20,23 +20,33 @@
 
 using namespace tscc::lex;
 
-source_location::source_location(std::shared_ptr<source> source,
+source_location::source_location(file_id file, std::size_t offset) noexcept
+	: file_(file), offset_(static_cast<std::uint32_t>(offset)) {}
+
+source_location::source_location(std::shared_ptr<class source> source,
 								 std::size_t line,
 								 std::size_t column,
-								 std::size_t offset) noexcept
-	: source_(std::move(source)),
-	  line_(line),
-	  column_(column),
-	  offset_(offset) {}
+								 std::size_t offset)
+	: file_(source_registry::global().add_detached(std::move(source), line,
+												   column, offset)),
+	  offset_(static_cast<std::uint32_t>(offset)) {}
 
 source_location source_location::operator+(std::size_t offset) const noexcept {
 	auto result = *this;
-	result.offset_ += offset;
+	result.offset_ += static_cast<std::uint32_t>(offset);
 	return result;
 }
 
+file_id source_location::file() const noexcept {
+	return file_;
+}
+
+std::shared_ptr<source> source_location::source() const {
+	return source_registry::global().source(file_);
+}
+
 std::size_t source_location::column() const noexcept {
-	return column_;
+	return source_registry::global().position(file_, offset_).second;
 }
 
 std::size_t source_location::offset() const noexcept {
@@ -44,5 +54,5 @@ std::size_t source_location::offset() const noexcept {
 }
 
 std::size_t source_location::line() const noexcept {
-	return line_;
+	return source_registry::global().position(file_, offset_).first;
 }
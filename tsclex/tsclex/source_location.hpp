@@ -18,23 +18,48 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <type_traits>
 #include "source.hpp"
+#include "source_registry.hpp"
 
 namespace tscc::lex {
 
 /**
  * \brief An encapsulation of a particular spot in some source code
+ *
+ * A location is just the id of the file and the offset in it, so it can be
+ * copied freely. The line and column are looked up in the source_registry
+ * when they're asked for. Offsets are limited to 32 bits.
  */
 class source_location {
 public:
 	source_location() = default;
 
-	source_location(std::shared_ptr<source> source,
+	source_location(file_id file, std::size_t offset) noexcept;
+
+	/**
+	 * \brief Create a location at a known line and column
+	 *
+	 * The source is registered as a new detached file that only knows about
+	 * this position, so this is meant for locations that don't come from a
+	 * lexer
+	 */
+	source_location(std::shared_ptr<class source> source,
 					std::size_t line,
 					std::size_t column,
-					std::size_t offset) noexcept;
-	source_location(const source_location&) noexcept = default;
+					std::size_t offset);
+
+	/**
+	 * \brief Get the id of the file the location is in
+	 */
+	file_id file() const noexcept;
+
+	/**
+	 * \brief Get the source the location is in
+	 */
+	std::shared_ptr<class source> source() const;
 
 	/**
 	 * \brief Get the line number for the location
@@ -52,15 +77,16 @@ public:
 	std::size_t offset() const noexcept;
 
 	/**
-	 * \brief Get a source location on the same line but
+	 * \brief Get a source location further along in the same file
 	 */
 	source_location operator+(std::size_t offset) const noexcept;
 
 private:
-	std::shared_ptr<source> source_;
-	std::size_t line_;
-	std::size_t column_;
-	std::size_t offset_;
+	file_id file_ = source_registry::no_file;
+	std::uint32_t offset_ = 0;
 };
 
+static_assert(sizeof(source_location) == 8);
+static_assert(std::is_trivially_copyable_v<source_location>);
+
 }  // namespace tscc::lex
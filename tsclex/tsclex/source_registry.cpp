@@ -0,0 +1,116 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "source_registry.hpp"
+#include <stdexcept>
+
+using namespace tscc::lex;
+
+source_registry::~source_registry() {
+	for (auto& block : blocks_)
+		delete[] block.load(std::memory_order_relaxed);
+}
+
+source_registry& source_registry::global() {
+	static source_registry instance;
+	return instance;
+}
+
+file_id source_registry::add(std::shared_ptr<class source> src) {
+	std::lock_guard lock(add_mutex_);
+
+	file_id file;
+	allocate(std::move(src), file);
+	return file;
+}
+
+file_id source_registry::add_detached(std::shared_ptr<class source> src,
+									  std::size_t line,
+									  std::size_t column,
+									  std::size_t offset) {
+	std::lock_guard lock(add_mutex_);
+
+	file_id file;
+	auto& added = allocate(std::move(src), file);
+	added.detached = true;
+	added.detached_line = line;
+	added.detached_column = column;
+	added.detached_offset = offset;
+
+	return file;
+}
+
+source_registry::entry& source_registry::allocate(
+	std::shared_ptr<class source> src,
+	file_id& file) {
+	file = next_;
+	auto block_index = file >> block_bits;
+	if (block_index >= max_blocks)
+		throw std::length_error("too many sources registered");
+
+	auto block = blocks_[block_index].load(std::memory_order_relaxed);
+	if (!block) {
+		block = new entry[block_size];
+		blocks_[block_index].store(block, std::memory_order_release);
+	}
+
+	auto& result = block[file & (block_size - 1)];
+	result.source = std::move(src);
+	++next_;
+
+	return result;
+}
+
+std::shared_ptr<source> source_registry::source(file_id file) const {
+	auto found = find(file);
+	return found ? found->source : nullptr;
+}
+
+line_map* source_registry::lines(file_id file) const noexcept {
+	auto found = find(file);
+	return found ? &found->lines : nullptr;
+}
+
+std::pair<std::size_t, std::size_t> source_registry::position(
+	file_id file,
+	std::size_t offset) const {
+	auto found = find(file);
+	if (!found)
+		return {0, offset};
+
+	if (found->detached) {
+		auto past = offset > found->detached_offset
+						? offset - found->detached_offset
+						: 0;
+		return {found->detached_line, found->detached_column + past};
+	}
+
+	return found->lines.position(offset);
+}
+
+source_registry::entry* source_registry::find(file_id file) const noexcept {
+	if (file == no_file)
+		return nullptr;
+
+	auto block_index = file >> block_bits;
+	if (block_index >= max_blocks)
+		return nullptr;
+
+	auto block = blocks_[block_index].load(std::memory_order_acquire);
+	return block ? &block[file & (block_size - 1)] : nullptr;
+}
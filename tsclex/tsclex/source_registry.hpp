@@ -0,0 +1,125 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include "line_map.hpp"
+#include "source.hpp"
+
+namespace tscc::lex {
+
+/**
+ * \brief A small number identifying a source that was lexed
+ *
+ * 0 is never handed out and stands for "no file".
+ */
+using file_id = std::uint32_t;
+
+/**
+ * \brief The table of every source that has been lexed
+ *
+ * Each lexer registers its source once and gets a file_id back, so locations
+ * only need to carry the id instead of sharing ownership of the source. The
+ * registry also keeps a line_map for each file which is used to work out the
+ * line and column of a location when they are asked for.
+ *
+ * Ids are never reused and entries live as long as the registry.
+ */
+class source_registry {
+	static constexpr std::size_t block_bits = 12;
+	static constexpr std::size_t block_size = std::size_t{1} << block_bits;
+	static constexpr std::size_t max_blocks = 4096;
+
+public:
+	static constexpr file_id no_file = 0;
+
+	source_registry() = default;
+	~source_registry();
+
+	source_registry(const source_registry&) = delete;
+	source_registry& operator=(const source_registry&) = delete;
+
+	/**
+	 * \brief Get the registry used by the lexer
+	 */
+	static source_registry& global();
+
+	/**
+	 * \brief Register a source and get a new id for it
+	 */
+	file_id add(std::shared_ptr<class source> src);
+
+	/**
+	 * \brief Register a source for a single known position
+	 *
+	 * Locations in the file report the given line, and columns counted from
+	 * the given column at the given offset. This is for locations that
+	 * weren't produced by a lexer.
+	 */
+	file_id add_detached(std::shared_ptr<class source> src,
+						 std::size_t line,
+						 std::size_t column,
+						 std::size_t offset);
+
+	/**
+	 * \brief Get the source registered with the given id
+	 */
+	std::shared_ptr<class source> source(file_id file) const;
+
+	/**
+	 * \brief Get the line starts of the file, or nullptr for an unknown id
+	 */
+	line_map* lines(file_id file) const noexcept;
+
+	/**
+	 * \brief Get the line and column of an offset in the file
+	 */
+	std::pair<std::size_t, std::size_t> position(file_id file,
+												 std::size_t offset) const;
+
+private:
+	struct entry {
+		std::shared_ptr<class source> source;
+		mutable line_map lines;
+
+		// set for files registered through add_detached()
+		bool detached = false;
+		std::size_t detached_line = 0;
+		std::size_t detached_column = 0;
+		std::size_t detached_offset = 0;
+	};
+
+	entry& allocate(std::shared_ptr<class source> src, file_id& file);
+
+	entry* find(file_id file) const noexcept;
+
+	std::mutex add_mutex_;
+	std::uint32_t next_ = 1;
+
+	// entries are allocated a block at a time and never move, so a lookup
+	// doesn't need a lock
+	std::array<std::atomic<entry*>, max_blocks> blocks_{};
+};
+
+}  // namespace tscc::lex
@@ -65,6 +65,12 @@ const source_location& token::location() const noexcept {
 	return location_;
 }
 
+std::size_t token::index() const noexcept {
+	if (!token_)
+		return std::variant_npos;
+	return token_->index();
+}
+
 bool token::undefined() const noexcept {
 	return !token_.has_value();
 }
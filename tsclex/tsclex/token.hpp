@@ -18,7 +18,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <utility>
 #include <variant>
 #include "source_location.hpp"
 #include "tokens/abstract_token.hpp"
@@ -190,6 +193,28 @@
 
 namespace tscc::lex {
 
+/**
+ * \brief The type of a token as a dense number
+ *
+ * There is one enumerator for each class in tscc::lex::tokens, named after
+ * it and in the same order as token::variant_type, so switching on a kind
+ * compiles to a single jump table.
+ */
+enum class token_kind : std::uint16_t {
+#define TSCC_TOKEN_KIND(name) name,
+	TSCC_ALL_TOKENS(TSCC_TOKEN_KIND)
+#undef TSCC_TOKEN_KIND
+};
+
+/**
+ * \brief The number of token kinds
+ */
+inline constexpr std::size_t token_kind_count = 0
+#define TSCC_TOKEN_COUNT(name) +1
+	TSCC_ALL_TOKENS(TSCC_TOKEN_COUNT)
+#undef TSCC_TOKEN_COUNT
+	;
+
 /**
  * \brief An exception thrown when trying to extract the basic_token from an undefined token
  */
@@ -205,6 +230,25 @@ public:
  */
 class token {
 public:
+	using variant_type = std::variant<ALL_TOKEN_TYPES>;
+
+	/**
+	 * \brief Get the position of a token type in the list of token types
+	 */
+	template <typename Token>
+	static constexpr std::size_t index_of() noexcept {
+		return index_of<Token>(
+			std::make_index_sequence<std::variant_size_v<variant_type>>());
+	}
+
+	/**
+	 * \brief Get the kind of a token type
+	 */
+	template <typename Token>
+	static constexpr token_kind kind_of() noexcept {
+		return static_cast<token_kind>(index_of<Token>());
+	}
+
 	/**
 	 * \brief Get a reference to the underlying basic_token
 	 */
@@ -285,6 +329,23 @@ public:
 		return std::holds_alternative<Token>(*token_);
 	}
 
+	/**
+	 * \brief Get the position of the held token type in the list of token
+	 * types or std::variant_npos if the token is undefined
+	 */
+	std::size_t index() const noexcept;
+
+	/**
+	 * \brief Get the kind of the held token
+	 *
+	 * Throws token_undefined if the token holds no value.
+	 */
+	token_kind kind() const {
+		if (!token_)
+			throw token_undefined();
+		return static_cast<token_kind>(token_->index());
+	}
+
 	/**
 	 * \brief Whether the token holds no value
 	 */
@@ -311,12 +372,27 @@ public:
 	bool operator!=(const token& other) const;
 
 private:
-	using all_tokens_t = std::variant<ALL_TOKEN_TYPES>;
+	using all_tokens_t = variant_type;
+
+	template <typename Token, std::size_t... Is>
+	static constexpr std::size_t index_of(std::index_sequence<Is...>) noexcept {
+		static_assert(
+			(std::is_same_v<Token, std::variant_alternative_t<Is, all_tokens_t>> ||
+			 ...),
+			"not a token type");
+		return ((std::is_same_v<Token,
+								std::variant_alternative_t<Is, all_tokens_t>>
+					 ? Is
+					 : 0) +
+				...);
+	}
 
 	source_location location_;
 	std::optional<all_tokens_t> token_;
 };
 
+static_assert(std::variant_size_v<token::variant_type> == token_kind_count);
+
 template<typename T, typename... Args>
 constexpr token make_token(const source_location& location, Args&&... args) {
 	token result;
@@ -327,4 +403,8 @@ constexpr token make_token(const source_location& location, Args&&... args) {
 
 }  // namespace tscc::lex
 
-#undef ALL_TOKEN_TYPES
\ No newline at end of file
+#undef ALL_TOKEN_TYPES
+#undef TSCC_TOKEN_TYPE_LIST
+#undef TSCC_DROP_FIRST
+#undef TSCC_TOKEN_TYPE
+#undef TSCC_ALL_TOKENS
\ No newline at end of file
@@ -0,0 +1,804 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "token_cache.hpp"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <random>
+#include <type_traits>
+#include <variant>
+#include <vector>
+#include <tsccore/regex/alternative.hpp>
+
+using namespace tscc::lex;
+
+namespace {
+
+namespace regex = tsccore::regex;
+
+constexpr char magic[4] = {'T', 'S', 'C', 'T'};
+
+// thrown by the reader when an entry is cut short or doesn't make sense
+struct corrupt_entry {};
+
+/*
+ * Entries are a header followed by one record per token:
+ *
+ *   "TSCT" format_version key:u64 size version variant count
+ *   kind offset-delta length payload...
+ *
+ * Numbers are LEB128 varints (zig-zag encoded when they can be negative),
+ * so most records take three bytes plus their payload. Offsets are stored
+ * as the distance from the end of the token before. UTF-32 strings are
+ * stored as raw code units so they can be copied straight back out.
+ */
+class writer {
+public:
+	void byte(std::uint8_t value) { out_.push_back(static_cast<char>(value)); }
+
+	void varint(std::uint64_t value) {
+		while (value >= 0x80) {
+			byte(static_cast<std::uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+		byte(static_cast<std::uint8_t>(value));
+	}
+
+	void signed_varint(std::int64_t value) {
+		auto bits = static_cast<std::uint64_t>(value);
+		varint((bits << 1) ^ (value < 0 ? ~std::uint64_t{0} : 0));
+	}
+
+	void raw(const void* data, std::size_t size) {
+		out_.append(static_cast<const char*>(data), size);
+	}
+
+	void string(std::string_view value) {
+		varint(value.size());
+		raw(value.data(), value.size());
+	}
+
+	void string(std::u32string_view value) {
+		varint(value.size());
+		raw(value.data(), value.size() * sizeof(char32_t));
+	}
+
+	// the bits of a double, which don't depend on the byte order
+	void decimal(double value) {
+		varint(std::bit_cast<std::uint64_t>(value));
+	}
+
+	const std::string& data() const noexcept { return out_; }
+
+private:
+	std::string out_;
+};
+
+class reader {
+public:
+	explicit reader(std::string_view in) noexcept : in_(in) {}
+
+	std::uint8_t byte() {
+		if (at_ >= in_.size())
+			throw corrupt_entry{};
+		return static_cast<std::uint8_t>(in_[at_++]);
+	}
+
+	std::uint64_t varint() {
+		std::uint64_t result = 0;
+		for (unsigned shift = 0; shift < 64; shift += 7) {
+			auto next = byte();
+			result |= static_cast<std::uint64_t>(next & 0x7f) << shift;
+			if (!(next & 0x80))
+				return result;
+		}
+		throw corrupt_entry{};
+	}
+
+	std::int64_t signed_varint() {
+		auto bits = varint();
+		return static_cast<std::int64_t>((bits >> 1) ^ (~(bits & 1) + 1));
+	}
+
+	void raw(void* into, std::size_t size) {
+		if (size > in_.size() - at_)
+			throw corrupt_entry{};
+		std::memcpy(into, in_.data() + at_, size);
+		at_ += size;
+	}
+
+	std::string_view string() {
+		auto size = varint();
+		if (size > in_.size() - at_)
+			throw corrupt_entry{};
+		auto result = in_.substr(at_, size);
+		at_ += size;
+		return result;
+	}
+
+	double decimal() { return std::bit_cast<double>(varint()); }
+
+	std::u32string u32string() {
+		auto size = varint();
+		if (size > (in_.size() - at_) / sizeof(char32_t))
+			throw corrupt_entry{};
+		std::u32string result(size, U'\0');
+		raw(result.data(), size * sizeof(char32_t));
+		return result;
+	}
+
+	bool done() const noexcept { return at_ == in_.size(); }
+
+	std::size_t remaining() const noexcept { return in_.size() - at_; }
+
+private:
+	std::string_view in_;
+	std::size_t at_ = 0;
+};
+
+template <typename Enum>
+Enum enum_byte(reader& in, Enum last) {
+	auto value = in.byte();
+	if (value > static_cast<std::uint8_t>(last))
+		throw corrupt_entry{};
+	return static_cast<Enum>(value);
+}
+
+// jsx text is decoded from XML when it is lexed, so the only thing that has
+// to be escaped for it to decode back to the same text is the ampersand
+std::u32string escape_ampersands(std::u32string_view text) {
+	std::u32string result;
+	result.reserve(text.size());
+	for (auto ch : text) {
+		if (ch == U'&')
+			result.append(U"&amp;");
+		else
+			result.push_back(ch);
+	}
+	return result;
+}
+
+// regular expressions
+
+void encode(writer& out, const regex::disjunction& value);
+regex::disjunction decode_disjunction(reader& in);
+
+void encode(writer& out, const regex::character_class& value) {
+	out.byte(value.is_negated());
+	out.varint(value.get_characters().size());
+	for (auto ch : value.get_characters())
+		out.varint(ch);
+	out.varint(value.get_ranges().size());
+	for (auto [first, last] : value.get_ranges()) {
+		out.varint(first);
+		out.varint(last);
+	}
+}
+
+regex::character_class decode_character_class(reader& in) {
+	regex::character_class result(in.byte() != 0);
+	for (auto count = in.varint(); count; --count)
+		result.add_character(static_cast<char32_t>(in.varint()));
+	for (auto count = in.varint(); count; --count) {
+		auto first = static_cast<char32_t>(in.varint());
+		result.add_range(first, static_cast<char32_t>(in.varint()));
+	}
+	return result;
+}
+
+void encode(writer& out, const regex::atom& value) {
+	if (value.is_character()) {
+		out.byte(0);
+		out.varint(value.get_character());
+	} else if (value.is_builtin_class()) {
+		out.byte(1);
+		out.byte(static_cast<std::uint8_t>(value.get_builtin_class()));
+	} else if (value.is_character_class()) {
+		out.byte(2);
+		encode(out, value.get_character_class());
+	} else if (value.is_backreference()) {
+		out.byte(4);
+		out.varint(value.get_backreference().number);
+	} else {
+		auto& group = value.get_group();
+		out.byte(3);
+		out.byte(static_cast<std::uint8_t>(group.get_type()));
+		out.byte(group.get_name().has_value());
+		if (group.get_name())
+			out.string(std::u32string_view{*group.get_name()});
+		encode(out, group.get_disjunction());
+	}
+}
+
+regex::atom decode_atom(reader& in) {
+	switch (in.byte()) {
+		case 0:
+			return {static_cast<char32_t>(in.varint())};
+		case 1:
+			return {enum_byte(in, regex::atom::builtin_class::non_whitespace)};
+		case 2:
+			return {decode_character_class(in)};
+		case 3: {
+			auto type = enum_byte(in, regex::group::type::negative_lookbehind);
+			std::optional<std::u32string> name;
+			if (in.byte())
+				name = in.u32string();
+			return {regex::group(type, decode_disjunction(in), std::move(name))};
+		}
+		case 4:
+			return {regex::atom::backreference{in.varint()}};
+		default:
+			throw corrupt_entry{};
+	}
+}
+
+
+void encode(writer& out, const regex::term& value) {
+	if (value.is_assertion()) {
+		out.byte(0);
+		out.byte(static_cast<std::uint8_t>(value.get_assertion().get_type()));
+		return;
+	}
+
+	out.byte(1);
+	encode(out, value.get_atom());
+
+	auto& quantifier = value.get_quantifier();
+	if (!quantifier) {
+		out.byte(0);
+	} else if (quantifier->is_prefix()) {
+		out.byte(1);
+		out.byte(static_cast<std::uint8_t>(quantifier->get_prefix()));
+		out.byte(quantifier->is_greedy());
+	} else {
+		out.byte(2);
+		out.varint(quantifier->get_range().first);
+		out.varint(quantifier->get_range().second);
+		out.byte(quantifier->is_greedy());
+	}
+}
+
+regex::term decode_term(reader& in) {
+	switch (in.byte()) {
+		case 0:
+			return {regex::assertion(
+				enum_byte(in, regex::assertion::type::non_word_boundary))};
+		case 1:
+			break;
+		default:
+			throw corrupt_entry{};
+	}
+
+	auto atom = decode_atom(in);
+	switch (in.byte()) {
+		case 0:
+			return {std::move(atom)};
+		case 1: {
+			auto prefix = static_cast<regex::quantifier::prefix>(in.byte());
+			if (prefix != regex::quantifier::prefix::zero_or_more &&
+				prefix != regex::quantifier::prefix::one_or_more &&
+				prefix != regex::quantifier::prefix::zero_or_one)
+				throw corrupt_entry{};
+			return {std::move(atom), regex::quantifier(prefix, in.byte() != 0)};
+		}
+		case 2: {
+			std::size_t min = in.varint();
+			std::size_t max = in.varint();
+			return {std::move(atom),
+					regex::quantifier(std::pair{min, max}, in.byte() != 0)};
+		}
+		default:
+			throw corrupt_entry{};
+	}
+}
+
+void encode(writer& out, const regex::disjunction& value) {
+	auto alternatives = value.get_alternatives();
+	out.varint(alternatives.size());
+	for (auto& alternative : alternatives) {
+		out.varint(alternative.get_terms().size());
+		for (auto& term : alternative.get_terms())
+			encode(out, term);
+	}
+}
+
+regex::disjunction decode_disjunction(reader& in) {
+	regex::disjunction result;
+	for (auto count = in.varint(); count; --count) {
+		regex::alternative alternative;
+		for (auto terms = in.varint(); terms; --terms)
+			alternative.add_term(decode_term(in));
+		result.add_alternative(std::move(alternative));
+	}
+	return result;
+}
+
+// token payloads, one encode() and decode() pair for each token type that
+// carries data
+
+template <typename Token>
+using tag = std::type_identity<Token>;
+
+void encode(writer& out, const tokens::comment_token& value) {
+	out.string(value.body());
+}
+
+tokens::comment_token decode(reader& in, tag<tokens::comment_token>) {
+	return tokens::comment_token(in.string());
+}
+
+void encode(writer& out, const tokens::conflict_marker_trivia_token& value) {
+	out.byte(static_cast<std::uint8_t>(value.prefix()));
+	out.string(std::u32string_view{value.body()});
+}
+
+tokens::conflict_marker_trivia_token decode(
+	reader& in,
+	tag<tokens::conflict_marker_trivia_token>) {
+	auto prefix = static_cast<char>(in.byte());
+	return {prefix, in.u32string()};
+}
+
+void encode(writer& out, const tokens::constant_value_token& value) {
+	if (auto string = value.string_value()) {
+		out.byte(0);
+		out.string(*string);
+		out.byte(static_cast<std::uint8_t>(*value.quote_char()));
+	} else if (auto integer = value.integer_value()) {
+		// integers that don't fit in 64 bits store their limbs
+		if (auto small = integer->to_int64()) {
+			out.byte(1);
+			out.signed_varint(*small);
+		} else {
+			out.byte(4);
+			out.byte(integer->is_negative());
+			out.varint(integer->limbs().size());
+			for (auto limb : integer->limbs())
+				out.varint(limb);
+		}
+		out.byte(static_cast<std::uint8_t>(*value.base()));
+		out.byte(value.is_bigint());
+	} else {
+		out.byte(2);
+		out.decimal(*value.decimal_value());
+		out.string(*value.decimal_lexeme());
+	}
+}
+
+tokens::constant_value_token decode(reader& in,
+									tag<tokens::constant_value_token>) {
+	auto kind = in.byte();
+	switch (kind) {
+		case 0: {
+			auto string = in.u32string();
+			return {std::move(string), static_cast<char>(in.byte())};
+		}
+		case 1:
+		case 4: {
+			tscc::tscc_big_int integer;
+			if (kind == 1) {
+				integer = in.signed_varint();
+			} else {
+				auto negative = in.byte() != 0;
+				auto count = in.varint();
+				if (count > in.remaining())
+					throw corrupt_entry{};
+
+				std::vector<tscc::big_int::limb> limbs(count);
+				for (auto& limb : limbs)
+					limb = in.varint();
+				integer = tscc::big_int::from_limbs(limbs, negative);
+			}
+
+			auto base = enum_byte(in, tokens::integer_base::hex);
+			auto size = in.byte() ? tokens::integer_size::big_int
+								  : tokens::integer_size::standard;
+			return {std::move(integer), base, size};
+		}
+		case 2: {
+			auto decimal = in.decimal();
+			return {decimal, std::string{in.string()}};
+		}
+		default:
+			throw corrupt_entry{};
+	}
+}
+
+void encode(writer& out, const tokens::identifier_token& value) {
+	out.string(value.id());
+}
+
+tokens::identifier_token decode(reader& in, tag<tokens::identifier_token>) {
+	return tokens::identifier_token(in.string());
+}
+
+void encode(writer& out,
+			const tokens::interpolated_string_chunk_token& value) {
+	out.string(std::u32string_view{value.value()});
+}
+
+tokens::interpolated_string_chunk_token decode(
+	reader& in,
+	tag<tokens::interpolated_string_chunk_token>) {
+	return {in.u32string()};
+}
+
+void encode(writer& out, const tokens::jsdoc_token& value) {
+	using part_type = tokens::jsdoc_token::jsdoc_part_type;
+
+	out.varint(value.lines().size());
+	for (auto& line : value.lines()) {
+		out.varint(line.size());
+		for (std::size_t i = 0; i < line.size(); ++i) {
+			auto& part = line[i];
+			out.byte(static_cast<std::uint8_t>(part.type()));
+			switch (part.type()) {
+				case part_type::string_value:
+					out.string(std::u32string_view{
+						static_cast<const tokens::jsdoc_token::jsdoc_string_part&>(
+							part)
+							.str()});
+					break;
+				case part_type::tag:
+					out.string(
+						static_cast<const tokens::jsdoc_token::jsdoc_tag_part&>(
+							part)
+							.tag());
+					break;
+				case part_type::type_parameter:
+					out.string(std::u32string_view{
+						static_cast<const tokens::jsdoc_token::jsdoc_type_part&>(
+							part)
+							.type_name()});
+					break;
+			}
+		}
+	}
+}
+
+tokens::jsdoc_token decode(reader& in, tag<tokens::jsdoc_token>) {
+	using jsdoc = tokens::jsdoc_token;
+
+	std::vector<jsdoc::jsdoc_line> lines(in.varint());
+	for (auto& line : lines) {
+		for (auto parts = in.varint(); parts; --parts) {
+			switch (enum_byte(in, jsdoc::jsdoc_part_type::type_parameter)) {
+				case jsdoc::jsdoc_part_type::string_value:
+					line.append(jsdoc::jsdoc_string_part(in.u32string()));
+					break;
+				case jsdoc::jsdoc_part_type::tag:
+					line.append(jsdoc::jsdoc_tag_part(std::string(in.string())));
+					break;
+				case jsdoc::jsdoc_part_type::type_parameter:
+					line.append(jsdoc::jsdoc_type_part(in.u32string()));
+					break;
+			}
+		}
+	}
+
+	return jsdoc(std::move(lines));
+}
+
+void encode(writer& out, const tokens::jsx_attribute_name_token& value) {
+	out.string(std::u32string_view{value.name()});
+}
+
+tokens::jsx_attribute_name_token decode(
+	reader& in,
+	tag<tokens::jsx_attribute_name_token>) {
+	return tokens::jsx_attribute_name_token(in.u32string());
+}
+
+void encode(writer& out, const tokens::jsx_attribute_value_token& value) {
+	out.string(std::u32string_view{value.value()});
+	out.byte(static_cast<std::uint8_t>(value.quote_char()));
+}
+
+tokens::jsx_attribute_value_token decode(
+	reader& in,
+	tag<tokens::jsx_attribute_value_token>) {
+	auto value = escape_ampersands(in.u32string());
+	return tokens::jsx_attribute_value_token(value,
+											 static_cast<char>(in.byte()));
+}
+
+void encode(writer& out, const tokens::jsx_element_close_token& value) {
+	out.string(std::u32string_view{value.element_name()});
+}
+
+tokens::jsx_element_close_token decode(
+	reader& in,
+	tag<tokens::jsx_element_close_token>) {
+	return tokens::jsx_element_close_token(in.u32string());
+}
+
+void encode(writer& out, const tokens::jsx_element_start_token& value) {
+	out.string(std::u32string_view{value.element_name()});
+}
+
+tokens::jsx_element_start_token decode(
+	reader& in,
+	tag<tokens::jsx_element_start_token>) {
+	return tokens::jsx_element_start_token(in.u32string());
+}
+
+void encode(writer& out, const tokens::jsx_text_token& value) {
+	out.string(std::u32string_view{value.text()});
+}
+
+tokens::jsx_text_token decode(reader& in, tag<tokens::jsx_text_token>) {
+	return tokens::jsx_text_token(escape_ampersands(in.u32string()));
+}
+
+void encode(writer& out, const tokens::multiline_comment_token& value) {
+	out.varint(value.lines().size());
+	for (auto& line : value.lines())
+		out.string(line);
+}
+
+tokens::multiline_comment_token decode(
+	reader& in,
+	tag<tokens::multiline_comment_token>) {
+	std::vector<std::string> lines(in.varint());
+	for (auto& line : lines)
+		line = in.string();
+	return tokens::multiline_comment_token(std::move(lines));
+}
+
+void encode(writer& out, const tokens::regex_token& value) {
+	out.byte(static_cast<std::uint8_t>(value.get_flags()));
+	encode(out, value.expression().get_disjunction());
+}
+
+tokens::regex_token decode(reader& in, tag<tokens::regex_token>) {
+	auto flags = static_cast<tokens::regex_token::flags>(in.byte());
+	return {regex::regular_expression(decode_disjunction(in)), flags};
+}
+
+void encode(writer& out, const tokens::shebang_token& value) {
+	out.string(value.command());
+}
+
+tokens::shebang_token decode(reader& in, tag<tokens::shebang_token>) {
+	return tokens::shebang_token(in.string());
+}
+
+void encode(writer& out, const tokens::template_start_token& value) {
+	out.byte(value.is_jsx());
+}
+
+tokens::template_start_token decode(reader& in,
+									tag<tokens::template_start_token>) {
+	return {in.byte() != 0};
+}
+
+// the records
+
+using variant_type = token::variant_type;
+
+template <std::size_t... Is>
+void encode_token(writer& out,
+				  const token_table::view& view,
+				  std::index_sequence<Is...>) {
+	using encoder = void (*)(writer&, const token_table::view&);
+
+	static constexpr encoder encoders[] = {
+		[](writer& out, const token_table::view& view) {
+			using token_type = std::variant_alternative_t<Is, variant_type>;
+			if constexpr (token_table::has_payload_v<token_type>)
+				encode(out, *view.template get<token_type>());
+		}...};
+
+	encoders[view.record().kind](out, view);
+}
+
+template <std::size_t... Is>
+void decode_token(reader& in,
+				  token_table& into,
+				  std::size_t kind,
+				  std::size_t offset,
+				  std::size_t length,
+				  std::index_sequence<Is...>) {
+	using decoder =
+		void (*)(reader&, token_table&, std::size_t, std::size_t);
+
+	static constexpr decoder decoders[] = {
+		[](reader& in, token_table& into, std::size_t offset,
+		   std::size_t length) {
+			using token_type = std::variant_alternative_t<Is, variant_type>;
+			if constexpr (token_table::has_payload_v<token_type>) {
+				into.emplace_back<token_type>(
+					offset, length, decode(in, tag<token_type>{}));
+			} else {
+				into.emplace_back<token_type>(offset, length);
+			}
+		}...};
+
+	if (kind >= sizeof...(Is))
+		throw corrupt_entry{};
+	decoders[kind](in, into, offset, length);
+}
+
+constexpr auto all_kinds =
+	std::make_index_sequence<std::variant_size_v<variant_type>>();
+
+std::uint64_t mix(std::uint64_t value) noexcept {
+	value ^= value >> 33;
+	value *= 0xff51afd7ed558ccdULL;
+	value ^= value >> 33;
+	value *= 0xc4ceb9fe1a85ec53ULL;
+	value ^= value >> 33;
+	return value;
+}
+
+}  // namespace
+
+token_cache::token_cache(std::filesystem::path directory)
+	: directory_(std::move(directory)) {
+	std::filesystem::create_directories(directory_);
+}
+
+std::uint64_t token_cache::key(std::string_view bytes,
+							   language_version version,
+							   ts_language_variant variant) noexcept {
+	constexpr std::uint64_t multiplier = 0x9e3779b97f4a7c15ULL;
+
+	std::uint64_t hash = mix(bytes.size() ^ (std::uint64_t{format_version} << 32) ^
+							 (static_cast<std::uint64_t>(version) << 16) ^
+							 (static_cast<std::uint64_t>(variant) << 8));
+
+	// a word at a time; the tail is padded out with zeroes
+	std::size_t at = 0;
+	for (; at + 8 <= bytes.size(); at += 8) {
+		std::uint64_t word;
+		std::memcpy(&word, bytes.data() + at, sizeof(word));
+		hash = std::rotl(hash ^ (word * multiplier), 31) * 0xbf58476d1ce4e5b9ULL;
+	}
+
+	if (at < bytes.size()) {
+		std::uint64_t word = 0;
+		std::memcpy(&word, bytes.data() + at, bytes.size() - at);
+		hash = std::rotl(hash ^ (word * multiplier), 31) * 0xbf58476d1ce4e5b9ULL;
+	}
+
+	return mix(hash);
+}
+
+std::optional<token_table> token_cache::load(std::string_view bytes,
+											 file_id file,
+											 language_version version,
+											 ts_language_variant variant) const {
+	auto entry_key = key(bytes, version, variant);
+
+	std::ifstream stream(entry_path(entry_key), std::ios::binary);
+	if (!stream)
+		return std::nullopt;
+
+	std::string entry{std::istreambuf_iterator<char>(stream),
+					  std::istreambuf_iterator<char>()};
+	if (stream.bad())
+		return std::nullopt;
+
+	try {
+		reader in(entry);
+
+		char found_magic[sizeof(magic)];
+		in.raw(found_magic, sizeof(found_magic));
+		if (std::memcmp(found_magic, magic, sizeof(magic)) != 0 ||
+			in.varint() != format_version)
+			return std::nullopt;
+
+		std::uint64_t found_key;
+		in.raw(&found_key, sizeof(found_key));
+		if (found_key != entry_key || in.varint() != bytes.size() ||
+			in.varint() != static_cast<std::uint64_t>(version) ||
+			in.byte() != static_cast<std::uint8_t>(variant))
+			return std::nullopt;
+
+		token_table result(file);
+		auto count = in.varint();
+		if (count > entry.size())
+			return std::nullopt;
+		result.reserve(count);
+
+		std::size_t end = 0;
+		for (; count; --count) {
+			auto kind = in.varint();
+			auto offset = static_cast<std::int64_t>(end) + in.signed_varint();
+			auto length = in.varint();
+			if (offset < 0 || offset + length > bytes.size())
+				return std::nullopt;
+
+			decode_token(in, result, kind, offset, length, all_kinds);
+			end = offset + length;
+		}
+
+		if (!in.done())
+			return std::nullopt;
+
+		return result;
+	} catch (const corrupt_entry&) {
+		return std::nullopt;
+	}
+}
+
+void token_cache::store(std::string_view bytes,
+						const token_table& tokens,
+						language_version version,
+						ts_language_variant variant) const {
+	auto entry_key = key(bytes, version, variant);
+
+	writer out;
+	out.raw(magic, sizeof(magic));
+	out.varint(format_version);
+	out.raw(&entry_key, sizeof(entry_key));
+	out.varint(bytes.size());
+	out.varint(static_cast<std::uint64_t>(version));
+	out.byte(static_cast<std::uint8_t>(variant));
+
+	out.varint(tokens.size());
+	std::size_t end = 0;
+	for (std::size_t i = 0; i < tokens.size(); ++i) {
+		auto view = tokens[i];
+		out.varint(view.record().kind);
+		out.signed_varint(static_cast<std::int64_t>(view.offset()) -
+						  static_cast<std::int64_t>(end));
+		out.varint(view.length());
+		encode_token(out, view, all_kinds);
+		end = view.offset() + view.length();
+	}
+
+	// written under a name no other writer uses and then renamed over the
+	// entry, so readers only ever see complete entries
+	static std::atomic<std::uint64_t> counter{0};
+	auto path = entry_path(entry_key);
+	auto temporary = path;
+	temporary += "." + std::to_string(std::random_device{}()) + "." +
+				 std::to_string(counter++) + ".tmp";
+
+	{
+		std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+		stream.write(out.data().data(),
+					 static_cast<std::streamsize>(out.data().size()));
+		if (!stream) {
+			std::error_code ignored;
+			std::filesystem::remove(temporary, ignored);
+			return;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporary, path, error);
+	if (error)
+		std::filesystem::remove(temporary, error);
+}
+
+std::filesystem::path token_cache::entry_path(std::uint64_t key) const {
+	static constexpr char digits[] = "0123456789abcdef";
+
+	std::string name(16, '0');
+	for (auto i = name.size(); i-- > 0; key >>= 4)
+		name[i] = digits[key & 0xf];
+
+	return directory_ / (name + ".tokens");
+}
@@ -0,0 +1,104 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include "lexer.hpp"
+#include "source.hpp"
+#include "token_table.hpp"
+
+namespace tscc::lex {
+
+/**
+ * \brief A directory of token tables kept between runs
+ *
+ * Lexing only depends on the bytes of a file, the language version and the
+ * language variant, so the tokens of a file that hasn't changed can be read
+ * back instead of lexed again. Each table is stored in its own file named
+ * after a hash of those inputs, in a compact binary form that holds the
+ * token records along with every string, number and regular expression the
+ * tokens carry.
+ *
+ * Entries are written to a temporary file and renamed into place, so any
+ * number of processes can share the directory. Entries from other format
+ * versions, and entries that don't match the file they're looked up for,
+ * are treated as missing.
+ */
+class token_cache {
+public:
+	/**
+	 * \brief The version of the entry format
+	 *
+	 * Bumped whenever the format or the tokens the lexer produces change, so
+	 * that entries written by an older build are never read back.
+	 */
+	static constexpr std::uint32_t format_version = 4;
+
+	/**
+	 * \brief Use the given directory for the cache, creating it if needed
+	 */
+	explicit token_cache(std::filesystem::path directory);
+
+	/**
+	 * \brief Get the directory entries are kept in
+	 */
+	const std::filesystem::path& directory() const noexcept {
+		return directory_;
+	}
+
+	/**
+	 * \brief Read back the tokens stored for the given file contents
+	 * \param bytes The full contents of the file
+	 * \param file The file the tokens of the returned table belong to
+	 *
+	 * Returns std::nullopt when there is no usable entry.
+	 */
+	std::optional<token_table> load(std::string_view bytes,
+									file_id file,
+									language_version version,
+									ts_language_variant variant) const;
+
+	/**
+	 * \brief Store the tokens lexed from the given file contents
+	 *
+	 * Failing to write the entry isn't an error, the tokens are just lexed
+	 * again next time.
+	 */
+	void store(std::string_view bytes,
+			   const token_table& tokens,
+			   language_version version,
+			   ts_language_variant variant) const;
+
+	/**
+	 * \brief Get the hash that names the entry for the given inputs
+	 */
+	static std::uint64_t key(std::string_view bytes,
+							 language_version version,
+							 ts_language_variant variant) noexcept;
+
+private:
+	std::filesystem::path entry_path(std::uint64_t key) const;
+
+	std::filesystem::path directory_;
+};
+
+}  // namespace tscc::lex
@@ -0,0 +1,126 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include "token.hpp"
+
+namespace tscc::lex {
+
+/**
+ * \brief A set of token kinds
+ *
+ * Sets are built at compile time, and testing whether a token is in one is
+ * a single bit test instead of a chain of variant checks. For example:
+ *
+ * \code c++
+ * constexpr auto modifiers =
+ *     token_set::of<tokens::public_token, tokens::private_token>();
+ * if (modifiers.contains(current)) ...
+ * \endcode
+ */
+class token_set {
+	static constexpr std::size_t word_bits = 64;
+	static constexpr std::size_t word_count =
+		(token_kind_count + word_bits - 1) / word_bits;
+
+public:
+	constexpr token_set() noexcept = default;
+
+	constexpr token_set(std::initializer_list<token_kind> kinds) noexcept {
+		for (auto kind : kinds)
+			insert(kind);
+	}
+
+	/**
+	 * \brief Make the set of the given token types
+	 */
+	template <typename... Tokens>
+	static constexpr token_set of() noexcept {
+		return token_set{token::kind_of<Tokens>()...};
+	}
+
+	/**
+	 * \brief Add a kind to the set
+	 */
+	constexpr void insert(token_kind kind) noexcept {
+		auto index = static_cast<std::size_t>(kind);
+		words_[index / word_bits] |= std::uint64_t{1} << (index % word_bits);
+	}
+
+	/**
+	 * \brief Whether the kind is in the set
+	 */
+	[[nodiscard]] constexpr bool contains(token_kind kind) const noexcept {
+		auto index = static_cast<std::size_t>(kind);
+		return (words_[index / word_bits] >> (index % word_bits)) & 1;
+	}
+
+	/**
+	 * \brief Whether the token's kind is in the set
+	 *
+	 * An undefined token isn't in any set.
+	 */
+	[[nodiscard]] bool contains(const token& tok) const noexcept {
+		return !tok.undefined() && contains(tok.kind());
+	}
+
+	/**
+	 * \brief Whether the set has no kinds
+	 */
+	[[nodiscard]] constexpr bool empty() const noexcept {
+		for (auto word : words_) {
+			if (word)
+				return false;
+		}
+		return true;
+	}
+
+	/**
+	 * \brief Get the kinds in either set
+	 */
+	[[nodiscard]] constexpr token_set operator|(
+		const token_set& other) const noexcept {
+		token_set result;
+		for (std::size_t i = 0; i < word_count; ++i)
+			result.words_[i] = words_[i] | other.words_[i];
+		return result;
+	}
+
+	/**
+	 * \brief Get the kinds in both sets
+	 */
+	[[nodiscard]] constexpr token_set operator&(
+		const token_set& other) const noexcept {
+		token_set result;
+		for (std::size_t i = 0; i < word_count; ++i)
+			result.words_[i] = words_[i] & other.words_[i];
+		return result;
+	}
+
+	constexpr bool operator==(const token_set&) const noexcept = default;
+
+private:
+	std::array<std::uint64_t, word_count> words_{};
+};
+
+}  // namespace tscc::lex
@@ -0,0 +1,159 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "token_table.hpp"
+#include <stdexcept>
+#include "lexer.hpp"
+
+using namespace tscc::lex;
+
+token_table::token_table(file_id file) : file_(file) {}
+
+std::uint32_t token_table::narrow(std::size_t value) {
+	if (value > std::numeric_limits<std::uint32_t>::max())
+		throw std::length_error("source files over 4GiB can't be tokenized "
+								"into a token table");
+	return static_cast<std::uint32_t>(value);
+}
+
+token_table token_table::tokenize(lexer& lex) {
+	token_table result(lex.file());
+	token current;
+	while (lex.next(current)) {
+		// the lexer stops right after the token it just produced
+		result.push_back(current, lex.offset() - current.location().offset());
+	}
+
+	return result;
+}
+
+void token_table::push_back(const token& tok, std::size_t length) {
+	compact_token record{};
+	record.kind = static_cast<std::uint16_t>(tok.index());
+	record.offset = narrow(tok.location().offset());
+	record.length = narrow(length);
+	record.payload = compact_token::no_payload;
+
+	tok.visit([this, &record](const auto& value) {
+		using token_type = std::remove_cvref_t<decltype(value)>;
+		if constexpr (has_payload_v<token_type>) {
+			auto& table = std::get<std::vector<token_type>>(tables_);
+			record.payload = narrow(table.size());
+			table.push_back(value);
+		}
+	});
+
+	tokens_.push_back(record);
+}
+
+void token_table::splice(std::size_t first,
+						 std::size_t last,
+						 token_table&& replacement,
+						 std::ptrdiff_t shift) {
+	if (first > last || last > tokens_.size())
+		throw std::out_of_range("the run of tokens to replace is out of range");
+
+	for (auto i = last; i < tokens_.size(); ++i) {
+		tokens_[i].offset =
+			narrow(static_cast<std::size_t>(tokens_[i].offset + shift));
+	}
+
+	constexpr auto kinds =
+		std::make_index_sequence<std::variant_size_v<variant_type>>();
+	for (auto& record : replacement.tokens_) {
+		if (record.payload != compact_token::no_payload)
+			record.payload = take_payload(replacement, record, kinds);
+	}
+
+	auto at = tokens_.erase(tokens_.begin() + first, tokens_.begin() + last);
+	tokens_.insert(at, replacement.tokens_.begin(), replacement.tokens_.end());
+	file_ = replacement.file_;
+}
+
+template <std::size_t... Is>
+std::uint32_t token_table::take_payload(token_table& from,
+										const compact_token& record,
+										std::index_sequence<Is...>) {
+	using mover = std::uint32_t (*)(token_table&, token_table&,
+									std::uint32_t);
+
+	static constexpr mover movers[] = {
+		[](token_table& into, token_table& from, std::uint32_t payload) {
+			using token_type = std::variant_alternative_t<Is, variant_type>;
+			if constexpr (has_payload_v<token_type>) {
+				auto& table = std::get<std::vector<token_type>>(into.tables_);
+				auto index = narrow(table.size());
+				table.push_back(std::move(
+					std::get<std::vector<token_type>>(from.tables_)[payload]));
+				return index;
+			} else {
+				return payload;
+			}
+		}...};
+
+	return movers[record.kind](*this, from, record.payload);
+}
+
+token token_table::materialize(std::size_t index) const {
+	return materialize(
+		*this, tokens_[index],
+		std::make_index_sequence<std::variant_size_v<variant_type>>());
+}
+
+template <std::size_t... Is>
+token token_table::materialize(const token_table& table,
+							   const compact_token& record,
+							   std::index_sequence<Is...>) {
+	using factory = token (*)(const token_table&, const compact_token&);
+
+	static constexpr factory factories[] = {
+		[](const token_table& table, const compact_token& record) {
+			using token_type = std::variant_alternative_t<Is, variant_type>;
+
+			source_location location{table.file_, record.offset};
+			if constexpr (has_payload_v<token_type>) {
+				return make_token<token_type>(
+					location, std::get<std::vector<token_type>>(
+								  table.tables_)[record.payload]);
+			} else {
+				return make_token<token_type>(location);
+			}
+		}...};
+
+	return factories[record.kind](table, record);
+}
+
+std::size_t token_table::memory_usage() const noexcept {
+	auto result = tokens_.capacity() * sizeof(compact_token);
+
+	std::apply(
+		[&result](const auto&... tables) {
+			((result += tables.capacity() *
+						sizeof(typename std::remove_cvref_t<
+							   decltype(tables)>::value_type)),
+			 ...);
+		},
+		tables_);
+
+	return result;
+}
+
+token token_table::view::materialize() const {
+	return table_->materialize(
+		static_cast<std::size_t>(record_ - table_->tokens_.data()));
+}
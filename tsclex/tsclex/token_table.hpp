@@ -0,0 +1,272 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "source_registry.hpp"
+#include "token.hpp"
+
+namespace tscc::lex {
+
+class lexer;
+
+/**
+ * \brief A token packed into 16 bytes
+ *
+ * The kind is the position of the token type in the list of token types
+ * (the same value token::index() returns). Tokens that carry data - strings,
+ * numbers, identifiers, regular expressions etc - keep it in the side tables
+ * of the owning token_table and payload indexes into the table for their kind.
+ */
+struct compact_token {
+	static constexpr std::uint32_t no_payload =
+		std::numeric_limits<std::uint32_t>::max();
+
+	std::uint16_t kind;
+	std::uint16_t reserved;
+	std::uint32_t offset;
+	std::uint32_t length;
+	std::uint32_t payload;
+};
+
+static_assert(sizeof(compact_token) == 16);
+static_assert(std::is_trivially_copyable_v<compact_token>);
+
+/**
+ * \brief The tokens of a single file in compact form
+ *
+ * Tokens are stored as compact_token records with their data kept in
+ * per-type side tables. The file is stored once for the whole table and the
+ * line and column of a token come from the source_registry, so a token is
+ * little more than its offset until the full token is materialized.
+ */
+class token_table {
+public:
+	/**
+	 * \brief Whether tokens of the type carry data kept in a side table
+	 */
+	template <typename T>
+	static constexpr bool has_payload_v = !std::is_default_constructible_v<T>;
+
+private:
+	using variant_type = token::variant_type;
+
+	template <typename>
+	struct side_tables_of;
+
+	template <typename... Ts>
+	struct side_tables_of<std::variant<Ts...>> {
+		using type = decltype(std::tuple_cat(
+			std::declval<std::conditional_t<has_payload_v<Ts>,
+											std::tuple<std::vector<Ts>>,
+											std::tuple<>>>()...));
+	};
+
+	using side_tables = typename side_tables_of<variant_type>::type;
+
+public:
+	/**
+	 * \brief A non-owning view of a single token in a table
+	 *
+	 * Reading the kind, offset, length or payload never copies anything. The
+	 * full token is only built when materialize() is called.
+	 */
+	class view {
+	public:
+		/**
+		 * \brief Get whether the token is of the particular type
+		 */
+		template <typename Token>
+		bool is() const noexcept {
+			return record_->kind == token::index_of<Token>();
+		}
+
+		/**
+		 * \brief Get the data of the token if it is of the given type
+		 *
+		 * Returns a pointer into the side table, or nullptr when the token is
+		 * a different type.
+		 */
+		template <typename Token>
+		const Token* get() const noexcept {
+			static_assert(has_payload_v<Token>,
+						  "the token type doesn't carry any data");
+			if (!is<Token>())
+				return nullptr;
+
+			return &std::get<std::vector<Token>>(
+				table_->tables_)[record_->payload];
+		}
+
+		/**
+		 * \brief Get the compact record for the token
+		 */
+		const compact_token& record() const noexcept { return *record_; }
+
+		/**
+		 * \brief Get the offset of the first byte of the token
+		 */
+		std::size_t offset() const noexcept { return record_->offset; }
+
+		/**
+		 * \brief Get the length of the token in bytes
+		 */
+		std::size_t length() const noexcept { return record_->length; }
+
+		/**
+		 * \brief Build the full token
+		 */
+		token materialize() const;
+
+	private:
+		view(const token_table* table, const compact_token* record) noexcept
+			: table_(table), record_(record) {}
+
+		const token_table* table_;
+		const compact_token* record_;
+
+		friend class token_table;
+	};
+
+	explicit token_table(file_id file);
+
+	/**
+	 * \brief Read every token out of the lexer into a new table
+	 */
+	static token_table tokenize(lexer& lex);
+
+	/**
+	 * \brief Add a token to the end of the table
+	 * \param tok The token. Its data is copied into the side tables
+	 * \param length The number of bytes of source text the token spans
+	 */
+	void push_back(const token& tok, std::size_t length);
+
+	/**
+	 * \brief Add a token of the given type to the end of the table
+	 * \param offset The offset of the first byte of the token
+	 * \param length The number of bytes of source text the token spans
+	 * \param args The arguments for the token's constructor
+	 *
+	 * The token's data is built straight into its side table, without a
+	 * token being made first.
+	 */
+	template <typename Token, typename... Args>
+	void emplace_back(std::size_t offset, std::size_t length, Args&&... args) {
+		compact_token record{};
+		record.kind = static_cast<std::uint16_t>(token::index_of<Token>());
+		record.offset = narrow(offset);
+		record.length = narrow(length);
+		record.payload = compact_token::no_payload;
+
+		if constexpr (has_payload_v<Token>) {
+			auto& table = std::get<std::vector<Token>>(tables_);
+			record.payload = narrow(table.size());
+			table.emplace_back(std::forward<Args>(args)...);
+		}
+
+		tokens_.push_back(record);
+	}
+
+	/**
+	 * \brief Replace a run of tokens with the tokens of another table
+	 * \param first The index of the first token to replace
+	 * \param last One past the index of the last token to replace
+	 * \param replacement The tokens to put in their place. Their data is
+	 * moved out of the table
+	 * \param shift Added to the offset of every token after the run
+	 *
+	 * The table takes on the file of the replacement, since it is for the
+	 * text the shifted offsets refer to. The data of the tokens that were
+	 * replaced stays in the side tables.
+	 */
+	void splice(std::size_t first,
+				std::size_t last,
+				token_table&& replacement,
+				std::ptrdiff_t shift);
+
+	/**
+	 * \brief Make room for the given number of tokens
+	 */
+	void reserve(std::size_t count) { tokens_.reserve(count); }
+
+	/**
+	 * \brief Get the number of tokens in the table
+	 */
+	std::size_t size() const noexcept { return tokens_.size(); }
+
+	/**
+	 * \brief Whether the table holds no tokens
+	 */
+	bool empty() const noexcept { return tokens_.empty(); }
+
+	/**
+	 * \brief Get a view of the token at the given index
+	 */
+	view operator[](std::size_t index) const noexcept {
+		return {this, &tokens_[index]};
+	}
+
+	/**
+	 * \brief Get all of the compact records in order
+	 */
+	std::span<const compact_token> records() const noexcept {
+		return tokens_;
+	}
+
+	/**
+	 * \brief Build the full token at the given index
+	 */
+	token materialize(std::size_t index) const;
+
+	/**
+	 * \brief Get the file the tokens were read from
+	 */
+	file_id file() const noexcept { return file_; }
+
+	/**
+	 * \brief Get the approximate number of bytes held by the table
+	 */
+	std::size_t memory_usage() const noexcept;
+
+private:
+	static std::uint32_t narrow(std::size_t value);
+
+	template <std::size_t... Is>
+	std::uint32_t take_payload(token_table& from,
+							   const compact_token& record,
+							   std::index_sequence<Is...>);
+
+	template <std::size_t... Is>
+	static token materialize(const token_table& table,
+							 const compact_token& record,
+							 std::index_sequence<Is...>);
+
+	file_id file_;
+	std::vector<compact_token> tokens_;
+	side_tables tables_;
+};
+
+}  // namespace tscc::lex
@@ -24,6 +24,9 @@ using namespace tscc::lex::tokens;
 comment_token::comment_token(const std::u32string& comment_body)
 	: body_(utf8_encode(comment_body)) {}
 
+comment_token::comment_token(std::string_view comment_body)
+	: body_(comment_body) {}
+
 bool comment_token::operator==(
 	const tscc::lex::tokens::comment_token& other) const {
 	return body_ == other.body_;
@@ -34,6 +37,10 @@ bool comment_token::operator!=(
 	return body_ != other.body_;
 }
 
+const std::string& comment_token::body() const noexcept {
+	return body_;
+}
+
 std::string comment_token::to_string() const
 {
 	return "// " + body_;
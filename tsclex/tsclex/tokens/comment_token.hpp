@@ -19,6 +19,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include "basic_token.hpp"
 
 namespace tscc::lex::tokens {
@@ -30,9 +31,19 @@ class comment_token : public basic_token {
 public:
 	comment_token(const std::u32string& comment_body);
 
+	/**
+	 * \brief Construct the comment from its UTF-8 text
+	 */
+	explicit comment_token(std::string_view comment_body);
+
 	bool operator==(const comment_token& other) const;
 	bool operator!=(const comment_token& other) const;
 
+	/**
+	 * \brief Get the text of the comment after the slashes, as UTF-8
+	 */
+	const std::string& body() const noexcept;
+
 	std::string to_string() const override;
 
 private:
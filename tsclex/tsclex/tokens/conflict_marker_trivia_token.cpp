@@ -36,6 +36,14 @@ bool conflict_marker_trivia_token::operator!=(
 	return prefix_ != other.prefix_ || body_ != other.body_;
 }
 
+char conflict_marker_trivia_token::prefix() const noexcept {
+	return prefix_;
+}
+
+const std::u32string& conflict_marker_trivia_token::body() const noexcept {
+	return body_;
+}
+
 std::string conflict_marker_trivia_token::to_string() const {
 	std::string result(static_cast<std::string::size_type>(7), prefix_);
 	if (!body_.empty()) {
@@ -32,6 +32,16 @@ public:
 	bool operator==(const conflict_marker_trivia_token& other) const;
 	bool operator!=(const conflict_marker_trivia_token& other) const;
 
+	/**
+	 * \brief Get the character the marker is made of (<, =, > or |)
+	 */
+	char prefix() const noexcept;
+
+	/**
+	 * \brief Get the text after the marker
+	 */
+	const std::u32string& body() const noexcept;
+
 	std::string to_string() const override;
 
 private:
@@ -17,20 +17,11 @@
  */
 
 #include "constant_value_token.hpp"
-#include <bitset>
-#include <cmath>
-#include <iomanip>
+#include <charconv>
+#include <iterator>
 #include <limits>
-#include <sstream>
 #include <tsccore/json.hpp>
 
-// For the 64 bit limitations w/ valgrind
-#if __has_include(<valgrind/valgrind.h>)
-#include <valgrind/valgrind.h>
-#else
-#define RUNNING_ON_VALGRIND false
-#endif
-
 using namespace tscc::lex::tokens;
 
 constant_value_token::constant_value_token(std::u32string string_value,
@@ -40,15 +31,11 @@ constant_value_token::constant_value_token(std::u32string string_value,
 constant_value_token::constant_value_token(tscc_big_int integer_value,
 										   integer_base base,
 										   integer_size size)
-	: value_(integer_data(integer_value, base, size)) {}
-
-constant_value_token::constant_value_token(long double decimal_value)
-	: value_(decimal_value) {}
+	: value_(integer_data(std::move(integer_value), base, size)) {}
 
-constant_value_token::constant_value_token(long double decimal_value,
-										   int scientific_notation_e,
-										   bool upper)
-	: value_(float_data(decimal_value, scientific_notation_e, upper)) {}
+constant_value_token::constant_value_token(double decimal_value,
+										   std::string lexeme)
+	: value_(float_data(decimal_value, std::move(lexeme))) {}
 
 bool constant_value_token::operator==(
 	const tscc::lex::tokens::constant_value_token& other) const {
@@ -72,12 +59,48 @@ std::optional<std::u32string_view> constant_value_token::string_value()
 	return std::get<string_data>(value_).value;
 }
 
-std::optional<tscc::tscc_big_int> constant_value_token::integer_value()
-	const noexcept {
+std::optional<char> constant_value_token::quote_char() const noexcept {
+	if (!std::holds_alternative<string_data>(value_))
+		return std::nullopt;
+
+	return std::get<string_data>(value_).quote;
+}
+
+std::optional<integer_base> constant_value_token::base() const noexcept {
 	if (!std::holds_alternative<integer_data>(value_))
 		return std::nullopt;
 
-	return std::get<integer_data>(value_).value;
+	return std::get<integer_data>(value_).base;
+}
+
+std::optional<std::pair<int, bool>> constant_value_token::scientific_notation()
+	const noexcept {
+	if (!std::holds_alternative<float_data>(value_))
+		return std::nullopt;
+
+	std::string_view lexeme = std::get<float_data>(value_).lexeme;
+	auto e = lexeme.find_first_of("eE");
+	if (e == std::string_view::npos)
+		return std::nullopt;
+
+	auto digits = lexeme.substr(e + 1);
+	bool negative = !digits.empty() && digits.front() == '-';
+	if (!digits.empty() && (digits.front() == '-' || digits.front() == '+'))
+		digits.remove_prefix(1);
+
+	// exponents too large for an int only matter as "very large"
+	int exponent = std::numeric_limits<int>::max();
+	std::from_chars(digits.data(), digits.data() + digits.size(), exponent);
+
+	return std::pair{negative ? -exponent : exponent, lexeme[e] == 'E'};
+}
+
+const tscc::tscc_big_int* constant_value_token::integer_value()
+	const noexcept {
+	if (!std::holds_alternative<integer_data>(value_))
+		return nullptr;
+
+	return &std::get<integer_data>(value_).value;
 }
 
 bool constant_value_token::is_bigint() const noexcept {
@@ -87,77 +110,64 @@ bool constant_value_token::is_bigint() const noexcept {
 	return std::get<integer_data>(value_).size == integer_size::big_int;
 }
 
-std::optional<long double> constant_value_token::decimal_value()
+std::optional<double> constant_value_token::decimal_value() const noexcept {
+	if (!std::holds_alternative<float_data>(value_))
+		return std::nullopt;
+
+	return std::get<float_data>(value_).value;
+}
+
+std::optional<std::string_view> constant_value_token::decimal_lexeme()
 	const noexcept {
 	if (!std::holds_alternative<float_data>(value_))
 		return std::nullopt;
 
-	auto& fd = std::get<float_data>(value_);
-	if (fd.scientific_exponent)
-		return fd.value * std::pow(1.0l, fd.scientific_exponent->exponent);
-	return fd.value;
+	return std::get<float_data>(value_).lexeme;
 }
 
 std::string constant_value_token::to_string() const {
-	static thread_local std::stringstream str;
-
 	if (std::holds_alternative<string_data>(value_)) {
 		auto& d = std::get<string_data>(value_);
 		return to_json_string(d.value, d.quote);
 	} else if (std::holds_alternative<integer_data>(value_)) {
 		auto& d = std::get<integer_data>(value_);
 
-		str.clear();
-		str.seekp(0, std::ios::beg);
-		str.str(std::string{});
-
+		std::string result;
 		switch (d.base) {
-			case integer_base::binary: {
-				auto bstr =
-					std::bitset<sizeof(d.value) * 8>(d.value).to_string();
-				auto f1 = bstr.find('1');
-				if (f1 == std::string::npos) {
-					str << "0b0";
-				} else {
-					std::string_view view = bstr;
-					str << "0b" << view.substr(f1);
-				}
-
+			case integer_base::binary:
+				result = "0b" + d.value.to_string(2);
 				break;
-			}
 			case integer_base::octal:
-				str << "0o" << std::oct << d.value;
+				result = "0o" + d.value.to_string(8);
 				break;
 			case integer_base::hex:
-				str << std::hex << "0x" << d.value;
+				result = "0x" + d.value.to_string(16);
 				break;
 			default:
-				str << std::dec << d.value;
+				result = d.value.to_string();
 		}
 		if (d.size == integer_size::big_int) {
-			str << "n";
+			result += 'n';
 		}
 
-		return str.str();
+		return result;
 	} else {
 		auto& d = std::get<float_data>(value_);
 
-		str.clear();
-		str.seekp(0, std::ios::beg);
-		str.str(std::string{});
-
-		static const auto precision =
-			RUNNING_ON_VALGRIND
-				? std::numeric_limits<double>::max_digits10
-				: std::numeric_limits<decltype(d.value)>::max_digits10 + 2;
-		if (d.scientific_exponent) {
-			str << std::setprecision(precision - 3) << d.value
-				<< (d.scientific_exponent->upper_case_e ? 'E' : 'e')
-				<< d.scientific_exponent->exponent;
-		} else {
-			str << std::setprecision(precision) << d.value;
+		// scientific notation is kept the way it was written, less any '+' on
+		// the exponent. Other decimals are written as the shortest text that
+		// reads back as the same value
+		if (d.lexeme.find_first_of("eE") != std::string::npos) {
+			std::string result;
+			for (auto ch : d.lexeme) {
+				if (ch != '+')
+					result += ch;
+			}
+			return result;
 		}
 
-		return str.str();
+		char text[32];
+		auto written = std::to_chars(std::begin(text), std::end(text), d.value);
+		return {text, written.ptr};
 	}
 }
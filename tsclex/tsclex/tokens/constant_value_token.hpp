@@ -20,6 +20,8 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <variant>
 #include <tsccore/bigint.hpp>
 #include "basic_token.hpp"
@@ -36,23 +38,48 @@ class constant_value_token : public basic_token {
 public:
 	constant_value_token(std::u32string string_value, char quote_char);
 	constant_value_token(tscc_big_int integer_value, integer_base base, integer_size size = integer_size::standard);
-	constant_value_token(long double decimal_value);
-	constant_value_token(long double decimal_value,
-						 int scientific_notation_e,
-						 bool upper = false);
+	/**
+	 * \brief Make a decimal from its value and the literal it was read from,
+	 * without separators
+	 */
+	constant_value_token(double decimal_value, std::string lexeme);
 
 	bool operator==(const constant_value_token& other) const;
 	bool operator!=(const constant_value_token& other) const;
 
 	std::string to_string() const override;
 
-	std::optional<tscc_big_int> integer_value() const noexcept;
+	/**
+	 * \brief Get the value of an integer, or nullptr for other constants
+	 */
+	const tscc_big_int* integer_value() const noexcept;
 	bool is_bigint() const noexcept;
-	std::optional<long double> decimal_value() const noexcept;
+	std::optional<double> decimal_value() const noexcept;
+
+	/**
+	 * \brief Get the literal a decimal was read from, without separators
+	 */
+	std::optional<std::string_view> decimal_lexeme() const noexcept;
 
 	bool is_string() const;
 	std::optional<std::u32string_view> string_value() const noexcept;
 
+	/**
+	 * \brief Get the quote a string was written with
+	 */
+	std::optional<char> quote_char() const noexcept;
+
+	/**
+	 * \brief Get the base an integer was written in
+	 */
+	std::optional<integer_base> base() const noexcept;
+
+	/**
+	 * \brief Get the exponent of a decimal that was written in scientific
+	 * notation, and whether its 'E' was upper case
+	 */
+	std::optional<std::pair<int, bool>> scientific_notation() const noexcept;
+
 private:
 	struct string_data {
 		std::u32string value;
@@ -75,52 +102,30 @@ private:
 		integer_base base;
 		integer_size size;
 
-		constexpr integer_data(tscc_big_int v, integer_base b) noexcept
-			: value(v), base(b), size(integer_size::standard) {}
-		constexpr integer_data(tscc_big_int v, integer_base b, integer_size s) noexcept
-			: value(v), base(b), size(s) {}
+		integer_data(tscc_big_int v, integer_base b) noexcept
+			: value(std::move(v)), base(b), size(integer_size::standard) {}
+		integer_data(tscc_big_int v, integer_base b, integer_size s) noexcept
+			: value(std::move(v)), base(b), size(s) {}
 
-		constexpr bool operator==(const integer_data& other) const noexcept {
+		bool operator==(const integer_data& other) const noexcept {
 			return value == other.value && base == other.base && size == other.size;
 		}
-		constexpr bool operator!=(const integer_data& other) const noexcept {
-			return !operator==(other);
-		}
-	};
-
-	struct float_representation_flags {
-		int exponent;
-		bool upper_case_e;
-
-		constexpr float_representation_flags(int exp, bool upper) noexcept
-			: exponent(exp), upper_case_e(upper) {}
-
-		constexpr bool operator==(
-			const float_representation_flags& other) const noexcept {
-			return exponent == other.exponent &&
-				   upper_case_e == other.upper_case_e;
-		}
-		constexpr bool operator!=(
-			const float_representation_flags& other) const noexcept {
+		bool operator!=(const integer_data& other) const noexcept {
 			return !operator==(other);
 		}
 	};
 
 	struct float_data {
-		long double value;
-		std::optional<float_representation_flags> scientific_exponent;
+		double value;
+		std::string lexeme;
 
-		constexpr float_data(long double v) noexcept : value(v) {}
-		constexpr float_data(long double v, int exp, bool upper) noexcept
-			: value(v) {
-			scientific_exponent.emplace(exp, upper);
-		}
+		float_data(double v, std::string l) noexcept
+			: value(v), lexeme(std::move(l)) {}
 
-		constexpr bool operator==(const float_data& other) const noexcept {
-			return value == other.value &&
-				   scientific_exponent == other.scientific_exponent;
+		bool operator==(const float_data& other) const noexcept {
+			return value == other.value && lexeme == other.lexeme;
 		}
-		constexpr bool operator!=(const float_data& other) const noexcept {
+		bool operator!=(const float_data& other) const noexcept {
 			return !operator==(other);
 		}
 	};
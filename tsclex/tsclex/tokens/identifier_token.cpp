@@ -17,12 +17,14 @@
  */
 
 #include "identifier_token.hpp"
-#include <tsccore/utf8.hpp>
 
 using namespace tscc::lex::tokens;
 
 identifier_token::identifier_token(const std::u32string& identifier)
-	: id_(utf8_encode(identifier)) {}
+	: id_(tscc::interner::global().intern(std::u32string_view{identifier})) {}
+
+identifier_token::identifier_token(std::string_view identifier)
+	: id_(tscc::interner::global().intern(identifier)) {}
 
 bool identifier_token::operator==(
 	const tscc::lex::tokens::identifier_token& other) const {
@@ -34,10 +36,14 @@ bool identifier_token::operator!=(
 	return id_ != other.id_;
 }
 
-const std::string& identifier_token::id() const noexcept {
+std::string_view identifier_token::id() const {
+	return tscc::interner::global().view(id_);
+}
+
+tscc::atom identifier_token::name() const noexcept {
 	return id_;
 }
 
 std::string identifier_token::to_string() const {
-	return id_;
+	return std::string{id()};
 }
\ No newline at end of file
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <string_view>
+#include <tsccore/interner.hpp>
 #include "basic_token.hpp"
 
 namespace tscc::lex::tokens {
@@ -27,15 +29,30 @@ class identifier_token : public basic_token
 public:
 	explicit identifier_token(const std::u32string& identifier);
 
+	/**
+	 * \brief Construct the identifier from its UTF-8 text
+	 */
+	explicit identifier_token(std::string_view identifier);
+
 	bool operator==(const identifier_token& other) const;
 	bool operator!=(const identifier_token& other) const;
 
-	const std::string& id() const noexcept;
+	/**
+	 * \brief Get the text of the identifier
+	 *
+	 * The text is held by the global interner so the view stays valid
+	 */
+	std::string_view id() const;
+
+	/**
+	 * \brief Get the interned name of the identifier
+	 */
+	tscc::atom name() const noexcept;
 
 	std::string to_string() const override;
 
 private:
-	std::string id_;
+	tscc::atom id_;
 };
 
 }
\ No newline at end of file
@@ -294,6 +294,9 @@ jsdoc_token::jsdoc_token(const std::span<std::u32string>& comment_lines) {
 	lines_.shrink_to_fit();
 }
 
+jsdoc_token::jsdoc_token(std::vector<jsdoc_line> lines)
+	: lines_(std::move(lines)) {}
+
 bool jsdoc_token::operator==(const jsdoc_token& other) const {
 	if (lines_.size() != other.lines_.size())
 		return false;
@@ -128,6 +128,11 @@ public:
 
 	jsdoc_token(const std::span<std::u32string>& comment_lines);
 
+	/**
+	 * \brief Construct the token from lines that are already split into parts
+	 */
+	explicit jsdoc_token(std::vector<jsdoc_line> lines);
+
 	bool operator==(const jsdoc_token& other) const;
 	bool operator!=(const jsdoc_token& other) const;
 
@@ -41,6 +41,10 @@ const std::u32string& jsx_attribute_value_token::value() const noexcept {
 	return value_;
 }
 
+char jsx_attribute_value_token::quote_char() const noexcept {
+	return quote_char_;
+}
+
 std::string jsx_attribute_value_token::to_string() const {
 	return quote_char_ + utf8_encode(xml_encode(value_)) + quote_char_;
 }
\ No newline at end of file
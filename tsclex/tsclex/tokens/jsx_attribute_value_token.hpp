@@ -32,6 +32,11 @@ public:
 	bool operator!=(const jsx_attribute_value_token& other) const;
 
 	const std::u32string& value() const noexcept;
+
+	/**
+	 * \brief Get the quote the value was written in
+	 */
+	char quote_char() const noexcept;
 	std::string to_string() const override;
 
 private:
@@ -31,6 +31,10 @@ multiline_comment_token::multiline_comment_token(
 	}
 }
 
+multiline_comment_token::multiline_comment_token(
+	std::vector<std::string> comment_lines)
+	: lines_(std::move(comment_lines)) {}
+
 bool multiline_comment_token::operator==(
 	const multiline_comment_token& other) const {
 	if (lines_.size() != other.lines_.size()) {
@@ -32,6 +32,11 @@ class multiline_comment_token : public basic_token {
 public:
 	multiline_comment_token(const std::span<std::u32string>& comment_lines);
 
+	/**
+	 * \brief Construct the comment from lines that are already UTF-8
+	 */
+	explicit multiline_comment_token(std::vector<std::string> comment_lines);
+
 	bool operator==(const multiline_comment_token& other) const;
 	bool operator!=(const multiline_comment_token& other) const;
 
@@ -69,3 +69,8 @@ std::string regex_token::to_string() const {
 regex_token::flags regex_token::get_flags() const noexcept {
 	return flags_;
 }
+
+const tsccore::regex::regular_expression& regex_token::expression()
+	const noexcept {
+	return expr_;
+}
@@ -45,6 +45,11 @@ public:
 
 	flags get_flags() const noexcept;
 
+	/**
+	 * \brief Get the parsed pattern between the slashes
+	 */
+	const tsccore::regex::regular_expression& expression() const noexcept;
+
 private:
 	tsccore::regex::regular_expression expr_;
 	flags flags_;
@@ -24,6 +24,8 @@ using namespace tscc::lex::tokens;
 shebang_token::shebang_token(const std::u32string& command)
 	: cmd_(utf8_encode(command)) {}
 
+shebang_token::shebang_token(std::string_view command) : cmd_(command) {}
+
 bool shebang_token::operator==(
 	const tscc::lex::tokens::shebang_token& other) const {
 	return cmd_ == other.cmd_;
@@ -34,6 +36,10 @@ bool shebang_token::operator!=(
 	return cmd_ != other.cmd_;
 }
 
+const std::string& shebang_token::command() const noexcept {
+	return cmd_;
+}
+
 std::string shebang_token::to_string() const {
 	return "#!" + cmd_;
 }
\ No newline at end of file
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include "basic_token.hpp"
 
 namespace tscc::lex::tokens {
@@ -27,9 +28,19 @@ class shebang_token : public basic_token {
 public:
 	shebang_token(const std::u32string& command);
 
+	/**
+	 * \brief Construct the shebang from its UTF-8 command
+	 */
+	explicit shebang_token(std::string_view command);
+
 	bool operator==(const shebang_token& other) const;
 	bool operator!=(const shebang_token& other) const;
 
+	/**
+	 * \brief Get the command after the #!, as UTF-8
+	 */
+	const std::string& command() const noexcept;
+
 	std::string to_string() const override;
 
 private:
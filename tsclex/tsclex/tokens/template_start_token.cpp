@@ -32,6 +32,10 @@ bool template_start_token::operator!=(
 	return false;
 }
 
+bool template_start_token::is_jsx() const noexcept {
+	return isjsx_;
+}
+
 std::string template_start_token::to_string() const {
 	return isjsx_ ? "{" : "${";
 }
\ No newline at end of file
@@ -30,6 +30,12 @@ public:
 	bool operator==(const template_start_token& other) const;
 	bool operator!=(const template_start_token& other) const;
 
+	/**
+	 * \brief Whether the template opens a JSX expression rather than a
+	 * template literal substitution
+	 */
+	bool is_jsx() const noexcept;
+
 	std::string to_string() const override;
 
 private:
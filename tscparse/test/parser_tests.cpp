@@ -95,6 +95,28 @@ TEST_CASE("Parser Basic Construction", "[parser]") {
 		REQUIRE(root != nullptr);
 		REQUIRE(root->source() == source);
 	}
+
+	SECTION("Nodes are allocated from the source file's arena") {
+		std::stringstream small("type A = string;");
+		std::stringstream large(
+			"type A = string | number | (B & C)[];\n"
+			"type D<T> = Map<T, E | F | G>;\n"
+			"import { h, i as j } from \"k\";");
+		auto source = std::make_shared<fake_source>("test.ts");
+
+		tscc::lex::lexer small_lexer(small, source);
+		tscc::parse::parser small_parser(small_lexer);
+		auto small_root = small_parser.parse();
+
+		tscc::lex::lexer large_lexer(large, source);
+		tscc::parse::parser large_parser(large_lexer);
+		auto large_root = large_parser.parse();
+
+		REQUIRE(large_root->children().size() == 3);
+		CHECK(small_root->arena().bytes_used() > 0);
+		CHECK(large_root->arena().bytes_used() >
+			  small_root->arena().bytes_used());
+	}
 }
 
 TEST_CASE("Trivia Index", "[trivia]") {
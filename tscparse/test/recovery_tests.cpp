@@ -0,0 +1,141 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <tscfakes/fake_source.hpp>
+#include <tsclex/lexer.hpp>
+#include <tscparse/ast/namespace_node.hpp>
+#include <tscparse/ast/type_node.hpp>
+#include <tscparse/diagnostic_sink.hpp>
+#include <tscparse/error/declaration_or_statement_expected.hpp>
+#include <tscparse/parser.hpp>
+#include <vector>
+
+using namespace tscc;
+
+namespace {
+
+struct collecting_sink final : parse::diagnostic_sink {
+	std::vector<error_code> codes;
+	std::vector<std::size_t> lines;
+
+	void report(const parse::parse_error& error) override {
+		codes.push_back(error.code());
+		lines.push_back(error.location().line());
+	}
+};
+
+struct recovered_parse {
+	collecting_sink sink;
+	std::unique_ptr<parse::ast::source_file_node> root;
+
+	explicit recovered_parse(const std::string& text) {
+		std::stringstream input(text);
+		auto source = std::make_shared<fake_source>("test.ts");
+		lex::lexer lexer(input, source);
+		parse::parser parser(lexer);
+		parser.set_diagnostic_sink(&sink);
+		root = parser.parse();
+	}
+
+	std::string alias_name(std::size_t index) const {
+		auto& child = *root->children().at(index);
+		return std::string{
+			dynamic_cast<const parse::ast::type_node&>(child).name().value()};
+	}
+};
+
+}  // namespace
+
+TEST_CASE("Parser error recovery", "[parser]") {
+	SECTION("Without a sink the first error is thrown") {
+		std::stringstream input("foo;\ntype A = string;\n");
+		auto source = std::make_shared<fake_source>("test.ts");
+		lex::lexer lexer(input, source);
+		parse::parser parser(lexer);
+		CHECK_THROWS_AS(parser.parse(),
+						parse::declaration_or_statement_expected);
+	}
+
+	SECTION("The rest of a bad line is skipped") {
+		recovered_parse parsed("foo bar;\ntype A = string;\n");
+		CHECK(parsed.sink.codes == std::vector{error_code::ts1128});
+		REQUIRE(parsed.root->children().size() == 1);
+		CHECK(parsed.alias_name(0) == "A");
+	}
+
+	SECTION("A broken declaration is dropped") {
+		recovered_parse parsed("type A = ;\ntype B = string;\n");
+		CHECK(parsed.sink.codes.size() == 1);
+		REQUIRE(parsed.root->children().size() == 1);
+		CHECK(parsed.alias_name(0) == "B");
+	}
+
+	SECTION("Every error is reported in one pass") {
+		recovered_parse parsed(
+			"foo;\n"
+			"type A = ;\n"
+			"type B = string;\n"
+			"bar\n"
+			"type C = number;\n");
+		CHECK(parsed.sink.lines == std::vector<std::size_t>{0, 1, 3});
+		REQUIRE(parsed.root->children().size() == 2);
+		CHECK(parsed.alias_name(0) == "B");
+		CHECK(parsed.alias_name(1) == "C");
+	}
+
+	SECTION("Namespaces carry on after an error") {
+		recovered_parse parsed(
+			"namespace N {\n"
+			"\tfoo;\n"
+			"\ttype A = string;\n"
+			"}\n"
+			"type B = number;\n");
+		CHECK(parsed.sink.lines == std::vector<std::size_t>{1});
+		REQUIRE(parsed.root->children().size() == 2);
+
+		auto& ns = dynamic_cast<const parse::ast::namespace_node&>(
+			*parsed.root->children()[0]);
+		CHECK(ns.children().size() == 1);
+		CHECK(parsed.alias_name(1) == "B");
+	}
+
+	SECTION("A closing brace ends a broken declaration") {
+		recovered_parse parsed(
+			"namespace N {\n"
+			"\ttype A = }\n"
+			"type B = number;\n");
+		CHECK(parsed.sink.codes.size() == 1);
+		REQUIRE(parsed.root->children().size() == 2);
+		CHECK(dynamic_cast<const parse::ast::namespace_node&>(
+				  *parsed.root->children()[0])
+				  .children()
+				  .empty());
+	}
+
+	SECTION("Declarations left open at the end are reported once") {
+		recovered_parse parsed(
+			"type B = number;\n"
+			"namespace N {\n"
+			"\ttype A = string;\n");
+		CHECK(parsed.sink.codes.size() == 1);
+		REQUIRE(parsed.root->children().size() == 1);
+		CHECK(parsed.alias_name(0) == "B");
+	}
+}
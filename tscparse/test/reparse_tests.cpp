@@ -0,0 +1,198 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <tscfakes/fake_source.hpp>
+#include <tsclex/lexer.hpp>
+#include <tscparse/ast/type_node.hpp>
+#include <tscparse/error.hpp>
+#include <tscparse/error/export_assignment_conflicts.hpp>
+#include <tscparse/parser.hpp>
+#include <vector>
+
+using namespace tscc;
+
+namespace {
+
+const std::string document =
+	"import { a } from \"a\";\n"
+	"type A = string;\n"
+	"type B = number;\n"
+	"namespace N {\n"
+	"\ttype C = A;\n"
+	"}\n"
+	"type D = B;\n";
+
+// the kind of each top-level declaration, with the name of type aliases
+std::vector<std::string> describe(const parse::ast::source_file_node& root) {
+	std::vector<std::string> result;
+	for (auto& child : root.children()) {
+		auto description = std::to_string(static_cast<int>(child->node_kind()));
+		if (auto* alias = dynamic_cast<const parse::ast::type_node*>(child.get()))
+			description += std::string{" "} + std::string{alias->name().value()};
+		result.push_back(description);
+	}
+	return result;
+}
+
+struct document_parse {
+	std::shared_ptr<fake_source> source = std::make_shared<fake_source>("test.ts");
+	std::string text;
+	std::unique_ptr<parse::ast::source_file_node> root;
+
+	explicit document_parse(std::string initial) : text(std::move(initial)) {
+		lex::lexer lexer(std::span{text.data(), text.size()}, source);
+		parse::parser parser(lexer);
+		root = parser.parse();
+	}
+
+	parse::parser::reparse_result edit(std::size_t offset,
+									   std::size_t removed,
+									   std::string_view inserted) {
+		auto edited = text;
+		edited.replace(offset, removed, inserted);
+
+		lex::lexer lexer(std::span{edited.data(), edited.size()}, source);
+		parse::parser parser(lexer);
+		auto result = parser.reparse(*root, offset, removed, inserted.size());
+		text = std::move(edited);
+		return result;
+	}
+
+	// the reparsed tree has to look like parsing the new text from scratch
+	void check_matches_full_parse() {
+		lex::lexer lexer(std::span{text.data(), text.size()}, source);
+		parse::parser parser(lexer);
+		auto expected = parser.parse();
+		CHECK(describe(*root) == describe(*expected));
+	}
+};
+
+}  // namespace
+
+TEST_CASE("Incremental reparsing", "[parser]") {
+	document_parse parsed(document);
+	REQUIRE(parsed.root->children().size() == 5);
+
+	std::vector<const parse::ast::ast_node*> before;
+	for (auto& child : parsed.root->children())
+		before.push_back(child.get());
+
+	SECTION("Declarations past the edit are kept") {
+		auto offset = parsed.text.find("number");
+		auto result = parsed.edit(offset, 6, "boolean");
+		parsed.check_matches_full_parse();
+
+		// the alias before B is parsed again too, since it ends on B's token
+		CHECK(result.first == 1);
+		CHECK(result.removed == 2);
+		CHECK(result.inserted == 2);
+
+		auto& children = parsed.root->children();
+		CHECK(children[0].get() == before[0]);
+		CHECK(children[2].get() != before[2]);
+		CHECK(children[3].get() == before[3]);
+		CHECK(children[4].get() == before[4]);
+	}
+
+	SECTION("New declarations are inserted") {
+		auto offset = parsed.text.find("namespace");
+		auto result = parsed.edit(offset, 0, "type X = 1;\ntype Y = 2;\n");
+		parsed.check_matches_full_parse();
+
+		CHECK(result.removed == 2);
+		CHECK(result.inserted == 4);
+		REQUIRE(parsed.root->children().size() == 7);
+		CHECK(parsed.root->children()[5].get() == before[3]);
+	}
+
+	SECTION("Declarations are removed") {
+		auto offset = parsed.text.find("type A");
+		parsed.edit(offset, parsed.text.find("namespace") - offset, "");
+		parsed.check_matches_full_parse();
+
+		REQUIRE(parsed.root->children().size() == 3);
+		CHECK(parsed.root->children()[1].get() == before[3]);
+	}
+
+	SECTION("Edits inside a namespace reparse the whole namespace") {
+		auto offset = parsed.text.find("type C");
+		auto result = parsed.edit(offset, 0, "type Z = 3;\n\t");
+		parsed.check_matches_full_parse();
+
+		CHECK(result.first == 2);
+		CHECK(parsed.root->children()[3].get() != before[3]);
+		CHECK(parsed.root->children()[4].get() == before[4]);
+	}
+
+	SECTION("Edits at either end of the file") {
+		parsed.edit(0, 0, "type Head = 0;\n");
+		parsed.check_matches_full_parse();
+		CHECK(parsed.root->children().back().get() == before[4]);
+
+		parsed.edit(parsed.text.size(), 0, "type Tail = 1;\n");
+		parsed.check_matches_full_parse();
+		REQUIRE(parsed.root->children().size() == 7);
+	}
+
+	SECTION("A series of edits matches parsing from scratch") {
+		for (int i = 0; i < 20; ++i) {
+			auto offset = parsed.text.find("type D");
+			parsed.edit(offset, 0, "type T" + std::to_string(i) + " = D;\n");
+			parsed.check_matches_full_parse();
+
+			auto number = parsed.text.find("number");
+			if (number != std::string::npos)
+				parsed.edit(number, 6, "string");
+			else
+				parsed.edit(parsed.text.find("type B = string"), 15,
+							"type B = number");
+			parsed.check_matches_full_parse();
+		}
+		CHECK(parsed.root->children().back().get() == before[4]);
+	}
+
+	SECTION("A failed reparse leaves the tree as it was") {
+		auto offset = parsed.text.find("number");
+		CHECK_THROWS_AS(parsed.edit(offset, 6, "="), parse::parse_error);
+		CHECK(parsed.text == document);
+
+		REQUIRE(parsed.root->children().size() == before.size());
+		for (std::size_t i = 0; i < before.size(); ++i)
+			CHECK(parsed.root->children()[i].get() == before[i]);
+
+		parsed.edit(offset, 6, "boolean");
+		parsed.check_matches_full_parse();
+	}
+
+	SECTION("Kept declarations are checked against the new ones") {
+		document_parse exports("type A = 1;\nexport type B = 2;\nexport type C = 3;\n");
+		CHECK_THROWS_AS(exports.edit(0, 0, "export = A;\n"),
+						parse::export_assignment_conflicts);
+		CHECK(exports.root->children().size() == 3);
+	}
+
+	SECTION("A trivia index can't be kept up to date") {
+		lex::lexer lexer(std::span{parsed.text.data(), parsed.text.size()},
+						 parsed.source);
+		parse::trivia_index trivia;
+		parse::parser parser(lexer, &trivia);
+		CHECK_THROWS_AS(parser.reparse(*parsed.root, 0, 0, 0), std::logic_error);
+	}
+}
@@ -28,6 +28,13 @@
 
 namespace test_utils {
 
+/**
+ * \brief Observer handed to every parser the helpers create
+ *
+ * Set by the transition listener when TSCC_TRANSITION_LOG is set.
+ */
+inline tscc::parse::parser_observer* observer = nullptr;
+
 /**
  * \brief Holds all parsing artifacts to keep them alive during testing
  *
@@ -50,7 +57,8 @@ inline parse_result parse_source(const std::string& input) {
 	r.stream = std::make_unique<std::stringstream>(input);
 	r.source = std::make_shared<fake_source>("test.ts");
 	r.lexer = std::make_unique<tscc::lex::lexer>(*r.stream, r.source);
-	r.parser = std::make_unique<tscc::parse::parser>(*r.lexer);
+	r.parser =
+		std::make_unique<tscc::parse::parser>(*r.lexer, nullptr, observer);
 	r.root = r.parser->parse();
 	return r;
 }
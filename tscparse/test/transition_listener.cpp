@@ -20,7 +20,7 @@
 #include <memory>
 #include <catch2/reporters/catch_reporter_event_listener.hpp>
 #include <catch2/reporters/catch_reporter_registrars.hpp>
-#include <tscparse/parser.hpp>
+#include "test_helpers.hpp"
 #include "transition_logger.hpp"
 
 namespace {
@@ -32,13 +32,13 @@ public:
 	void testRunStarting(Catch::TestRunInfo const&) override {
 		if (const auto* path = std::getenv("TSCC_TRANSITION_LOG")) {
 			logger_ = std::make_unique<tscc::parse::test::transition_logger>(path);
-			tscc::parse::parser::set_observer(logger_.get());
+			test_utils::observer = logger_.get();
 		}
 	}
 
 	void testRunEnded(Catch::TestRunStats const&) override {
 		if (logger_) {
-			tscc::parse::parser::set_observer(nullptr);
+			test_utils::observer = nullptr;
 			logger_.reset();
 		}
 	}
@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include <memory>
+#include "../node_arena.hpp"
 
 namespace tscc::parse::ast {
 
@@ -65,6 +66,15 @@ public:
 
 	virtual ~ast_node() = default;
 
+	// nodes are placed in the node_arena of the file being parsed
+	static void* operator new(std::size_t size) {
+		return node_arena::allocate(size);
+	}
+
+	static void operator delete(void* node) noexcept {
+		node_arena::deallocate(node);
+	}
+
 	/**
 	 * \brief Get the top-level node kind
 	 */
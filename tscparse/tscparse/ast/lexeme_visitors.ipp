@@ -16,6 +16,7 @@
  * this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <tsccore/interner.hpp>
 #include <tsccore/utf8.hpp>
 #include <tsclex/token.hpp>
 
@@ -28,16 +29,24 @@ const Token& token_as(const lex::token& token) noexcept {
 
 template <typename T>
 struct lexeme_value_extractor<lex::tokens::identifier_token, T> {
-	static_assert(std::is_convertible_v<const std::string&, T>,
-				  "lex::tokens::identifier_token only supports std::string");
+	static_assert(std::is_same_v<T, atom> ||
+					  std::is_constructible_v<T, std::string_view>,
+				  "lex::tokens::identifier_token only supports strings and "
+				  "atoms");
 
 	struct not_supported_combination {};
 	using getter = T (*)(const lex::token&);
 
 	getter make_getter(const lex::tokens::identifier_token& token) const {
-		return [](const lex::token& token) -> T {
-			return token_as<lex::tokens::identifier_token>(token).id();
-		};
+		if constexpr (std::is_same_v<T, atom>) {
+			return [](const lex::token& token) -> T {
+				return token_as<lex::tokens::identifier_token>(token).name();
+			};
+		} else {
+			return [](const lex::token& token) -> T {
+				return T(token_as<lex::tokens::identifier_token>(token).id());
+			};
+		}
 	}
 };
 
@@ -59,6 +68,24 @@ struct lexeme_value_extractor<lex::tokens::constant_value_token, std::string> {
 	}
 };
 
+template <>
+struct lexeme_value_extractor<lex::tokens::constant_value_token, atom> {
+	struct not_supported_combination {};
+	using getter = atom (*)(const lex::token&);
+
+	getter make_getter(const lex::tokens::constant_value_token& token) const {
+		if (!token.is_string())
+			throw std::invalid_argument(
+				"Constant Vaulue is not string as expected");
+
+		return [](const lex::token& token) {
+			return interner::global().intern(
+				*token_as<lex::tokens::constant_value_token>(token)
+					 .string_value());
+		};
+	}
+};
+
 template <>
 struct lexeme_value_extractor<lex::tokens::constant_value_token, tscc_big_int> {
 	struct not_supported_combination {};
@@ -77,9 +104,9 @@ struct lexeme_value_extractor<lex::tokens::constant_value_token, tscc_big_int> {
 };
 
 template <>
-struct lexeme_value_extractor<lex::tokens::constant_value_token, long double> {
+struct lexeme_value_extractor<lex::tokens::constant_value_token, double> {
 	struct not_supported_combination {};
-	using getter = long double (*)(const lex::token&);
+	using getter = double (*)(const lex::token&);
 
 	getter make_getter(const lex::tokens::constant_value_token& token) const {
 		if (!token.is_bigint())
@@ -23,6 +23,12 @@ using namespace tscc::parse::ast;
 source_file_node::source_file_node(std::shared_ptr<lex::source> source)
 	: source_(std::move(source)) {}
 
+source_file_node::~source_file_node() {
+	// the children live in arena_, which is destroyed before the base class
+	// would get to them
+	children_.clear();
+}
+
 const std::shared_ptr<tscc::lex::source>& source_file_node::source()
 	const noexcept {
 	return source_;
@@ -19,7 +19,10 @@
 #pragma once
 
 #include <memory>
+#include <tsclex/lexer.hpp>
 #include <tsclex/source.hpp>
+#include <vector>
+#include "../node_arena.hpp"
 #include "module_node.hpp"
 
 namespace tscc::parse {
@@ -31,14 +34,22 @@ namespace tscc::parse::ast {
 /**
  * \brief Root AST node representing a translation unit (source file)
  *
- * Owns the top-level declarations parsed from a single file.
- * Only the parser can construct instances and add children.
+ * Owns the top-level declarations parsed from a single file, and the
+ * node_arena every node of the file is allocated from. Only the parser can
+ * construct instances and add children, and it keeps enough about where each
+ * child started to parse just the edited ones again.
  */
 class source_file_node final : public module_node {
-	friend class parser;
+	friend class ::tscc::parse::parser;
 
 public:
 	explicit source_file_node(std::shared_ptr<lex::source> source);
+	~source_file_node() override;
+
+	// the root owns the arena, so it can't be allocated from one
+	static void* operator new(std::size_t size) { return ::operator new(size); }
+
+	static void operator delete(void* node) noexcept { ::operator delete(node); }
 
 	kind node_kind() const noexcept override { return kind::source_file; }
 
@@ -47,9 +58,21 @@ public:
 	 */
 	[[nodiscard]] const std::shared_ptr<lex::source>& source() const noexcept;
 
+	/**
+	 * \brief Get the arena the nodes of this file are allocated from
+	 */
+	[[nodiscard]] node_arena& arena() noexcept { return arena_; }
+
+	[[nodiscard]] const node_arena& arena() const noexcept { return arena_; }
+
 private:
 
 	std::shared_ptr<lex::source> source_;
+	node_arena arena_;
+
+	// the lexer state right before the first token of each child, which
+	// parser::reparse() restarts from
+	std::vector<lex::lexer::checkpoint> starts_;
 };
 
 }  // namespace tscc::parse::ast
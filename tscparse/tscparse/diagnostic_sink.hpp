@@ -0,0 +1,45 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "error.hpp"
+
+namespace tscc::parse {
+
+/**
+ * \brief Receiver for the errors of a parser that recovers from them
+ *
+ * With a sink set, the parser reports each error here instead of throwing
+ * it, drops the declaration it was in the middle of, and carries on at the
+ * next line, `;` or `}` of the enclosing module or namespace. Errors are
+ * reported in the order they're found.
+ */
+class diagnostic_sink {
+public:
+	virtual ~diagnostic_sink() = default;
+
+	/**
+	 * \brief Called for every error the parser recovered from
+	 *
+	 * \param error The error that would have been thrown
+	 */
+	virtual void report(const parse_error& error) = 0;
+};
+
+}  // namespace tscc::parse
@@ -21,32 +21,17 @@
 #include <algorithm>
 #include <optional>
 #include <tsclex/token.hpp>
+#include <tsclex/token_set.hpp>
 #include <vector>
 
 namespace tscc::parse {
 
 namespace detail {
 
-template <typename... TokenTypes>
-struct allowed_token_types_t {};
-
-template <>
-struct allowed_token_types_t<> {
-	static constexpr bool allowed(const lex::token& t) noexcept {
-		return false;
-	}
-};
-
-template <typename T, typename... TokenTypes>
-struct allowed_token_types_t<T, TokenTypes...> {
-	static constexpr bool allowed(const tscc::lex::token& t) noexcept {
-		return t.is<T>() || allowed_token_types_t<TokenTypes...>::allowed(t);
-	}
-};
-
 template <typename... TokenTypes>
 bool token_is_one_of(const lex::token& t) noexcept {
-	return allowed_token_types_t<TokenTypes...>::allowed(t);
+	static constexpr auto allowed = lex::token_set::of<TokenTypes...>();
+	return allowed.contains(t);
 }
 
 }  // namespace detail
@@ -194,6 +179,16 @@ private:
 
 	static int compare_locations(const lex::source_location& a,
 								 const lex::source_location& b) {
+		// within a file the offset orders locations the same way the line
+		// and column do, without having to look either of them up
+		if (a.file() == b.file()) {
+			if (a.offset() < b.offset())
+				return -1;
+			if (a.offset() > b.offset())
+				return 1;
+			return 0;
+		}
+
 		if (a.line() < b.line())
 			return -1;
 		if (a.line() > b.line())
@@ -207,7 +202,7 @@ private:
 
 	static bool locations_equal(const lex::source_location& a,
 								const lex::source_location& b) {
-		return a.line() == b.line() && a.column() == b.column();
+		return compare_locations(a, b) == 0;
 	}
 };
 
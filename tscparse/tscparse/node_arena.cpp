@@ -0,0 +1,70 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "node_arena.hpp"
+#include <new>
+
+using namespace tscc::parse;
+
+namespace {
+
+thread_local node_arena* current_arena = nullptr;
+
+// every allocation is preceded by the arena it came from, or nullptr for the
+// heap, padded so the object keeps the strictest fundamental alignment
+struct alignas(std::max_align_t) allocation_header {
+	node_arena* owner;
+};
+
+}  // namespace
+
+node_arena::node_arena() : resource_(initial_size) {}
+
+node_arena::scope::scope(node_arena& arena) noexcept
+	: previous_(current_arena) {
+	current_arena = &arena;
+}
+
+node_arena::scope::~scope() {
+	current_arena = previous_;
+}
+
+void* node_arena::allocate(std::size_t size) {
+	auto total = sizeof(allocation_header) + size;
+
+	void* memory;
+	if (current_arena) {
+		memory =
+			current_arena->resource_.allocate(total, alignof(allocation_header));
+		current_arena->used_ += total;
+	} else {
+		memory = ::operator new(total);
+	}
+
+	auto header = new (memory) allocation_header{current_arena};
+	return header + 1;
+}
+
+void node_arena::deallocate(void* object) noexcept {
+	if (!object)
+		return;
+
+	auto header = static_cast<allocation_header*>(object) - 1;
+	if (!header->owner)
+		::operator delete(header);
+}
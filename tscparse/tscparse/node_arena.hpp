@@ -0,0 +1,90 @@
+/*
+ * TSCC - a Typescript Compiler
+ * Copyright (c) 2026. Keef Aragon
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace tscc::parse {
+
+/**
+ * \brief Monotonic memory for the AST nodes and parser states of one file
+ *
+ * The parser installs the arena of the source_file_node it's building for
+ * the length of parse(), and every ast_node and parser_state created on
+ * that thread in the meantime is placed in it. Deleting one of those
+ * objects still runs its destructor but gives no memory back; the whole
+ * arena is released at once when the source_file_node goes away.
+ *
+ * Objects created while no arena is installed come from the normal heap,
+ * so nodes and states can still be made on their own, for example in
+ * tests.
+ */
+class node_arena {
+public:
+	node_arena();
+
+	node_arena(const node_arena&) = delete;
+	node_arena& operator=(const node_arena&) = delete;
+
+	/**
+	 * \brief Get the number of bytes handed out by the arena
+	 */
+	std::size_t bytes_used() const noexcept { return used_; }
+
+	/**
+	 * \brief Install an arena for the current thread
+	 *
+	 * The previously installed arena, if any, is restored when the scope
+	 * ends.
+	 */
+	class scope {
+	public:
+		explicit scope(node_arena& arena) noexcept;
+		~scope();
+
+		scope(const scope&) = delete;
+		scope& operator=(const scope&) = delete;
+
+	private:
+		node_arena* previous_;
+	};
+
+	/**
+	 * \brief Allocate an object from the current thread's arena, or the heap
+	 *
+	 * Used by the class-specific operator new of ast_node and parser_state.
+	 */
+	static void* allocate(std::size_t size);
+
+	/**
+	 * \brief Release an object from allocate()
+	 *
+	 * Heap memory is freed, arena memory is left for the arena to release.
+	 */
+	static void deallocate(void* object) noexcept;
+
+private:
+	static constexpr std::size_t initial_size = 16 * 1024;
+
+	std::pmr::monotonic_buffer_resource resource_;
+	std::size_t used_ = 0;
+};
+
+}  // namespace tscc::parse
@@ -17,9 +17,14 @@
  */
 
 #include "parser.hpp"
+#include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <stdexcept>
+#include <tsclex/token_set.hpp>
 #include <tsclex/tokens/abstract_token.hpp>
 #include <tsclex/tokens/async_token.hpp>
+#include <tsclex/tokens/close_brace_token.hpp>
 #include <tsclex/tokens/comment_token.hpp>
 #include <tsclex/tokens/jsdoc_token.hpp>
 #include <tsclex/tokens/multiline_comment_token.hpp>
@@ -28,6 +33,7 @@
 #include <tsclex/tokens/protected_token.hpp>
 #include <tsclex/tokens/public_token.hpp>
 #include <tsclex/tokens/readonly_token.hpp>
+#include <tsclex/tokens/semicolon_token.hpp>
 #include <tsclex/tokens/static_token.hpp>
 #include "error/expected_token.hpp"
 #include "error/unexpected_end_of_text.hpp"
@@ -37,71 +43,166 @@
 using namespace tscc;
 using namespace tscc::parse;
 
-parser_observer* parser::observer_ = nullptr;
+namespace {
+
+constexpr auto trivia_tokens =
+	lex::token_set::of<lex::tokens::newline_token,
+					   lex::tokens::comment_token,
+					   lex::tokens::multiline_comment_token,
+					   lex::tokens::jsdoc_token>();
+
+constexpr auto modifier_tokens =
+	lex::token_set::of<lex::tokens::public_token,
+					   lex::tokens::private_token,
+					   lex::tokens::protected_token,
+					   lex::tokens::static_token,
+					   lex::tokens::readonly_token,
+					   lex::tokens::abstract_token,
+					   lex::tokens::async_token>();
+
+}  // namespace
+
+parser::parser(lex::lexer& lexer,
+			   trivia_index* trivia_idx,
+			   parser_observer* observer)
+	: lexer_(lexer),
+	  has_current_(pull_token()),
+	  trivia_index_(trivia_idx),
+	  observer_(observer) {}
 
 void parser::set_observer(parser_observer* obs) noexcept {
 	observer_ = obs;
 }
 
-parser::parser(lex::lexer& lexer, trivia_index* trivia_idx)
-	: lexer_(lexer),
-	  token_iter_(lexer.begin()),
-	  token_end_(lexer.end()),
-	  trivia_index_(trivia_idx) {}
+void parser::set_diagnostic_sink(diagnostic_sink* sink) noexcept {
+	diagnostics_ = sink;
+}
 
 std::unique_ptr<ast::source_file_node> parser::parse() {
 	auto root = std::make_unique<ast::source_file_node>(lexer_.source());
+	node_arena::scope arena_scope(root->arena());
+
+	try {
+		parse_into(*root);
+	} catch (...) {
+		// the states live in the root's arena
+		state_stack_.clear();
+		throw;
+	}
+
+	state_stack_.clear();
+	return root;
+}
+
+parser::reparse_result parser::reparse(ast::source_file_node& tree,
+									   std::size_t offset,
+									   std::size_t removed,
+									   std::size_t inserted) {
+	if (trivia_index_)
+		throw std::logic_error("reparse() doesn't update a trivia index");
+
+	auto& children = tree.children_;
+	auto& starts = tree.starts_;
+	assert(children.size() == starts.size());
+
+	// how a declaration ends can depend on the token after it, so parsing
+	// restarts one declaration before the one the edit starts in, or further
+	// back if the lexer had already looked at the edited text there
+	std::size_t first =
+		std::partition_point(
+			starts.begin(), starts.end(),
+			[=](const auto& start) { return start.offset() < offset; }) -
+		starts.begin();
+	first = first >= 2 ? first - 2 : 0;
+	while (first > 0 && starts[first].reach() > offset)
+		--first;
+
+	if (first > 0) {
+		lexer_.restore(starts[first]);
+		has_current_ = pull_token();
+	}
+	synthetic_newline_.reset();
+	pending_trivia_.clear();
+
+	// the old declarations are put aside, both to reuse the ones after the
+	// edit and to put back if the new text doesn't parse
+	std::vector<std::unique_ptr<const ast::ast_node>> old_children(
+		std::make_move_iterator(children.begin() + first),
+		std::make_move_iterator(children.end()));
+	std::vector<lex::lexer::checkpoint> old_starts(starts.begin() + first,
+												   starts.end());
+	children.erase(children.begin() + first, children.end());
+	starts.erase(starts.begin() + first, starts.end());
+
+	// only declarations that start past the removed text can be kept
+	auto reusable =
+		std::partition_point(old_starts.begin(), old_starts.end(),
+							 [=](const auto& start) {
+								 return start.offset() < offset + removed;
+							 }) -
+		old_starts.begin();
+
+	reusable_tail tail{std::span{old_children}.subspan(reusable),
+					   {old_starts.begin() + reusable, old_starts.end()},
+					   offset + inserted};
+	for (auto& start : tail.starts)
+		start.shift(offset, removed, inserted);
+
+	node_arena::scope arena_scope(tree.arena());
+
+	try {
+		parse_into(tree, &tail);
+	} catch (...) {
+		state_stack_.clear();
+
+		children.erase(children.begin() + first, children.end());
+		std::move(old_children.begin(), old_children.end(),
+				  std::back_inserter(children));
+		starts.erase(starts.begin() + first, starts.end());
+		starts.insert(starts.end(), old_starts.begin(), old_starts.end());
+		throw;
+	}
+
+	state_stack_.clear();
+	return {first, old_children.size() - tail.kept,
+			children.size() - first - tail.kept};
+}
+
+void parser::parse_into(ast::source_file_node& root, reusable_tail* tail) {
 	state_stack_.emplace_back(
-		std::make_unique<state::module_scope_state>(root.get()));
+		std::make_unique<state::module_scope_state>(&root));
 
 	collect_trivia();
 
 	while (!at_token_end()) {
-		const auto& token = current_token();
-		auto result = state_stack_.back()->process(*this, token);
-		const bool should_advance = !result.should_reprocess();
-
-		if (result.is_stay()) {
-			if (should_advance) {
-				advance_token();
-				collect_trivia();
-			}
-			continue;
-		}
-
-		if (result.is_push()) {
-			state_stack_.emplace_back(std::move(result).take_child());
-			if (observer_) {
-				observer_->on_push(*state_stack_[state_stack_.size() - 2],
-								   token, *state_stack_.back());
-			}
-			if (should_advance) {
-				advance_token();
-				collect_trivia();
-			}
-			continue;
-		}
+		if (tail && state_stack_.size() == 1 && !synthetic_newline_ &&
+			splice_tail(root, *tail))
+			break;
 
-		if (result.is_complete()) {
-			handle_complete(std::move(result), &token);
-			if (should_advance) {
-				advance_token();
-				collect_trivia();
-			}
-			continue;
-		}
-
-		if (should_advance) {
-			throw std::logic_error("how did I get here?");
+		try {
+			process_token(root);
+		} catch (const parse_error& error) {
+			if (!diagnostics_)
+				throw;
+			diagnostics_->report(error);
+			synchronize(root);
 		}
 	}
 
 	// Handle EOF: unwind any states that can complete at EOF
 	while (state_stack_.size() > 1) {
-		if (auto eof_result = state_stack_.back()->on_eof()) {
+		try {
+			auto eof_result = state_stack_.back()->on_eof();
+			if (!eof_result)
+				throw unexpected_end_of_text(last_location_);
 			handle_complete(std::move(*eof_result), nullptr);
-		} else {
-			throw unexpected_end_of_text(last_location_);
+		} catch (const parse_error& error) {
+			if (!diagnostics_)
+				throw;
+			// there are no tokens left to finish the open declarations with
+			diagnostics_->report(error);
+			state_stack_.resize(1);
+			root.starts_.resize(root.children_.size());
 		}
 	}
 
@@ -113,8 +214,113 @@ std::unique_ptr<ast::source_file_node> parser::parse() {
 		}
 	}
 	pending_trivia_.clear();
+}
 
-	return root;
+void parser::process_token(ast::source_file_node& root) {
+	const auto& token = current_token();
+	auto result = state_stack_.back()->process(*this, token);
+	const bool should_advance = !result.should_reprocess();
+
+	if (result.is_stay()) {
+		if (should_advance) {
+			advance_token();
+			collect_trivia();
+		}
+		return;
+	}
+
+	if (result.is_push()) {
+		if (state_stack_.size() == 1)
+			root.starts_.push_back(before_current_);
+
+		state_stack_.emplace_back(std::move(result).take_child());
+		if (observer_) {
+			observer_->on_push(*state_stack_[state_stack_.size() - 2],
+							   token, *state_stack_.back());
+		}
+		if (should_advance) {
+			advance_token();
+			collect_trivia();
+		}
+		return;
+	}
+
+	if (result.is_complete()) {
+		handle_complete(std::move(result), &token);
+		if (should_advance) {
+			advance_token();
+			collect_trivia();
+		}
+		return;
+	}
+
+	if (should_advance) {
+		throw std::logic_error("how did I get here?");
+	}
+}
+
+bool parser::splice_tail(ast::source_file_node& root, reusable_tail& tail) {
+	auto offset = before_current_.offset();
+	if (offset < tail.edit_end)
+		return false;
+
+	auto found = std::partition_point(
+		tail.starts.begin(), tail.starts.end(),
+		[=](const auto& start) { return start.offset() < offset; });
+	if (found == tail.starts.end() || found->offset() != offset ||
+		!found->same_state(before_current_))
+		return false;
+
+	auto index = static_cast<std::size_t>(found - tail.starts.begin());
+	static_cast<state::module_scope_state&>(*state_stack_.front())
+		.accept_unchanged(tail.children.subspan(index));
+
+	// the new checkpoint knows how far the lexer looked in the new text
+	root.starts_.push_back(before_current_);
+	root.starts_.insert(root.starts_.end(), found + 1, tail.starts.end());
+	tail.kept = tail.children.size() - index;
+
+	pending_trivia_.clear();
+	return true;
+}
+
+void parser::synchronize(ast::source_file_node& root) {
+	bool dropped = false;
+	while (!state_stack_.back()->synchronizes()) {
+		state_stack_.pop_back();
+		dropped = true;
+	}
+
+	// forget where a dropped top-level declaration started
+	root.starts_.resize(root.children_.size());
+
+	if (synthetic_newline_) {
+		advance_token();
+		collect_trivia();
+		return;
+	}
+
+	// a declaration cut short by a line break or the end of its scope ends
+	// there, and the token after it is left for the scope
+	if (dropped && (current_starts_line_ ||
+					current_.is<lex::tokens::close_brace_token>()))
+		return;
+
+	// otherwise the rest of the line is skipped, up to and including a `;`
+	while (!at_token_end()) {
+		bool semicolon = current_.is<lex::tokens::semicolon_token>();
+		advance_token();
+		collect_trivia();
+
+		if (semicolon || synthetic_newline_ ||
+			(has_current_ && current_.is<lex::tokens::close_brace_token>()))
+			return;
+	}
+}
+
+bool parser::pull_token() {
+	before_current_ = lexer_.save();
+	return lexer_.next(current_);
 }
 
 void parser::advance_token() {
@@ -122,78 +328,63 @@ void parser::advance_token() {
 		synthetic_newline_.reset();
 		return;
 	}
-	if (token_iter_ != token_end_) {
-		last_location_ = token_iter_->location();
-		++token_iter_;
+	if (has_current_) {
+		last_location_ = current_.location();
+		current_starts_line_ = false;
+		has_current_ = pull_token();
 	}
 }
 
 const lex::token& parser::current_token() const {
 	if (synthetic_newline_)
 		return *synthetic_newline_;
-	return *token_iter_;
+	return current_;
 }
 
 bool parser::at_token_end() const {
 	if (synthetic_newline_)
 		return false;
-	return token_iter_ == token_end_;
+	return !has_current_;
 }
 
 lex::token parser::consume_token() {
-	lex::token tok = *token_iter_;
+	lex::token tok = current_;
 	advance_token();
 	return tok;
 }
 
 void parser::collect_trivia() {
-	while (token_iter_ != token_end_) {
-		bool is_trivia = token_iter_->visit([&](const auto& tok) {
-			using T = std::decay_t<decltype(tok)>;
-			if constexpr (std::is_same_v<T, lex::tokens::newline_token>) {
-				synthetic_newline_.emplace(
-					lex::make_token<lex::tokens::newline_token>(
-						token_iter_->location()));
-
-				pending_trivia_.emplace_back(std::move(*token_iter_));
-				return true;
-			} else if constexpr (std::is_same_v<
-									 T, lex::tokens::multiline_comment_token>) {
-				if (static_cast<const lex::tokens::multiline_comment_token&>(
-						tok)
-						.lines()
-						.size() > 1)
-					synthetic_newline_.emplace(
-						lex::make_token<lex::tokens::newline_token>(
-							token_iter_->location()));
-
-				pending_trivia_.emplace_back(std::move(*token_iter_));
-				return true;
-			} else if constexpr (std::is_same_v<T, lex::tokens::jsdoc_token>) {
-				if (static_cast<const lex::tokens::jsdoc_token&>(tok)
-						.lines()
-						.size() > 1)
-					synthetic_newline_.emplace(
-						lex::make_token<lex::tokens::newline_token>(
-							token_iter_->location()));
-
-				pending_trivia_.emplace_back(std::move(*token_iter_));
-				return true;
-			} else if constexpr (std::is_same_v<T,
-												lex::tokens::comment_token>) {
-				pending_trivia_.emplace_back(std::move(*token_iter_));
-				return true;
-			}
-			return false;
-		});
-
-		if (!is_trivia)
+	while (has_current_) {
+		auto kind = current_.kind();
+		if (!trivia_tokens.contains(kind))
 			break;
-		last_location_ = token_iter_->location();
-		++token_iter_;
+
+		bool line_break = kind == lex::token_kind::newline_token;
+		if (kind == lex::token_kind::multiline_comment_token) {
+			line_break =
+				static_cast<const lex::tokens::multiline_comment_token&>(
+					*current_)
+					.lines()
+					.size() > 1;
+		} else if (kind == lex::token_kind::jsdoc_token) {
+			line_break = static_cast<const lex::tokens::jsdoc_token&>(*current_)
+							 .lines()
+							 .size() > 1;
+		}
+
+		auto location = current_.location();
+		if (line_break) {
+			synthetic_newline_.emplace(
+				lex::make_token<lex::tokens::newline_token>(location));
+			current_starts_line_ = true;
+		}
+
+		pending_trivia_.emplace_back(std::move(current_));
+		last_location_ = location;
+		has_current_ = pull_token();
 	}
 
-	if (token_iter_ == token_end_)
+	if (!has_current_)
 		synthetic_newline_.reset();
 }
 
@@ -243,48 +434,9 @@ void parser::handle_complete(state::state_result result,
 }
 
 std::optional<lex::token> parser::try_consume_modifier() {
-	struct modifier_visitor {
-		parser& p;
-
-		std::optional<lex::token> operator()(const lex::tokens::public_token&) {
-			return p.consume_token();
-		}
-
-		std::optional<lex::token> operator()(
-			const lex::tokens::private_token&) {
-			return p.consume_token();
-		}
-
-		std::optional<lex::token> operator()(
-			const lex::tokens::protected_token&) {
-			return p.consume_token();
-		}
-
-		std::optional<lex::token> operator()(const lex::tokens::static_token&) {
-			return p.consume_token();
-		}
-
-		std::optional<lex::token> operator()(
-			const lex::tokens::readonly_token&) {
-			return p.consume_token();
-		}
-
-		std::optional<lex::token> operator()(
-			const lex::tokens::abstract_token&) {
-			return p.consume_token();
-		}
-
-		std::optional<lex::token> operator()(const lex::tokens::async_token&) {
-			return p.consume_token();
-		}
-
-		// Not a modifier
-		std::optional<lex::token> operator()(const lex::tokens::basic_token&) {
-			return std::nullopt;
-		}
-	};
-
-	return current_token().visit(modifier_visitor{*this});
+	if (!modifier_tokens.contains(current_token()))
+		return std::nullopt;
+	return consume_token();
 }
 
 std::vector<lex::token> parser::parse_modifiers() {
@@ -18,13 +18,16 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <optional>
+#include <span>
 #include <tsclex/lexer.hpp>
 #include <tsclex/token.hpp>
 #include <vector>
 #include "ast/ast_node.hpp"
 #include "ast/source_file_node.hpp"
+#include "diagnostic_sink.hpp"
 #include "parser_observer.hpp"
 #include "state/parser_state.hpp"
 #include "state/state_result.hpp"
@@ -36,18 +39,24 @@ namespace tscc::parse {
  * \brief Parser that eagerly produces a complete AST from a token stream
  *
  * Consumes all tokens from the lexer and returns a source_file_node
- * containing all top-level declarations.
+ * containing all top-level declarations. After an edit, reparse() can bring
+ * the tree up to date by parsing only the declarations around the edit.
  */
 class parser {
 public:
 	/**
-	 * \brief Set a global observer for parser state transitions
-	 *
-	 * The observer receives on_push() calls whenever any parser instance
-	 * pushes a new state. Set to nullptr to disable observation.
-	 * Not thread-safe — set once before parsing begins.
+	 * \brief The top-level declarations a reparse() replaced
 	 */
-	static void set_observer(parser_observer* obs) noexcept;
+	struct reparse_result {
+		// the index of the first declaration that was parsed again
+		std::size_t first;
+
+		// the number of old declarations that were replaced
+		std::size_t removed;
+
+		// the number of new declarations in their place
+		std::size_t inserted;
+	};
 
 	/**
 	 * \brief Construct a parser
@@ -55,8 +64,33 @@ public:
 	 * \param lexer The lexer to consume tokens from
 	 * \param trivia_idx Optional trivia index to populate during parsing (can
 	 * be nullptr)
+	 * \param observer Optional observer for state transitions (can be
+	 * nullptr)
+	 */
+	parser(lex::lexer& lexer,
+		   trivia_index* trivia_idx = nullptr,
+		   parser_observer* observer = nullptr);
+
+	/**
+	 * \brief Set the observer for this parser's state transitions
+	 *
+	 * The observer receives on_push() calls whenever this parser pushes a
+	 * new state. Set to nullptr to disable observation. Each parser has its
+	 * own observer, so parsers on different threads don't share one unless
+	 * they're given the same instance.
 	 */
-	parser(lex::lexer& lexer, trivia_index* trivia_idx = nullptr);
+	void set_observer(parser_observer* obs) noexcept;
+
+	/**
+	 * \brief Recover from parse errors, reporting them to a sink
+	 *
+	 * Without a sink, which is the default, the first parse error is thrown
+	 * out of parse(). With one, each error is reported to it and parsing
+	 * picks up again at the next declaration of the enclosing module or
+	 * namespace, so one pass finds every error in the file. Lexer errors
+	 * are still thrown.
+	 */
+	void set_diagnostic_sink(diagnostic_sink* sink) noexcept;
 
 	// Disable copy / move
 	parser(const parser&) = delete;
@@ -67,20 +101,85 @@ public:
 	 */
 	std::unique_ptr<ast::source_file_node> parse();
 
+	/**
+	 * \brief Update a tree after an edit to the text it was parsed from
+	 * \param tree The result of parse() or reparse() of the text before the
+	 * edit
+	 * \param offset Where the replaced text starts
+	 * \param removed The number of bytes that were removed
+	 * \param inserted The number of bytes put in their place
+	 *
+	 * The parser's lexer has to be over the whole text after the edit, in a
+	 * buffer unless the edit is in the first top-level declaration. Parsing
+	 * restarts at the declaration before the one the edit starts in, and
+	 * once a declaration past the edit starts in the same state it did
+	 * before, that declaration and the ones after it are moved over as they
+	 * are. Declarations that were kept still report locations in the text
+	 * they were parsed from, and the memory of the ones that were replaced
+	 * stays in the tree's arena until the tree is destroyed.
+	 *
+	 * Trivia isn't tracked, so the parser can't have a trivia index. If the
+	 * new text can't be parsed the error is thrown and the tree is left as
+	 * it was.
+	 */
+	reparse_result reparse(ast::source_file_node& tree,
+						   std::size_t offset,
+						   std::size_t removed,
+						   std::size_t inserted);
+
 private:
-	static parser_observer* observer_;
+	// the declarations after an edit that reparse() may be able to keep
+	struct reusable_tail {
+		std::span<std::unique_ptr<const ast::ast_node>> children;
+
+		// where each of them started, moved to follow the edit
+		std::vector<lex::lexer::checkpoint> starts;
+
+		// the end of the inserted text
+		std::size_t edit_end;
+
+		// how many of the children were moved back into the tree
+		std::size_t kept = 0;
+	};
 
 	lex::lexer& lexer_;
-	lex::lexer::iterator token_iter_;
-	lex::lexer::iterator token_end_;
+
+	// the token being looked at, pulled straight from the lexer, and the
+	// lexer state right before it
+	lex::token current_;
+	lex::lexer::checkpoint before_current_;
+	bool has_current_;
 	trivia_index* trivia_index_;
+	parser_observer* observer_;
+	diagnostic_sink* diagnostics_ = nullptr;
 	std::vector<lex::token> pending_trivia_;
 	lex::source_location
 		last_location_;	 // Track last valid location for EOF errors
 	std::optional<lex::token> synthetic_newline_;
+
+	// whether a line break came between the previous token and current_
+	bool current_starts_line_ = false;
 	std::vector<std::unique_ptr<state::parser_state>> state_stack_;
 
-	// Internal: advance token iterator
+	// Internal: run the state machine over every token into the root,
+	// stopping early if the rest of the tokens match the tail
+	void parse_into(ast::source_file_node& root, reusable_tail* tail = nullptr);
+
+	// Internal: feed the current token to the state on top of the stack
+	void process_token(ast::source_file_node& root);
+
+	// Internal: after a reported error, drop the failed declaration and
+	// skip to where the enclosing scope can carry on
+	void synchronize(ast::source_file_node& root);
+
+	// Internal: move the tail into the root if the current token starts one
+	// of its declarations in the same state
+	bool splice_tail(ast::source_file_node& root, reusable_tail& tail);
+
+	// Internal: pull the next token from the lexer into current_
+	bool pull_token();
+
+	// Internal: advance to the next token
 	void advance_token();
 
 	// Internal: get current token
@@ -64,6 +64,7 @@ state_result declare_module_state::process(parser& /*p*/,
 accept_result declare_module_state::accept_child(
 	std::unique_ptr<ast::ast_node> child) {
 	if (!child) {
+		in_body_ = true;
 		return accept_result::stay();
 	}
 
@@ -83,3 +84,7 @@ accept_result declare_module_state::accept_child(
 	node_->children_.emplace_back(node_->adopt_child(std::move(child)));
 	return accept_result::stay();
 }
+
+bool declare_module_state::synchronizes() const noexcept {
+	return in_body_;
+}
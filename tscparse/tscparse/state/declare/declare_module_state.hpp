@@ -41,9 +41,14 @@ public:
 
 	accept_result accept_child(std::unique_ptr<ast::ast_node> child) override;
 
+	bool synchronizes() const noexcept override;
+
 private:
 	std::unique_ptr<ast::declare_module_node> node_;
 	bool header_done_ = false;
+
+	// set once the header has consumed the opening brace
+	bool in_body_ = false;
 	bool has_export_assignment_ = false;
 	bool has_default_export_ = false;
 	bool has_named_export_ = false;
@@ -36,7 +36,10 @@ const lex::token* named_export_keyword(const parse::ast::ast_node& node) {
 }  // namespace
 
 module_scope_state::module_scope_state(ast::module_node* target)
-	: target_(target) {}
+	: target_(target) {
+	for (auto& child : target_->children_)
+		check_exports(*child);
+}
 
 state_result module_scope_state::process(parser& /*p*/,
 										 const lex::token& token) {
@@ -45,19 +48,36 @@ state_result module_scope_state::process(parser& /*p*/,
 
 accept_result module_scope_state::accept_child(
 	std::unique_ptr<ast::ast_node> child) {
-	if (child->node_kind() == parse::ast::ast_node::kind::export_assignment) {
+	check_exports(*child);
+
+	target_->children_.emplace_back(target_->adopt_child(std::move(child)));
+	return accept_result::stay();
+}
+
+bool module_scope_state::synchronizes() const noexcept {
+	return true;
+}
+
+void module_scope_state::accept_unchanged(
+	std::span<std::unique_ptr<const ast::ast_node>> children) {
+	for (auto& child : children)
+		check_exports(*child);
+
+	for (auto& child : children)
+		target_->children_.emplace_back(std::move(child));
+}
+
+void module_scope_state::check_exports(const ast::ast_node& child) {
+	if (child.node_kind() == parse::ast::ast_node::kind::export_assignment) {
 		if (has_export_assignment_ || has_named_export_ || has_default_export_)
 			throw export_assignment_conflicts(
-				static_cast<const parse::ast::exportable_node&>(*child)
+				static_cast<const parse::ast::exportable_node&>(child)
 					.export_keyword()->location());
 		has_export_assignment_ = true;
-	} else if (auto* ek = named_export_keyword(*child)) {
+	} else if (auto* ek = named_export_keyword(child)) {
 		if (has_export_assignment_)
 			throw export_assignment_conflicts(ek->location());
 		has_named_export_ = true;
 	}
 	// TODO: check for export_default_node (TS2309, TS2528)
-
-	target_->children_.emplace_back(target_->adopt_child(std::move(child)));
-	return accept_result::stay();
 }
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <span>
 #include "../ast/module_node.hpp"
 #include "parser_state.hpp"
 
@@ -31,7 +32,8 @@ namespace tscc::parse::state {
  * functions, interfaces, enums, type aliases, and variable declarations.
  *
  * Completed child nodes are integrated into the target module_node
- * via accept_child.
+ * via accept_child. Children the target already has when the state is
+ * created count towards the export checks.
  */
 class module_scope_state : public parser_state {
 public:
@@ -41,7 +43,21 @@ public:
 
 	accept_result accept_child(std::unique_ptr<ast::ast_node> child) override;
 
+	bool synchronizes() const noexcept override;
+
+	/**
+	 * \brief Add declarations kept from an earlier parse of the file
+	 *
+	 * They're checked against the declarations before them the same way as
+	 * new children, and are only moved into the target if they all pass.
+	 */
+	void accept_unchanged(
+		std::span<std::unique_ptr<const ast::ast_node>> children);
+
 private:
+	// throw if the child can't be exported next to the earlier children
+	void check_exports(const ast::ast_node& child);
+
 	ast::module_node* target_;
 	bool has_export_assignment_ = false;
 	bool has_default_export_ = false;
@@ -52,6 +52,7 @@ state_result namespace_state::process(parser& /*p*/, const lex::token& token) {
 accept_result namespace_state::accept_child(
 	std::unique_ptr<ast::ast_node> child) {
 	if (!child) {
+		in_body_ = true;
 		return accept_result::stay();
 	}
 
@@ -59,3 +60,7 @@ accept_result namespace_state::accept_child(
 	node_->children_.emplace_back(std::move(child));
 	return accept_result::stay();
 }
+
+bool namespace_state::synchronizes() const noexcept {
+	return in_body_;
+}
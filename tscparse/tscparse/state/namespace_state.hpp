@@ -59,10 +59,15 @@ public:
 
 	accept_result accept_child(std::unique_ptr<ast::ast_node> child) override;
 
+	bool synchronizes() const noexcept override;
+
 private:
 	std::unique_ptr<ast::namespace_node> node_;
 	bool ambient_;
 	bool header_done_ = false;
+
+	// set once the header has consumed the opening brace
+	bool in_body_ = false;
 };
 
 }  // namespace tscc::parse::state
@@ -26,6 +26,10 @@ std::optional<state_result> parser_state::on_eof() {
 	return std::nullopt;
 }
 
+bool parser_state::synchronizes() const noexcept {
+	return false;
+}
+
 state_result basic_state_visitor::operator()(
 	const lex::tokens::newline_token&) const {
 	return state_result::stay();
@@ -23,6 +23,7 @@
 #include <tsclex/token.hpp>
 #include <tsclex/tokens/basic_token.hpp>
 #include <tsclex/tokens/newline_token.hpp>
+#include "../node_arena.hpp"
 
 namespace tscc::parse {
 class parser;
@@ -47,6 +48,15 @@ class parser_state {
 public:
 	virtual ~parser_state() = default;
 
+	// states share the node_arena of the file being parsed
+	static void* operator new(std::size_t size) {
+		return node_arena::allocate(size);
+	}
+
+	static void operator delete(void* state) noexcept {
+		node_arena::deallocate(state);
+	}
+
 	/**
 	 * \brief Process a token and return what to do next
 	 *
@@ -77,6 +87,15 @@ public:
 	 * Default returns nullopt, which causes unexpected_end_of_text.
 	 */
 	virtual std::optional<state_result> on_eof();
+
+	/**
+	 * \brief Whether parsing can carry on in this state after an error
+	 *
+	 * True for the states that hold a list of declarations, which a parser
+	 * with a diagnostic_sink falls back to when a declaration in them
+	 * fails. Default returns false.
+	 */
+	virtual bool synchronizes() const noexcept;
 };
 
 /**
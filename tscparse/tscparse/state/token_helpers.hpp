@@ -19,6 +19,7 @@
 #pragma once
 
 #include <tsclex/token.hpp>
+#include <tsclex/token_set.hpp>
 #include <tsclex/tokens/as_token.hpp>
 #include <tsclex/tokens/assert_token.hpp>
 #include <tsclex/tokens/constant_value_token.hpp>
@@ -30,6 +31,24 @@
 
 namespace tscc::parse::state::detail {
 
+/**
+ * \brief The tokens that can serve as an identifier
+ */
+inline constexpr auto identifier_tokens =
+	lex::token_set::of<lex::tokens::identifier_token,
+					   lex::tokens::type_token,
+					   lex::tokens::from_token,
+					   lex::tokens::as_token,
+					   lex::tokens::assert_token,
+					   lex::tokens::require_token>();
+
+/**
+ * \brief The tokens that can serve as a named import specifier name
+ */
+inline constexpr auto specifier_name_tokens =
+	identifier_tokens | lex::token_set::of<lex::tokens::constant_value_token,
+										   lex::tokens::default_token>();
+
 /**
  * \brief Check if a token can serve as an identifier
  *
@@ -38,20 +57,7 @@ namespace tscc::parse::state::detail {
  * that can appear where an identifier is expected.
  */
 inline bool can_be_identifier(const lex::token& token) {
-	struct visitor {
-		bool operator()(const lex::tokens::identifier_token&) const {
-			return true;
-		}
-		bool operator()(const lex::tokens::type_token&) const { return true; }
-		bool operator()(const lex::tokens::from_token&) const { return true; }
-		bool operator()(const lex::tokens::as_token&) const { return true; }
-		bool operator()(const lex::tokens::assert_token&) const { return true; }
-		bool operator()(const lex::tokens::require_token&) const {
-			return true;
-		}
-		bool operator()(const lex::tokens::basic_token&) const { return false; }
-	};
-	return token.visit(visitor{});
+	return identifier_tokens.contains(token);
 }
 
 /**
@@ -62,9 +68,7 @@ inline bool can_be_identifier(const lex::token& token) {
  * import { default as x }.
  */
 inline bool can_be_specifier_name(const lex::token& token) {
-	return can_be_identifier(token) ||
-		   token.is<lex::tokens::constant_value_token>() ||
-		   token.is<lex::tokens::default_token>();
+	return specifier_name_tokens.contains(token);
 }
 
 /**
@@ -79,29 +83,34 @@ inline bool can_be_specifier_name(const lex::token& token) {
  * contextual keyword.
  */
 inline void normalize_identifier(lex::token& tok) {
-	if (tok.is<lex::tokens::identifier_token>())
-		return;
-	if (!can_be_identifier(tok))
-		return;
-
 	static const std::u32string kw_type    = U"type";
 	static const std::u32string kw_from    = U"from";
 	static const std::u32string kw_as      = U"as";
 	static const std::u32string kw_assert  = U"assert";
 	static const std::u32string kw_require = U"require";
 
-	struct name_visitor {
-		const std::u32string* operator()(const lex::tokens::type_token&) const { return &kw_type; }
-		const std::u32string* operator()(const lex::tokens::from_token&) const { return &kw_from; }
-		const std::u32string* operator()(const lex::tokens::as_token&) const { return &kw_as; }
-		const std::u32string* operator()(const lex::tokens::assert_token&) const { return &kw_assert; }
-		const std::u32string* operator()(const lex::tokens::require_token&) const { return &kw_require; }
-		const std::u32string* operator()(const lex::tokens::basic_token&) const { return nullptr; }
-	};
+	const std::u32string* name;
+	switch (tok.kind()) {
+	case lex::token_kind::type_token:
+		name = &kw_type;
+		break;
+	case lex::token_kind::from_token:
+		name = &kw_from;
+		break;
+	case lex::token_kind::as_token:
+		name = &kw_as;
+		break;
+	case lex::token_kind::assert_token:
+		name = &kw_assert;
+		break;
+	case lex::token_kind::require_token:
+		name = &kw_require;
+		break;
+	default:
+		return;
+	}
 
-	const auto* name = tok.visit(name_visitor{});
-	if (name)
-		tok.emplace_token<lex::tokens::identifier_token>(tok.location(), *name);
+	tok.emplace_token<lex::tokens::identifier_token>(tok.location(), *name);
 }
 
 }  // namespace tscc::parse::state::detail